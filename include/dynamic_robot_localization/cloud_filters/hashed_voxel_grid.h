@@ -0,0 +1,135 @@
+#pragma once
+
+/**\file hashed_voxel_grid.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ROS includes
+#include <ros/ros.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/io.h>
+#include <pcl/common/point_tests.h>
+
+// external libs includes
+#include <Eigen/Core>
+
+// project includes
+#include <dynamic_robot_localization/cloud_filters/cloud_filter.h>
+#include <dynamic_robot_localization/common/pointcloud_utils.h>
+#include <dynamic_robot_localization/common/voxel_coordinates.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+namespace dynamic_robot_localization {
+// ###########################################################################   hashed_voxel_grid   ###########################################################################
+/**
+ * \brief Voxel grid downsampling using an open addressing hash table keyed on the 64 bit integer voxel coordinates (no limits on cloud extent / leaf size ratio).
+ * The hash space is split into shards that are processed in parallel and the hash tables are reused between clouds.
+ * Each voxel is replaced by the centroid of its points, with averaged normals, color and curvature when downsample_all_data is enabled.
+ */
+template <typename PointT>
+class HashedVoxelGrid : public CloudFilter<PointT> {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< HashedVoxelGrid<PointT> >;
+		using ConstPtr = std::shared_ptr< const HashedVoxelGrid<PointT> >;
+
+		struct HashTableSlot {
+			VoxelCoordinates voxel_coordinates;
+			std::uint32_t voxel_index;
+		};
+
+		struct VoxelAccumulator {
+			Eigen::Vector3d position_sum;
+			Eigen::Vector3f normal_sum;
+			Eigen::Vector3f color_sum;
+			float curvature_sum;
+			std::uint32_t number_of_points;
+			pcl::index_t first_point_index;
+		};
+
+		/// Points whose voxel hash maps to the shard are accumulated by a single thread
+		struct HashShard {
+			std::vector<HashTableSlot> hash_table;
+			std::vector<VoxelAccumulator> voxels;
+		};
+
+		static constexpr std::uint32_t EMPTY_SLOT = std::numeric_limits<std::uint32_t>::max();
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		HashedVoxelGrid() : CloudFilter<PointT>("HashedVoxelGrid"),
+			leaf_size_(0.01, 0.01, 0.01), inverse_leaf_size_(100.0, 100.0, 100.0), filter_limit_field_offset_(-1), filter_limit_min_(-5.0), filter_limit_max_(5.0),
+			downsample_all_data_(false), minimum_number_of_points_per_voxel_(1), number_of_threads_(0) {}
+		virtual ~HashedVoxelGrid() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <HashedVoxelGrid-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		virtual void filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud);
+		/// Computes the voxel of each point and groups the points indices by shard (in a single parallel pass over blocks of the cloud, keeping the points order within each shard)
+		void computePointsVoxelCoordinates(const pcl::PointCloud<PointT>& input_cloud, size_t number_of_shards);
+		void accumulateShardVoxels(const pcl::PointCloud<PointT>& input_cloud, size_t shard_index);
+		std::uint32_t findOrInsertVoxel(HashShard& shard, const VoxelCoordinates& voxel_coordinates, std::uint64_t voxel_hash);
+		void growHashTable(HashShard& shard);
+		void computeVoxelPoint(const pcl::PointCloud<PointT>& input_cloud, const VoxelAccumulator& voxel, PointT& voxel_point);
+		static size_t computeHashTableSize(size_t expected_number_of_voxels);
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </HashedVoxelGrid-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		inline const Eigen::Vector3d& getLeafSize() const { return leaf_size_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		Eigen::Vector3d leaf_size_;
+		Eigen::Vector3d inverse_leaf_size_;
+		std::string filter_limit_field_name_;
+		int filter_limit_field_offset_;
+		double filter_limit_min_;
+		double filter_limit_max_;
+		bool downsample_all_data_;
+		int minimum_number_of_points_per_voxel_;
+		int number_of_threads_;
+		std::vector<VoxelCoordinates> points_voxel_coordinates_;
+		std::vector<std::uint64_t> points_voxel_hashes_;
+		std::vector<int> points_shard_index_;
+		std::vector<size_t> blocks_shards_points_offsets_;
+		std::vector<size_t> shards_points_offsets_;
+		std::vector<pcl::index_t> shards_points_indices_;
+		std::vector<HashShard> hash_shards_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_filters/impl/hashed_voxel_grid.hpp>
+#endif
@@ -36,6 +36,35 @@ void CloudFilter<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& in
 	if (cloud_publisher_ && output_cloud) { cloud_publisher_->publishPointCloud(*output_cloud); }
 	ROS_DEBUG_STREAM(filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
 }
+
+template<typename PointT>
+bool CloudFilter<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	typename pcl::FilterIndices<PointT>::Ptr filter_indices = std::dynamic_pointer_cast< pcl::FilterIndices<PointT> >(filter_);
+	if (!filter_indices) { return false; }
+
+	size_t number_of_points_in_input_cloud = input_indices ? input_indices->size() : input_cloud->size();
+	filter_indices->setInputCloud(input_cloud);
+	filter_indices->setIndices(input_indices);
+	output_indices.reset(new pcl::Indices());
+	filter_indices->filter(*output_indices);
+	filter_indices->setIndices(pcl::IndicesPtr()); // filter_ is shared with filter(input_cloud, output_cloud)
+
+	publishFilteredCloud(input_cloud, output_indices);
+	ROS_DEBUG_STREAM(filter_name_ << " filter reduced point cloud indices from " << number_of_points_in_input_cloud << " points to " << output_indices->size() << " points");
+	return true;
+}
+
+template<typename PointT>
+void CloudFilter<PointT>::publishFilteredCloud(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& indices) {
+	if (!cloud_publisher_ || !cloud_publisher_->isPublishingPointClouds()) { return; }
+	if (indices) {
+		pcl::PointCloud<PointT> filtered_cloud;
+		pcl::copyPointCloud(*input_cloud, *indices, filtered_cloud);
+		cloud_publisher_->publishPointCloud(filtered_cloud);
+	} else {
+		cloud_publisher_->publishPointCloud(*input_cloud);
+	}
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </CloudFilter-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
@@ -38,6 +38,12 @@ void CovarianceSampling<PointT>::filter(const typename pcl::PointCloud<PointT>::
 	std::static_pointer_cast< typename pcl::CovarianceSampling<PointT, PointT> >(CloudFilter<PointT>::getFilter())->setNormals(input_cloud);
 	CloudFilter<PointT>::filter(input_cloud, output_cloud);
 }
+
+template<typename PointT>
+bool CovarianceSampling<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	std::static_pointer_cast< typename pcl::CovarianceSampling<PointT, PointT> >(CloudFilter<PointT>::getFilter())->setNormals(input_cloud);
+	return CloudFilter<PointT>::filterIndices(input_cloud, input_indices, output_indices);
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </CovarianceSampling-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
@@ -31,6 +31,14 @@ void EuclideanClustering<PointT>::setupConfigurationFromParameterServer(ros::Nod
 	euclidean_cluster_extraction_.setMinClusterSize(min_cluster_size);
 	euclidean_cluster_extraction_.setMaxClusterSize(max_cluster_size);
 
+	int number_of_threads;
+	private_node_handle->param(configuration_namespace + "use_voxel_hash_clustering", use_voxel_hash_clustering_, false);
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads, 0);
+	voxel_hash_clustering_.setClusterTolerance(cluster_tolerance);
+	voxel_hash_clustering_.setMinClusterSize(min_cluster_size);
+	voxel_hash_clustering_.setMaxClusterSize(max_cluster_size);
+	voxel_hash_clustering_.setNumberOfThreads(number_of_threads);
+
 	cluster_selector_.setTfCollector(CloudFilter<PointT>::getTfCollector());
 	cluster_selector_.setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace + "cluster_selector/");
 	CloudFilter<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
@@ -41,13 +49,8 @@ template<typename PointT>
 void EuclideanClustering<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud) {
 	size_t number_of_points_in_input_cloud = input_cloud->size();
 
-	typename pcl::search::KdTree<PointT>::Ptr search_tree(new pcl::search::KdTree<PointT>());
-	search_tree->setInputCloud(input_cloud);
-	euclidean_cluster_extraction_.setSearchMethod(search_tree);
-	euclidean_cluster_extraction_.setInputCloud(input_cloud);
-
 	std::vector<pcl::PointIndices> cluster_indices;
-	euclidean_cluster_extraction_.extract(cluster_indices);
+	extractClusters(input_cloud, pcl::IndicesPtr(), cluster_indices);
 
 	std::vector<size_t> selected_clusters;
 	cluster_selector_.selectClusters(input_cloud, cluster_indices, selected_clusters);
@@ -56,6 +59,40 @@ void EuclideanClustering<PointT>::filter(const typename pcl::PointCloud<PointT>:
 	if (CloudFilter<PointT>::getCloudPublisher() && output_cloud) { CloudFilter<PointT>::getCloudPublisher()->publishPointCloud(*output_cloud); }
 	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter found " << cluster_indices.size() << " clusters and reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
 }
+
+
+template<typename PointT>
+bool EuclideanClustering<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	if (!use_voxel_hash_clustering_) { return false; }
+	size_t number_of_points_in_input_cloud = input_indices ? input_indices->size() : input_cloud->size();
+
+	std::vector<pcl::PointIndices> cluster_indices;
+	extractClusters(input_cloud, input_indices, cluster_indices);
+
+	std::vector<size_t> selected_clusters;
+	cluster_selector_.selectClusters(input_cloud, cluster_indices, selected_clusters);
+	output_indices.reset(new pcl::Indices());
+	pointcloud_utils::extractPointCloudClustersIndices(cluster_indices, selected_clusters, *output_indices);
+
+	CloudFilter<PointT>::publishFilteredCloud(input_cloud, output_indices);
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter found " << cluster_indices.size() << " clusters and reduced point cloud indices from " << number_of_points_in_input_cloud << " points to " << output_indices->size() << " points");
+	return true;
+}
+
+
+template<typename PointT>
+void EuclideanClustering<PointT>::extractClusters(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, std::vector<pcl::PointIndices>& cluster_indices) {
+	if (use_voxel_hash_clustering_) {
+		voxel_hash_clustering_.extract(*input_cloud, input_indices, cluster_indices);
+	} else {
+		typename pcl::search::KdTree<PointT>::Ptr search_tree(new pcl::search::KdTree<PointT>());
+		search_tree->setInputCloud(input_cloud, input_indices);
+		euclidean_cluster_extraction_.setSearchMethod(search_tree);
+		euclidean_cluster_extraction_.setInputCloud(input_cloud);
+		euclidean_cluster_extraction_.setIndices(input_indices);
+		euclidean_cluster_extraction_.extract(cluster_indices);
+	}
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </EuclideanClustering-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
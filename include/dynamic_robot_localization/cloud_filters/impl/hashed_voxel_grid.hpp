@@ -0,0 +1,272 @@
+/**\file hashed_voxel_grid.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_filters/hashed_voxel_grid.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <HashedVoxelGrid-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void HashedVoxelGrid<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	private_node_handle->param(configuration_namespace + "leaf_size_x", leaf_size_(0), 0.01);
+	private_node_handle->param(configuration_namespace + "leaf_size_y", leaf_size_(1), 0.01);
+	private_node_handle->param(configuration_namespace + "leaf_size_z", leaf_size_(2), 0.01);
+	inverse_leaf_size_ = leaf_size_.cwiseInverse();
+
+	private_node_handle->param(configuration_namespace + "filter_limit_field_name", filter_limit_field_name_, std::string("z"));
+	private_node_handle->param(configuration_namespace + "filter_limit_min", filter_limit_min_, -5.0);
+	private_node_handle->param(configuration_namespace + "filter_limit_max", filter_limit_max_, 5.0);
+	filter_limit_field_offset_ = -1;
+	if (!filter_limit_field_name_.empty()) {
+		std::vector<pcl::PCLPointField> fields;
+		int field_index = pcl::getFieldIndex<PointT>(filter_limit_field_name_, fields);
+		if (field_index >= 0) {
+			filter_limit_field_offset_ = fields[field_index].offset;
+		} else {
+			ROS_WARN_STREAM(CloudFilter<PointT>::filter_name_ << " filter limit field [" << filter_limit_field_name_ << "] does not exist in the point type -> disabling filter limits");
+		}
+	}
+
+	private_node_handle->param(configuration_namespace + "downsample_all_data", downsample_all_data_, false);
+	private_node_handle->param(configuration_namespace + "minimum_number_of_points_per_voxel", minimum_number_of_points_per_voxel_, 1);
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads_, 0);
+
+	CloudFilter<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+}
+
+
+template<typename PointT>
+void HashedVoxelGrid<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud) {
+	size_t number_of_points_in_input_cloud = input_cloud->size();
+
+	size_t number_of_shards = 1;
+#ifdef _OPENMP
+	number_of_shards = (size_t)(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads());
+#endif
+	if (number_of_points_in_input_cloud < number_of_shards * 1000) { number_of_shards = 1; }
+
+	if (hash_shards_.size() != number_of_shards) { hash_shards_.resize(number_of_shards); }
+	computePointsVoxelCoordinates(*input_cloud, number_of_shards);
+
+	#pragma omp parallel for schedule(static, 1) num_threads(number_of_shards)
+	for (int shard_index = 0; shard_index < (int)number_of_shards; ++shard_index) {
+		accumulateShardVoxels(*input_cloud, (size_t)shard_index);
+	}
+
+	std::vector<size_t> shards_output_offsets(number_of_shards + 1, 0);
+	for (size_t shard_index = 0; shard_index < number_of_shards; ++shard_index) {
+		size_t number_of_valid_voxels = 0;
+		for (size_t i = 0; i < hash_shards_[shard_index].voxels.size(); ++i) {
+			if (hash_shards_[shard_index].voxels[i].number_of_points >= (std::uint32_t)minimum_number_of_points_per_voxel_) { ++number_of_valid_voxels; }
+		}
+		shards_output_offsets[shard_index + 1] = shards_output_offsets[shard_index] + number_of_valid_voxels;
+	}
+
+	output_cloud->resize(shards_output_offsets.back());
+	output_cloud->header = input_cloud->header;
+	output_cloud->sensor_origin_ = input_cloud->sensor_origin_;
+	output_cloud->sensor_orientation_ = input_cloud->sensor_orientation_;
+	output_cloud->width = output_cloud->size();
+	output_cloud->height = 1;
+	output_cloud->is_dense = true;
+
+	#pragma omp parallel for schedule(static, 1) num_threads(number_of_shards)
+	for (int shard_index = 0; shard_index < (int)number_of_shards; ++shard_index) {
+		const std::vector<VoxelAccumulator>& voxels = hash_shards_[shard_index].voxels;
+		size_t output_index = shards_output_offsets[shard_index];
+		for (size_t i = 0; i < voxels.size(); ++i) {
+			if (voxels[i].number_of_points >= (std::uint32_t)minimum_number_of_points_per_voxel_) {
+				computeVoxelPoint(*input_cloud, voxels[i], (*output_cloud)[output_index++]);
+			}
+		}
+	}
+
+	if (CloudFilter<PointT>::cloud_publisher_ && output_cloud) { CloudFilter<PointT>::cloud_publisher_->publishPointCloud(*output_cloud); }
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
+}
+
+
+template<typename PointT>
+void HashedVoxelGrid<PointT>::computePointsVoxelCoordinates(const pcl::PointCloud<PointT>& input_cloud, size_t number_of_shards) {
+	const size_t number_of_points = input_cloud.size();
+	const size_t number_of_blocks = number_of_shards;
+	points_voxel_coordinates_.resize(number_of_points);
+	points_voxel_hashes_.resize(number_of_points);
+	points_shard_index_.resize(number_of_points);
+	blocks_shards_points_offsets_.assign(number_of_blocks * number_of_shards, 0);
+
+	// each block counts how many of its points belong to each shard
+	#pragma omp parallel for schedule(static, 1) num_threads(number_of_shards)
+	for (int block_index = 0; block_index < (int)number_of_blocks; ++block_index) {
+		size_t block_begin = number_of_points * block_index / number_of_blocks;
+		size_t block_end = number_of_points * (block_index + 1) / number_of_blocks;
+		size_t* block_shards_counts = &blocks_shards_points_offsets_[block_index * number_of_shards];
+		for (size_t i = block_begin; i < block_end; ++i) {
+			const PointT& point = input_cloud[i];
+			points_shard_index_[i] = -1;
+			if (!pcl::isFinite(point)) { continue; }
+
+			if (filter_limit_field_offset_ >= 0) {
+				float field_value;
+				memcpy(&field_value, reinterpret_cast<const std::uint8_t*>(&point) + filter_limit_field_offset_, sizeof(float));
+				if (!std::isfinite(field_value) || field_value < filter_limit_min_ || field_value > filter_limit_max_) { continue; }
+			}
+
+			VoxelCoordinates& voxel_coordinates = points_voxel_coordinates_[i];
+			voxel_coordinates.x = (std::int64_t)std::floor(point.x * inverse_leaf_size_(0));
+			voxel_coordinates.y = (std::int64_t)std::floor(point.y * inverse_leaf_size_(1));
+			voxel_coordinates.z = (std::int64_t)std::floor(point.z * inverse_leaf_size_(2));
+			std::uint64_t voxel_hash = computeVoxelCoordinatesHash(voxel_coordinates);
+			points_voxel_hashes_[i] = voxel_hash;
+			int shard_index = (int)((voxel_hash >> 32) % number_of_shards);
+			points_shard_index_[i] = shard_index;
+			++block_shards_counts[shard_index];
+		}
+	}
+
+	// the points of each shard are stored contiguously, ordered by block (which keeps the cloud order within each shard)
+	shards_points_offsets_.assign(number_of_shards + 1, 0);
+	size_t offset = 0;
+	for (size_t shard_index = 0; shard_index < number_of_shards; ++shard_index) {
+		shards_points_offsets_[shard_index] = offset;
+		for (size_t block_index = 0; block_index < number_of_blocks; ++block_index) {
+			size_t block_shard_count = blocks_shards_points_offsets_[block_index * number_of_shards + shard_index];
+			blocks_shards_points_offsets_[block_index * number_of_shards + shard_index] = offset;
+			offset += block_shard_count;
+		}
+	}
+	shards_points_offsets_[number_of_shards] = offset;
+	shards_points_indices_.resize(offset);
+
+	#pragma omp parallel for schedule(static, 1) num_threads(number_of_shards)
+	for (int block_index = 0; block_index < (int)number_of_blocks; ++block_index) {
+		size_t block_begin = number_of_points * block_index / number_of_blocks;
+		size_t block_end = number_of_points * (block_index + 1) / number_of_blocks;
+		size_t* block_shards_offsets = &blocks_shards_points_offsets_[block_index * number_of_shards];
+		for (size_t i = block_begin; i < block_end; ++i) {
+			if (points_shard_index_[i] >= 0) { shards_points_indices_[block_shards_offsets[points_shard_index_[i]]++] = (pcl::index_t)i; }
+		}
+	}
+}
+
+
+template<typename PointT>
+void HashedVoxelGrid<PointT>::accumulateShardVoxels(const pcl::PointCloud<PointT>& input_cloud, size_t shard_index) {
+	HashShard& shard = hash_shards_[shard_index];
+	shard.voxels.clear();
+
+	const size_t shard_points_begin = shards_points_offsets_[shard_index];
+	const size_t shard_points_end = shards_points_offsets_[shard_index + 1];
+	size_t hash_table_size = computeHashTableSize(shard_points_end - shard_points_begin + 1);
+	HashTableSlot empty_slot = { { 0, 0, 0 }, EMPTY_SLOT };
+	if (shard.hash_table.size() < hash_table_size) { shard.hash_table.resize(hash_table_size); }
+	std::fill(shard.hash_table.begin(), shard.hash_table.end(), empty_slot);
+
+	Eigen::Vector3f normal;
+	float curvature;
+	std::uint8_t r, g, b;
+	for (size_t shard_point = shard_points_begin; shard_point < shard_points_end; ++shard_point) {
+		const pcl::index_t i = shards_points_indices_[shard_point];
+		const PointT& point = input_cloud[i];
+		VoxelAccumulator& voxel = shard.voxels[findOrInsertVoxel(shard, points_voxel_coordinates_[i], points_voxel_hashes_[i])];
+		if (voxel.number_of_points == 0) { voxel.first_point_index = i; }
+		++voxel.number_of_points;
+		voxel.position_sum += Eigen::Vector3d(point.x, point.y, point.z);
+		if (downsample_all_data_) {
+			if (pointcloud_utils::getPointNormal(point, normal)) { voxel.normal_sum += normal; }
+			if (pointcloud_utils::getPointColor(point, r, g, b)) { voxel.color_sum += Eigen::Vector3f(r, g, b); }
+			if (pointcloud_utils::getPointCurvature(point, curvature)) { voxel.curvature_sum += curvature; }
+		}
+	}
+}
+
+
+template<typename PointT>
+std::uint32_t HashedVoxelGrid<PointT>::findOrInsertVoxel(HashShard& shard, const VoxelCoordinates& voxel_coordinates, std::uint64_t voxel_hash) {
+	if ((shard.voxels.size() + 1) * 2 > shard.hash_table.size()) { growHashTable(shard); }
+
+	size_t slot_mask = shard.hash_table.size() - 1;
+	size_t slot_index = (size_t)voxel_hash & slot_mask;
+	while (true) {
+		HashTableSlot& slot = shard.hash_table[slot_index];
+		if (slot.voxel_index == EMPTY_SLOT) {
+			slot.voxel_coordinates = voxel_coordinates;
+			slot.voxel_index = (std::uint32_t)shard.voxels.size();
+			VoxelAccumulator voxel;
+			voxel.position_sum.setZero();
+			voxel.normal_sum.setZero();
+			voxel.color_sum.setZero();
+			voxel.curvature_sum = 0.0f;
+			voxel.number_of_points = 0;
+			voxel.first_point_index = 0;
+			shard.voxels.push_back(voxel);
+			return slot.voxel_index;
+		} else if (slot.voxel_coordinates == voxel_coordinates) {
+			return slot.voxel_index;
+		}
+		slot_index = (slot_index + 1) & slot_mask;
+	}
+}
+
+
+template<typename PointT>
+void HashedVoxelGrid<PointT>::growHashTable(HashShard& shard) {
+	HashTableSlot empty_slot = { { 0, 0, 0 }, EMPTY_SLOT };
+	std::vector<HashTableSlot> hash_table(std::max(shard.hash_table.size() * 2, (size_t)1024), empty_slot);
+	size_t slot_mask = hash_table.size() - 1;
+	for (size_t i = 0; i < shard.hash_table.size(); ++i) {
+		if (shard.hash_table[i].voxel_index != EMPTY_SLOT) {
+			size_t slot_index = (size_t)computeVoxelCoordinatesHash(shard.hash_table[i].voxel_coordinates) & slot_mask;
+			while (hash_table[slot_index].voxel_index != EMPTY_SLOT) { slot_index = (slot_index + 1) & slot_mask; }
+			hash_table[slot_index] = shard.hash_table[i];
+		}
+	}
+	shard.hash_table.swap(hash_table);
+}
+
+
+template<typename PointT>
+void HashedVoxelGrid<PointT>::computeVoxelPoint(const pcl::PointCloud<PointT>& input_cloud, const VoxelAccumulator& voxel, PointT& voxel_point) {
+	voxel_point = input_cloud[voxel.first_point_index];
+	Eigen::Vector3d centroid = voxel.position_sum / (double)voxel.number_of_points;
+	voxel_point.x = (float)centroid(0);
+	voxel_point.y = (float)centroid(1);
+	voxel_point.z = (float)centroid(2);
+
+	if (downsample_all_data_) {
+		float number_of_points = (float)voxel.number_of_points;
+		float normal_norm = voxel.normal_sum.norm();
+		if (normal_norm > 0.0f) { pointcloud_utils::setPointNormal(voxel_point, Eigen::Vector3f(voxel.normal_sum / normal_norm)); }
+		Eigen::Vector3f color_mean = voxel.color_sum / number_of_points;
+		pointcloud_utils::setPointColor(voxel_point, (std::uint8_t)(color_mean(0) + 0.5f), (std::uint8_t)(color_mean(1) + 0.5f), (std::uint8_t)(color_mean(2) + 0.5f));
+		pointcloud_utils::setPointCurvature(voxel_point, voxel.curvature_sum / number_of_points);
+	}
+}
+
+
+template<typename PointT>
+size_t HashedVoxelGrid<PointT>::computeHashTableSize(size_t expected_number_of_voxels) {
+	size_t hash_table_size = 1024;
+	while (hash_table_size < expected_number_of_voxels * 2) { hash_table_size *= 2; }
+	return hash_table_size;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </HashedVoxelGrid-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -28,6 +28,9 @@ void HSVSegmentation<PointT>::setupConfigurationFromParameterServer(ros::NodeHan
 	private_node_handle->param(configuration_namespace + "minimum_value", minimum_value_, 0.0);
 	private_node_handle->param(configuration_namespace + "maximum_value", maximum_value_, 1.0);
 	private_node_handle->param(configuration_namespace + "invert_segmentation", invert_segmentation_, false);
+	if (!pcl::traits::has_color<PointT>::value) {
+		ROS_WARN_STREAM("HSVSegmentation: the localization point type does not have color data (all points will be kept)");
+	}
 	CloudFilter<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 }
 
@@ -36,29 +39,54 @@ void HSVSegmentation<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr
 	size_t number_of_points_in_input_cloud = input_cloud->size();
 
 	for (size_t i = 0; i < input_cloud->size(); ++i) {
-		PointT& point = (*input_cloud)[i];
-		float h = 0.0f, s = 0.0f, v = 0.0f;
-		pcl::RGBtoHSV(point.r, point.g, point.b, h, s, v);
-
-		bool valid_hue;
-		if (minimum_hue_ < maximum_hue_) {
-			valid_hue = (h >= minimum_hue_) && (h <= maximum_hue_);
-		} else {
-			// hue wrap around in the HSV cylinder
-			valid_hue = (h <= maximum_hue_) || (h >= minimum_hue_);
+		if (isPointSelected((*input_cloud)[i])) {
+			output_cloud->push_back((*input_cloud)[i]);
 		}
+	}
 
-		bool valid_saturation = (s >= minimum_saturation_) && (s <= maximum_saturation_);
-		bool valid_value = (v >= minimum_value_) && (v <= maximum_value_);
-		bool valid_point = valid_hue && valid_saturation && valid_value;
+	if (CloudFilter<PointT>::cloud_publisher_ && output_cloud) { CloudFilter<PointT>::cloud_publisher_->publishPointCloud(*output_cloud); }
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
+}
 
-		if ((valid_point && !invert_segmentation_) || (!valid_point && invert_segmentation_)) {
-			output_cloud->push_back(point);
+template<typename PointT>
+bool HSVSegmentation<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	size_t number_of_points_in_input_cloud = input_indices ? input_indices->size() : input_cloud->size();
+	output_indices.reset(new pcl::Indices());
+	output_indices->reserve(number_of_points_in_input_cloud);
+
+	for (size_t i = 0; i < number_of_points_in_input_cloud; ++i) {
+		pcl::index_t point_index = input_indices ? (*input_indices)[i] : (pcl::index_t)i;
+		if (isPointSelected((*input_cloud)[point_index])) {
+			output_indices->push_back(point_index);
 		}
 	}
 
-	if (CloudFilter<PointT>::cloud_publisher_ && output_cloud) { CloudFilter<PointT>::cloud_publisher_->publishPointCloud(*output_cloud); }
-	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
+	CloudFilter<PointT>::publishFilteredCloud(input_cloud, output_indices);
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud indices from " << number_of_points_in_input_cloud << " points to " << output_indices->size() << " points");
+	return true;
+}
+
+template<typename PointT>
+bool HSVSegmentation<PointT>::isPointSelected(const PointT& point) {
+	std::uint8_t r = 0, g = 0, b = 0;
+	if (!pointcloud_utils::getPointColor(point, r, g, b)) { return true; }
+
+	float h = 0.0f, s = 0.0f, v = 0.0f;
+	pcl::RGBtoHSV(r, g, b, h, s, v);
+
+	bool valid_hue;
+	if (minimum_hue_ < maximum_hue_) {
+		valid_hue = (h >= minimum_hue_) && (h <= maximum_hue_);
+	} else {
+		// hue wrap around in the HSV cylinder
+		valid_hue = (h <= maximum_hue_) || (h >= minimum_hue_);
+	}
+
+	bool valid_saturation = (s >= minimum_saturation_) && (s <= maximum_saturation_);
+	bool valid_value = (v >= minimum_value_) && (v <= maximum_value_);
+	bool valid_point = valid_hue && valid_saturation && valid_value;
+
+	return (valid_point && !invert_segmentation_) || (!valid_point && invert_segmentation_);
 }
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </HSVSegmentation-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
@@ -27,10 +27,23 @@ void PlaneSegmentation<PointT>::setupConfigurationFromParameterServer(ros::NodeH
 	private_node_handle->param(configuration_namespace + "sample_consensus_normals_difference_weight", sample_consensus_normals_difference_weight_, 0.1);
 	private_node_handle->param(configuration_namespace + "sample_consensus_number_of_iterations", sample_consensus_number_of_iterations_, 1000);
 	private_node_handle->param(configuration_namespace + "sample_consensus_probability_of_sample_not_be_an_outlier", sample_consensus_probability_of_sample_not_be_an_outlier_, 0.5);
+	private_node_handle->param(configuration_namespace + "sample_consensus_number_of_threads", sample_consensus_number_of_threads_, -1);
+	private_node_handle->param(configuration_namespace + "sample_consensus_use_random_seed", sample_consensus_use_random_seed_, false);
+	private_node_handle->param(configuration_namespace + "maximum_number_of_planes", maximum_number_of_planes_, 1);
+	private_node_handle->param(configuration_namespace + "minimum_number_of_plane_inliers", minimum_number_of_plane_inliers_, 3);
+	private_node_handle->param(configuration_namespace + "remove_plane_inliers", remove_plane_inliers_, false);
 	private_node_handle->param(configuration_namespace + "plane_convex_hull_scaling_factor", plane_convex_hull_scaling_factor_, 1.0);
 	private_node_handle->param(configuration_namespace + "segmentation_minimum_distance_to_plane", segmentation_minimum_distance_to_plane_, 0.01);
 	private_node_handle->param(configuration_namespace + "segmentation_maximum_distance_to_plane", segmentation_maximum_distance_to_plane_, 0.42);
 
+	if (maximum_number_of_planes_ < 1) { maximum_number_of_planes_ = 1; }
+	if (minimum_number_of_plane_inliers_ < 3) { minimum_number_of_plane_inliers_ = 3; }
+
+	// sample consensus model and method are created on the first call to filter (they require an input cloud) and are reused afterwards
+	sample_consensus_model_.reset();
+	sample_consensus_model_normal_plane_.reset();
+	sample_consensus_.reset();
+
 	plane_inliers_cloud_publisher_ = typename CloudPublisher<PointT>::Ptr(new CloudPublisher<PointT>());
 	plane_inliers_cloud_publisher_->setParameterServerArgumentToLoadTopicName(configuration_namespace + "plane_inliers_cloud_publish_topic");
 	plane_inliers_cloud_publisher_->setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
@@ -42,113 +55,184 @@ void PlaneSegmentation<PointT>::setupConfigurationFromParameterServer(ros::NodeH
 	CloudFilter<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 }
 
-template<typename PointT>
-void PlaneSegmentation<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud) {
-	size_t number_of_points_in_input_cloud = input_cloud->size();
 
-	std::shared_ptr< pcl::SACSegmentation<PointT> > sac_segmentation;
-	std::shared_ptr< pcl::SACSegmentationFromNormals<PointT, PointT> > sac_segmentation_from_normals;
+template<typename PointT>
+void PlaneSegmentation<PointT>::setupSampleConsensus(const typename pcl::PointCloud<PointT>::Ptr& input_cloud) {
+	if (sample_consensus_model_) {
+		sample_consensus_model_->setInputCloud(input_cloud);
+		if (sample_consensus_model_normal_plane_) { sample_consensus_model_normal_plane_->setInputNormals(input_cloud); }
+		return;
+	}
 
 	if (use_surface_normals_) {
-		sac_segmentation_from_normals = std::shared_ptr< pcl::SACSegmentationFromNormals<PointT, PointT> >(new pcl::SACSegmentationFromNormals<PointT, PointT>());
-		sac_segmentation_from_normals->setModelType(pcl::SACMODEL_NORMAL_PLANE);
-		sac_segmentation_from_normals->setNormalDistanceWeight(sample_consensus_normals_difference_weight_);
-		sac_segmentation_from_normals->setInputNormals(input_cloud);
-		sac_segmentation = sac_segmentation_from_normals;
+		sample_consensus_model_normal_plane_ = typename pcl::SampleConsensusModelNormalPlane<PointT, PointT>::Ptr(new pcl::SampleConsensusModelNormalPlane<PointT, PointT>(input_cloud, sample_consensus_use_random_seed_));
+		sample_consensus_model_normal_plane_->setNormalDistanceWeight(sample_consensus_normals_difference_weight_);
+		sample_consensus_model_normal_plane_->setInputNormals(input_cloud);
+		sample_consensus_model_ = sample_consensus_model_normal_plane_;
 	} else {
-		sac_segmentation = std::shared_ptr< pcl::SACSegmentation<PointT> >(new pcl::SACSegmentation<PointT>());
-		sac_segmentation->setModelType(pcl::SACMODEL_PLANE);
+		sample_consensus_model_ = typename pcl::SampleConsensusModel<PointT>::Ptr(new pcl::SampleConsensusModelPlane<PointT>(input_cloud, sample_consensus_use_random_seed_));
 	}
 
-	sac_segmentation->setDistanceThreshold(sample_consensus_maximum_distance_of_sample_to_plane_);
-	sac_segmentation->setMaxIterations(sample_consensus_number_of_iterations_);
-	sac_segmentation->setProbability(sample_consensus_probability_of_sample_not_be_an_outlier_);
-	sac_segmentation->setOptimizeCoefficients(true);
-
 	if (sample_consensus_method_ == "SAC_LMEDS")
-		sac_segmentation->setMethodType(pcl::SAC_LMEDS);
+		sample_consensus_.reset(new pcl::LeastMedianSquares<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else if (sample_consensus_method_ == "SAC_MSAC")
-		sac_segmentation->setMethodType(pcl::SAC_MSAC);
+		sample_consensus_.reset(new pcl::MEstimatorSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else if (sample_consensus_method_ == "SAC_RRANSAC")
-		sac_segmentation->setMethodType(pcl::SAC_RRANSAC);
+		sample_consensus_.reset(new pcl::RandomizedRandomSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else if (sample_consensus_method_ == "SAC_RMSAC")
-		sac_segmentation->setMethodType(pcl::SAC_RMSAC);
+		sample_consensus_.reset(new pcl::RandomizedMEstimatorSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else if (sample_consensus_method_ == "SAC_MLESAC")
-		sac_segmentation->setMethodType(pcl::SAC_MLESAC);
+		sample_consensus_.reset(new pcl::MaximumLikelihoodSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else if (sample_consensus_method_ == "SAC_PROSAC")
-		sac_segmentation->setMethodType(pcl::SAC_PROSAC);
+		sample_consensus_.reset(new pcl::ProgressiveSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
 	else
-		sac_segmentation->setMethodType(pcl::SAC_RANSAC);
-
-	sac_segmentation->setInputCloud(input_cloud);
-
-	pcl::PointIndices::Ptr plane_inliers(new pcl::PointIndices());
-	plane_coefficients_ = pcl::ModelCoefficients::Ptr(new pcl::ModelCoefficients());
-	sac_segmentation->segment(*plane_inliers, *plane_coefficients_);
-
-	if (plane_inliers->indices.size() > 0) {
-		if (plane_inliers_cloud_publisher_ && !plane_inliers_cloud_publisher_->getCloudPublishTopic().empty()) {
-			pcl::ExtractIndices<PointT> plane_inliers_extractor;
-			plane_inliers_extractor.setInputCloud(input_cloud);
-			plane_inliers_extractor.setIndices(plane_inliers);
-			typename pcl::PointCloud<PointT>::Ptr plane_inliers_pointcloud(new pcl::PointCloud<PointT>());
-			plane_inliers_extractor.filter(*plane_inliers_pointcloud);
-			plane_inliers_cloud_publisher_->publishPointCloud(*plane_inliers_pointcloud);
+		sample_consensus_.reset(new pcl::RandomSampleConsensus<PointT>(sample_consensus_model_, sample_consensus_maximum_distance_of_sample_to_plane_));
+
+	sample_consensus_->setMaxIterations(sample_consensus_number_of_iterations_);
+	sample_consensus_->setProbability(sample_consensus_probability_of_sample_not_be_an_outlier_);
+	sample_consensus_->setNumberOfThreads(sample_consensus_number_of_threads_); // only used by SAC_RANSAC (< 0 -> serial | 0 -> number of cores | > 0 -> number of threads)
+}
+
+
+template<typename PointT>
+size_t PlaneSegmentation<PointT>::segmentPlanes(const typename pcl::PointCloud<PointT>::Ptr& input_cloud) {
+	planes_coefficients_.clear();
+	planes_inliers_.clear();
+	plane_inliers_mask_.assign(input_cloud->size(), false);
+
+	remaining_indices_->resize(input_cloud->size());
+	for (size_t i = 0; i < input_cloud->size(); ++i) {
+		(*remaining_indices_)[i] = i;
+	}
+
+	setupSampleConsensus(input_cloud);
+
+	while (planes_coefficients_.size() < (size_t)maximum_number_of_planes_ && remaining_indices_->size() >= (size_t)minimum_number_of_plane_inliers_) {
+		sample_consensus_model_->setIndices(remaining_indices_);
+		if (!sample_consensus_->computeModel()) { break; }
+
+		pcl::IndicesPtr plane_inliers(new pcl::Indices());
+		Eigen::VectorXf model_coefficients, model_coefficients_refined;
+		sample_consensus_->getInliers(*plane_inliers);
+		sample_consensus_->getModelCoefficients(model_coefficients);
+
+		sample_consensus_model_->optimizeModelCoefficients(*plane_inliers, model_coefficients, model_coefficients_refined);
+		if (model_coefficients_refined.size() == model_coefficients.size()) {
+			model_coefficients = model_coefficients_refined;
+			sample_consensus_model_->selectWithinDistance(model_coefficients, sample_consensus_maximum_distance_of_sample_to_plane_, *plane_inliers);
 		}
 
-		pcl::ProjectInliers<PointT> plane_inliers_projection_;
+		if (plane_inliers->size() < (size_t)minimum_number_of_plane_inliers_) { break; }
+
+		pcl::ModelCoefficients::Ptr plane_coefficients(new pcl::ModelCoefficients());
+		plane_coefficients->header = input_cloud->header;
+		plane_coefficients->values.assign(model_coefficients.data(), model_coefficients.data() + model_coefficients.size());
+		planes_coefficients_.push_back(plane_coefficients);
+		planes_inliers_.push_back(plane_inliers);
+
+		for (size_t i = 0; i < plane_inliers->size(); ++i) {
+			plane_inliers_mask_[(*plane_inliers)[i]] = true;
+		}
+
+		remaining_indices_->erase(std::remove_if(remaining_indices_->begin(), remaining_indices_->end(),
+				[this](const pcl::index_t index) { return plane_inliers_mask_[index]; }), remaining_indices_->end());
+
+		ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " segmented plane " << planes_coefficients_.size() << " with " << plane_inliers->size() << " inliers (" << remaining_indices_->size() << " points remaining)");
+	}
+
+	return planes_coefficients_.size();
+}
+
+
+template<typename PointT>
+void PlaneSegmentation<PointT>::segmentPointsOnTopOfPlane(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& plane_inliers, const pcl::ModelCoefficients::Ptr& plane_coefficients, std::vector<bool>& selected_points_mask) {
+	pcl::ProjectInliers<PointT> plane_inliers_projection_;
 
-		if (use_surface_normals_)
-			plane_inliers_projection_.setModelType(pcl::SACMODEL_NORMAL_PLANE);
-		else
-			plane_inliers_projection_.setModelType(pcl::SACMODEL_PLANE);
+	if (use_surface_normals_)
+		plane_inliers_projection_.setModelType(pcl::SACMODEL_NORMAL_PLANE);
+	else
+		plane_inliers_projection_.setModelType(pcl::SACMODEL_PLANE);
+
+	plane_inliers_projection_.setInputCloud(input_cloud);
+	plane_inliers_projection_.setIndices(plane_inliers);
+	plane_inliers_projection_.setModelCoefficients(plane_coefficients);
+	typename pcl::PointCloud<PointT>::Ptr plane_inliers_projected_into_plane_model(new pcl::PointCloud<PointT>());
+	plane_inliers_projection_.filter (*plane_inliers_projected_into_plane_model);
+
+	pcl::ConvexHull<PointT> plane_convex_hull_;
+	plane_convex_hull_.setInputCloud(plane_inliers_projected_into_plane_model);
+	typename pcl::PointCloud<PointT>::Ptr convex_hull_for_projected_plane_inliers(new pcl::PointCloud<PointT>());
+	plane_convex_hull_.reconstruct(*convex_hull_for_projected_plane_inliers);
 
-		plane_inliers_projection_.setInputCloud(input_cloud);
-		plane_inliers_projection_.setIndices(plane_inliers);
-		plane_inliers_projection_.setModelCoefficients(plane_coefficients_);
-		typename pcl::PointCloud<PointT>::Ptr plane_inliers_projected_into_plane_model(new pcl::PointCloud<PointT>());
-		plane_inliers_projection_.filter (*plane_inliers_projected_into_plane_model);
+	if (plane_convex_hull_scaling_factor_ != 1.0) {
+		Eigen::Vector4f centroid;
+		pcl::compute3DCentroid(*convex_hull_for_projected_plane_inliers, centroid);
 
-		pcl::ConvexHull<PointT> plane_convex_hull_;
-		plane_convex_hull_.setInputCloud(plane_inliers_projected_into_plane_model);
-		typename pcl::PointCloud<PointT>::Ptr convex_hull_for_projected_plane_inliers(new pcl::PointCloud<PointT>());
-		plane_convex_hull_.reconstruct(*convex_hull_for_projected_plane_inliers);
+		Eigen::Matrix4f centroid_matrix = Eigen::Matrix4f::Identity();
+		centroid_matrix.col(3).head<3>() << centroid(0), centroid(1), centroid(2);
+		Eigen::Matrix4f centroid_matrix_inverse = centroid_matrix.inverse();
 
-		if (plane_convex_hull_scaling_factor_ != 1.0) {
-			Eigen::Vector4f centroid;
-			pcl::compute3DCentroid(*convex_hull_for_projected_plane_inliers, centroid);
+		pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, centroid_matrix_inverse);
 
-			Eigen::Matrix4f centroid_matrix = Eigen::Matrix4f::Identity();
-			centroid_matrix.col(3).head<3>() << centroid(0), centroid(1), centroid(2);
-			Eigen::Matrix4f centroid_matrix_inverse = centroid_matrix.inverse();
+		Eigen::Matrix4f scale_matrix = Eigen::Matrix4f(Eigen::Matrix4f::Identity()) * plane_convex_hull_scaling_factor_;
+		pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, scale_matrix);
 
-			pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, centroid_matrix_inverse);
+		pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, centroid_matrix);
+	}
+
+	if (plane_inliers_convex_hull_cloud_publisher_ && !plane_inliers_convex_hull_cloud_publisher_->getCloudPublishTopic().empty()) {
+		plane_inliers_convex_hull_cloud_publisher_->publishPointCloud(*convex_hull_for_projected_plane_inliers);
+	}
 
-			Eigen::Matrix4f scale_matrix = Eigen::Matrix4f(Eigen::Matrix4f::Identity()) * plane_convex_hull_scaling_factor_;
-			pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, scale_matrix);
+	pcl::ExtractPolygonalPrismData<PointT> polygonal_segmentation_;
+	polygonal_segmentation_.setHeightLimits(segmentation_minimum_distance_to_plane_, segmentation_maximum_distance_to_plane_);
+	polygonal_segmentation_.setInputCloud(input_cloud);
+	polygonal_segmentation_.setInputPlanarHull(convex_hull_for_projected_plane_inliers);
+	pcl::PointIndices indices_for_points_on_top_of_plane;
+	polygonal_segmentation_.segment(indices_for_points_on_top_of_plane);
 
-			pcl::transformPointCloudWithNormals<PointT>(*convex_hull_for_projected_plane_inliers, *convex_hull_for_projected_plane_inliers, centroid_matrix);
+	for (size_t i = 0; i < indices_for_points_on_top_of_plane.indices.size(); ++i) {
+		selected_points_mask[indices_for_points_on_top_of_plane.indices[i]] = true;
+	}
+}
+
+
+template<typename PointT>
+void PlaneSegmentation<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud) {
+	size_t number_of_points_in_input_cloud = input_cloud->size();
+	size_t number_of_planes = segmentPlanes(input_cloud);
+
+	if (number_of_planes > 0 && plane_inliers_cloud_publisher_ && !plane_inliers_cloud_publisher_->getCloudPublishTopic().empty()) {
+		pcl::Indices all_planes_inliers;
+		for (size_t i = 0; i < planes_inliers_.size(); ++i) {
+			all_planes_inliers.insert(all_planes_inliers.end(), planes_inliers_[i]->begin(), planes_inliers_[i]->end());
 		}
+		typename pcl::PointCloud<PointT>::Ptr plane_inliers_pointcloud(new pcl::PointCloud<PointT>());
+		pcl::copyPointCloud(*input_cloud, all_planes_inliers, *plane_inliers_pointcloud);
+		plane_inliers_cloud_publisher_->publishPointCloud(*plane_inliers_pointcloud);
+	}
 
-		if (plane_inliers_convex_hull_cloud_publisher_ && !plane_inliers_convex_hull_cloud_publisher_->getCloudPublishTopic().empty()) {
-			plane_inliers_convex_hull_cloud_publisher_->publishPointCloud(*convex_hull_for_projected_plane_inliers);
+	if (remove_plane_inliers_) {
+		if (number_of_planes > 0) {
+			pcl::copyPointCloud(*input_cloud, *remaining_indices_, *output_cloud);
+		} else {
+			*output_cloud = *input_cloud;
+		}
+	} else if (number_of_planes > 0) {
+		std::vector<bool> points_on_top_of_planes_mask(input_cloud->size(), false);
+		for (size_t i = 0; i < number_of_planes; ++i) {
+			segmentPointsOnTopOfPlane(input_cloud, planes_inliers_[i], planes_coefficients_[i], points_on_top_of_planes_mask);
 		}
 
-		pcl::ExtractPolygonalPrismData<PointT> polygonal_segmentation_;
-		polygonal_segmentation_.setHeightLimits(segmentation_minimum_distance_to_plane_, segmentation_maximum_distance_to_plane_);
-		polygonal_segmentation_.setInputCloud(input_cloud);
-		polygonal_segmentation_.setInputPlanarHull(convex_hull_for_projected_plane_inliers);
-		pcl::PointIndices indices_for_points_on_top_of_plane;
-		polygonal_segmentation_.segment(indices_for_points_on_top_of_plane);
-
-		pcl::ExtractIndices<PointT> indices_extractor;
-		indices_extractor.setInputCloud(input_cloud);
-		indices_extractor.setIndices(pcl::make_shared<const pcl::PointIndices>(indices_for_points_on_top_of_plane));
-		indices_extractor.filter(*output_cloud);
+		pcl::Indices indices_for_points_on_top_of_planes;
+		for (size_t i = 0; i < points_on_top_of_planes_mask.size(); ++i) {
+			if (points_on_top_of_planes_mask[i]) { indices_for_points_on_top_of_planes.push_back(i); }
+		}
+		pcl::copyPointCloud(*input_cloud, indices_for_points_on_top_of_planes, *output_cloud);
 	}
 
 	if (CloudFilter<PointT>::getCloudPublisher() && output_cloud) { CloudFilter<PointT>::getCloudPublisher()->publishPointCloud(*output_cloud); }
-	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter segmented " << number_of_planes << " planes and reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
 }
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PlaneSegmentation-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
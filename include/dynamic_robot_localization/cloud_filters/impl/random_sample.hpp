@@ -64,6 +64,30 @@ void RandomSample<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& i
 	if (CloudFilter<PointT>::getCloudPublisher() && output_cloud) { CloudFilter<PointT>::getCloudPublisher()->publishPointCloud(*output_cloud); }
 	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
 }
+
+template<typename PointT>
+bool RandomSample<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	size_t number_of_points_in_input_cloud = input_indices ? input_indices->size() : input_cloud->size();
+
+	typename pcl::RandomSample<PointT>::Ptr filter = std::static_pointer_cast< typename pcl::RandomSample<PointT> >(CloudFilter<PointT>::filter_);
+
+	if (reinitialize_seed_before_filtering_) {
+		filter->setSeed(time(NULL));
+	}
+
+	if (filter->getSample() >= number_of_points_in_input_cloud) {
+		if (filter->getNegative()) {
+			output_indices.reset(new pcl::Indices());
+		} else {
+			output_indices = input_indices;
+		}
+		CloudFilter<PointT>::publishFilteredCloud(input_cloud, output_indices);
+		ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter reduced point cloud indices from " << number_of_points_in_input_cloud << " points to " << (output_indices ? output_indices->size() : input_cloud->size()) << " points");
+		return true;
+	}
+
+	return CloudFilter<PointT>::filterIndices(input_cloud, input_indices, output_indices);
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </RandomSample-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
@@ -83,6 +83,26 @@ void RegionGrowing<PointT>::setupConfigurationFromParameterServer(ros::NodeHandl
 	private_node_handle->param(configuration_namespace + "number_of_neighbors", number_of_neighbors, 50);
 	region_growing_->setNumberOfNeighbours(number_of_neighbors);
 
+	// parallel approximation of region growing, in which neighbors within the search radius are in the same region if the angle between their normals is below the smoothness threshold
+	// and (when the curvature test is active) at least one of them has curvature below the threshold
+	private_node_handle->param(configuration_namespace + "use_voxel_hash_clustering", use_voxel_hash_clustering_, false);
+	double neighbors_search_radius;
+	int number_of_threads;
+	private_node_handle->param(configuration_namespace + "neighbors_search_radius", neighbors_search_radius, 0.05);
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads, 0);
+	voxel_hash_clustering_.setClusterTolerance(neighbors_search_radius);
+	voxel_hash_clustering_.setMinClusterSize(min_cluster_size);
+	voxel_hash_clustering_.setMaxClusterSize(max_cluster_size);
+	voxel_hash_clustering_.setNumberOfThreads(number_of_threads);
+
+	float minimum_normals_cosine = (float)std::cos(smoothness_threshold_in_degrees * M_PI / 180.0);
+	float maximum_curvature = (float)curvature_threshold;
+	voxel_hash_clustering_.setPointPairTest([=](const PointT& first_point, const PointT& second_point) {
+		if (std::abs(first_point.getNormalVector3fMap().dot(second_point.getNormalVector3fMap())) < minimum_normals_cosine) { return false; }
+		if (use_curvature_test && std::min(first_point.curvature, second_point.curvature) >= maximum_curvature) { return false; }
+		return true;
+	});
+
 	cluster_selector_.setTfCollector(CloudFilter<PointT>::getTfCollector());
 	cluster_selector_.setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace + "cluster_selector/");
 	CloudFilter<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
@@ -93,14 +113,8 @@ template<typename PointT>
 void RegionGrowing<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud) {
 	size_t number_of_points_in_input_cloud = input_cloud->size();
 
-	typename pcl::search::KdTree<PointT>::Ptr search_tree(new pcl::search::KdTree<PointT>());
-	search_tree->setInputCloud(input_cloud);
-	region_growing_->setSearchMethod(search_tree);
-	region_growing_->setInputCloud(input_cloud);
-	region_growing_->setInputNormals(input_cloud);
-
 	std::vector<pcl::PointIndices> cluster_indices;
-	region_growing_->extract(cluster_indices);
+	extractClusters(input_cloud, pcl::IndicesPtr(), cluster_indices);
 
 	std::vector<size_t> selected_clusters;
 	cluster_selector_.selectClusters(input_cloud, cluster_indices, selected_clusters);
@@ -109,6 +123,40 @@ void RegionGrowing<PointT>::filter(const typename pcl::PointCloud<PointT>::Ptr&
 	if (CloudFilter<PointT>::getCloudPublisher() && output_cloud) { CloudFilter<PointT>::getCloudPublisher()->publishPointCloud(*output_cloud); }
 	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter found " << cluster_indices.size() << " clusters and reduced point cloud from " << number_of_points_in_input_cloud << " points to " << output_cloud->size() << " points");
 }
+
+
+template<typename PointT>
+bool RegionGrowing<PointT>::filterIndices(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, pcl::IndicesPtr& output_indices) {
+	if (!use_voxel_hash_clustering_) { return false; }
+	size_t number_of_points_in_input_cloud = input_indices ? input_indices->size() : input_cloud->size();
+
+	std::vector<pcl::PointIndices> cluster_indices;
+	extractClusters(input_cloud, input_indices, cluster_indices);
+
+	std::vector<size_t> selected_clusters;
+	cluster_selector_.selectClusters(input_cloud, cluster_indices, selected_clusters);
+	output_indices.reset(new pcl::Indices());
+	pointcloud_utils::extractPointCloudClustersIndices(cluster_indices, selected_clusters, *output_indices);
+
+	CloudFilter<PointT>::publishFilteredCloud(input_cloud, output_indices);
+	ROS_DEBUG_STREAM(CloudFilter<PointT>::filter_name_ << " filter found " << cluster_indices.size() << " clusters and reduced point cloud indices from " << number_of_points_in_input_cloud << " points to " << output_indices->size() << " points");
+	return true;
+}
+
+
+template<typename PointT>
+void RegionGrowing<PointT>::extractClusters(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& input_indices, std::vector<pcl::PointIndices>& cluster_indices) {
+	if (use_voxel_hash_clustering_) {
+		voxel_hash_clustering_.extract(*input_cloud, input_indices, cluster_indices);
+	} else {
+		typename pcl::search::KdTree<PointT>::Ptr search_tree(new pcl::search::KdTree<PointT>());
+		search_tree->setInputCloud(input_cloud);
+		region_growing_->setSearchMethod(search_tree);
+		region_growing_->setInputCloud(input_cloud);
+		region_growing_->setInputNormals(input_cloud);
+		region_growing_->extract(cluster_indices);
+	}
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </RegionGrowing-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
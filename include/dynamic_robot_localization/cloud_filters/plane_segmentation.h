@@ -9,8 +9,10 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 // ROS includes
 #include <ros/ros.h>
@@ -21,9 +23,20 @@
 #include <pcl/ModelCoefficients.h>
 #include <pcl/PointIndices.h>
 #include <pcl/common/centroid.h>
+#include <pcl/common/io.h>
 #include <pcl/common/transforms.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/filters/project_inliers.h>
+#include <pcl/sample_consensus/sac.h>
+#include <pcl/sample_consensus/sac_model_plane.h>
+#include <pcl/sample_consensus/sac_model_normal_plane.h>
+#include <pcl/sample_consensus/ransac.h>
+#include <pcl/sample_consensus/lmeds.h>
+#include <pcl/sample_consensus/msac.h>
+#include <pcl/sample_consensus/rransac.h>
+#include <pcl/sample_consensus/rmsac.h>
+#include <pcl/sample_consensus/mlesac.h>
+#include <pcl/sample_consensus/prosac.h>
 #include <pcl/segmentation/sac_segmentation.h>
 #include <pcl/segmentation/extract_polygonal_prism_data.h>
 #include <pcl/surface/concave_hull.h>
@@ -52,17 +65,22 @@ class PlaneSegmentation : public CloudFilter<PointT> {
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-		PlaneSegmentation() : CloudFilter<PointT>("PlaneSegmentation") {}
+		PlaneSegmentation() : CloudFilter<PointT>("PlaneSegmentation"), remaining_indices_(new pcl::Indices()) {}
 		virtual ~PlaneSegmentation() {}
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PlaneSegmentation-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
 		virtual void filter(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, typename pcl::PointCloud<PointT>::Ptr& output_cloud);
+		virtual void setupSampleConsensus(const typename pcl::PointCloud<PointT>::Ptr& input_cloud);
+		virtual size_t segmentPlanes(const typename pcl::PointCloud<PointT>::Ptr& input_cloud);
+		virtual void segmentPointsOnTopOfPlane(const typename pcl::PointCloud<PointT>::Ptr& input_cloud, const pcl::IndicesPtr& plane_inliers, const pcl::ModelCoefficients::Ptr& plane_coefficients, std::vector<bool>& selected_points_mask);
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PlaneSegmentation-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-		inline pcl::ModelCoefficients::Ptr getPlaneCoefficients() { return plane_coefficients_; }
+		inline pcl::ModelCoefficients::Ptr getPlaneCoefficients() { return planes_coefficients_.empty() ? pcl::ModelCoefficients::Ptr(new pcl::ModelCoefficients()) : planes_coefficients_.front(); }
+		inline const std::vector<pcl::ModelCoefficients::Ptr>& getPlanesCoefficients() const { return planes_coefficients_; }
+		inline const std::vector<pcl::IndicesPtr>& getPlanesInliers() const { return planes_inliers_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -77,10 +95,21 @@ class PlaneSegmentation : public CloudFilter<PointT> {
 		double sample_consensus_normals_difference_weight_;
 		int sample_consensus_number_of_iterations_;
 		double sample_consensus_probability_of_sample_not_be_an_outlier_;
+		int sample_consensus_number_of_threads_;
+		bool sample_consensus_use_random_seed_;
+		int maximum_number_of_planes_;
+		int minimum_number_of_plane_inliers_;
+		bool remove_plane_inliers_;
 		double segmentation_minimum_distance_to_plane_;
 		double segmentation_maximum_distance_to_plane_;
 		double plane_convex_hull_scaling_factor_;
-		pcl::ModelCoefficients::Ptr plane_coefficients_;
+		typename pcl::SampleConsensusModel<PointT>::Ptr sample_consensus_model_;
+		typename pcl::SampleConsensusModelNormalPlane<PointT, PointT>::Ptr sample_consensus_model_normal_plane_;
+		typename pcl::SampleConsensus<PointT>::Ptr sample_consensus_;
+		pcl::IndicesPtr remaining_indices_;
+		std::vector<bool> plane_inliers_mask_;
+		std::vector<pcl::ModelCoefficients::Ptr> planes_coefficients_;
+		std::vector<pcl::IndicesPtr> planes_inliers_;
 		typename CloudPublisher<PointT>::Ptr plane_inliers_cloud_publisher_;
 		typename CloudPublisher<PointT>::Ptr plane_inliers_convex_hull_cloud_publisher_;
 	// ========================================================================   </protected-section>  ========================================================================
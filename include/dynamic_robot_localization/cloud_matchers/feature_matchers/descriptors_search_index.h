@@ -0,0 +1,133 @@
+#pragma once
+
+/**\file descriptors_search_index.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROS includes
+#include <ros/ros.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/point_representation.h>
+#include <pcl/kdtree/kdtree.h>
+
+// external libs includes
+#include <flann/flann.hpp>
+
+// project includes
+#include <dynamic_robot_localization/common/configurable_object.h>
+#include <dynamic_robot_localization/common/pointcloud_conversions.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// #######################################################################   descriptors_search_index   ########################################################################
+/**
+ * \brief Nearest neighbor search in descriptor space (replacement of pcl::KdTreeFLANN for the feature matchers).
+ * Besides the exact single kd-tree search, it allows approximate indexes (randomized kd-trees, hierarchical k-means, hierarchical clustering or FLANN autotuned),
+ * whose recall / speed ratio is controlled by the number of leafs checked in each query.
+ * The index can be saved to a file and loaded later on (together with the reference descriptors used to build it).
+ * FLANN only checks the number and dimensions of the descriptors when loading an index, so a signature file with the hash of the indexed descriptors is saved next to the index (filepath + ".signature").
+ */
+template <typename FeatureT>
+class DescriptorsSearchIndex : public pcl::KdTree<FeatureT>, public ConfigurableObject {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< DescriptorsSearchIndex<FeatureT> >;
+		using ConstPtr = std::shared_ptr< const DescriptorsSearchIndex<FeatureT> >;
+		using PointCloudConstPtr = typename pcl::KdTree<FeatureT>::PointCloudConstPtr;
+		using IndicesConstPtr = typename pcl::KdTree<FeatureT>::IndicesConstPtr;
+		using FLANNIndex = flann::Index< flann::L2<float> >;
+		using pcl::KdTree<FeatureT>::nearestKSearch;
+		using pcl::KdTree<FeatureT>::radiusSearch;
+
+		enum IndexType {
+			KDTREE_SINGLE,
+			RANDOMIZED_KDTREES,
+			HIERARCHICAL_KMEANS,
+			HIERARCHICAL_CLUSTERING,
+			AUTOTUNED,
+			LINEAR
+		};
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		DescriptorsSearchIndex();
+		virtual ~DescriptorsSearchIndex() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <DescriptorsSearchIndex-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		static bool parseIndexType(const std::string& index_type_name, IndexType& index_type_out);
+
+		/// Builds the index with the valid descriptors of the cloud (descriptors with non finite values are skipped)
+		virtual void setInputCloud(const PointCloudConstPtr& cloud, const IndicesConstPtr& indices = IndicesConstPtr());
+		/// Same as setInputCloud, but the index is loaded from a file saved previously with the same descriptors (falls back to building the index if the signature file is missing or was computed from other descriptors)
+		bool loadIndex(const PointCloudConstPtr& cloud, const std::string& filepath);
+		/// Saves the index and the signature of the indexed descriptors (in filepath + ".signature")
+		bool saveIndex(const std::string& filepath) const;
+
+		virtual int nearestKSearch(const FeatureT& point, unsigned int k, pcl::Indices& k_indices, std::vector<float>& k_sqr_distances) const;
+		virtual int radiusSearch(const FeatureT& point, double radius, pcl::Indices& k_indices, std::vector<float>& k_sqr_distances, unsigned int max_nn = 0) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </DescriptorsSearchIndex-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		IndexType getIndexType() const { return index_type_; }
+		size_t getNumberOfIndexedDescriptors() const { return index_mapping_.size(); }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		void setIndexType(IndexType index_type) { index_type_ = index_type; }
+		/// Number of leafs checked in each query of the approximate indexes (higher values increase recall and search time) | <= 0 -> unlimited (exact search)
+		void setSearchChecks(int search_checks) { search_checks_ = search_checks; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		virtual std::string getName() const { return "DescriptorsSearchIndex"; }
+		flann::IndexParams createIndexParams() const;
+		void convertDescriptorsToFLANNMatrix(const PointCloudConstPtr& cloud, const IndicesConstPtr& indices);
+		bool convertDescriptorToQuery(const FeatureT& point, std::vector<float>& query) const;
+		std::uint64_t computeDescriptorsSignature() const;
+		static std::string getSignatureFilePath(const std::string& index_filepath) { return index_filepath + ".signature"; }
+		flann::SearchParams createSearchParams() const;
+
+		IndexType index_type_;
+		int search_checks_;
+		float search_epsilon_;
+		int kdtree_single_leaf_max_size_;
+		int number_of_randomized_kdtrees_;
+		int kmeans_branching_;
+		int kmeans_iterations_;
+		int hierarchical_clustering_branching_;
+		int hierarchical_clustering_number_of_trees_;
+		int hierarchical_clustering_leaf_max_size_;
+		float autotuned_target_precision_;
+		int number_of_dimensions_;
+		std::vector<float> descriptors_data_;
+		std::vector<int> index_mapping_;
+		std::shared_ptr<FLANNIndex> flann_index_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_matchers/feature_matchers/impl/descriptors_search_index.hpp>
+#endif
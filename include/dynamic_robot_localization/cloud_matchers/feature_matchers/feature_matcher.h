@@ -22,6 +22,7 @@
 // project includes
 #include <dynamic_robot_localization/common/pointcloud_conversions.h>
 #include <dynamic_robot_localization/cloud_matchers/cloud_matcher.h>
+#include <dynamic_robot_localization/cloud_matchers/feature_matchers/descriptors_search_index.h>
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/keypoint_descriptors/keypoint_descriptor.h>
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/keypoint_descriptors/fpfh.h>
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/keypoint_descriptors/shot.h>
@@ -61,6 +62,7 @@ class FeatureMatcher : public CloudMatcher<PointT> {
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		const typename KeypointDescriptor<PointT, FeatureT>::Ptr getKeypointDescriptor() { return keypoint_descriptor_; }
+		const typename DescriptorsSearchIndex<FeatureT>::Ptr getDescriptorsSearchIndex() { return descriptors_search_index_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -70,10 +72,18 @@ class FeatureMatcher : public CloudMatcher<PointT> {
 
 	// ========================================================================   <protected-section>   ========================================================================
 	protected:
+		/// Signature of the keypoints, surface and descriptor configuration that must match the ones stored in descriptors cache files (.drld)
+		pointcloud_conversions::DescriptorsCacheSignature computeReferenceDescriptorsCacheSignature(const typename pcl::PointCloud<PointT>& reference_cloud_keypoints, const typename pcl::PointCloud<PointT>& reference_cloud);
+		/// Builds (or loads from file) the search index of the reference descriptors, that will be given to the matcher in setMatcherReferenceDescriptors
+		void setupReferenceDescriptorsSearchIndex(typename pcl::PointCloud<FeatureT>::Ptr& reference_descriptors, bool reference_descriptors_loaded_from_file);
+
 		typename KeypointDescriptor<PointT, FeatureT>::Ptr keypoint_descriptor_;
+		typename DescriptorsSearchIndex<FeatureT>::Ptr descriptors_search_index_;
 		std::string reference_pointclouds_database_folder_path_;
 		std::string reference_pointcloud_descriptors_filename_;
 		std::string reference_pointcloud_descriptors_save_filename_;
+		std::string reference_pointcloud_descriptors_search_index_filename_;
+		std::string reference_pointcloud_descriptors_search_index_save_filename_;
 		bool save_descriptors_in_binary_format_;
 	// ========================================================================   </protected-section>  ========================================================================
 };
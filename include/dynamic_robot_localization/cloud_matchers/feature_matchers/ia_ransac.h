@@ -133,7 +133,7 @@ namespace dynamic_robot_localization
           float threshold_;
       };
 
-      using FeatureKdTreePtr = typename pcl::KdTreeFLANN<FeatureT>::Ptr;
+      using FeatureKdTreePtr = typename pcl::KdTree<FeatureT>::Ptr;
       /** \brief Constructor. */
       SampleConsensusInitialAlignmentRegistration () :
         input_features_ (), target_features_ (), 
@@ -171,6 +171,13 @@ namespace dynamic_robot_localization
       inline FeatureCloudConstPtr const 
       getTargetFeatures () { return (target_features_); }
 
+      /** \brief Provide the search method used to find the correspondences between the source and target features
+        * (if it was already built with the target features, setTargetFeatures will not rebuild it)
+        * \param feature_tree the search method in the features space
+        */
+      void
+      setFeatureSearchMethod (const FeatureKdTreePtr &feature_tree) { if (feature_tree) feature_tree_ = feature_tree; }
+
       /** \brief Set the minimum distances between samples
         * \param min_sample_distance the minimum distances between samples
         */
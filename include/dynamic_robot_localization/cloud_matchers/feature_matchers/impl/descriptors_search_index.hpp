@@ -0,0 +1,279 @@
+/**\file descriptors_search_index.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_matchers/feature_matchers/descriptors_search_index.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename FeatureT>
+DescriptorsSearchIndex<FeatureT>::DescriptorsSearchIndex() :
+		pcl::KdTree<FeatureT>(true),
+		index_type_(KDTREE_SINGLE),
+		search_checks_(256),
+		search_epsilon_(0.0f),
+		kdtree_single_leaf_max_size_(15),
+		number_of_randomized_kdtrees_(4),
+		kmeans_branching_(32),
+		kmeans_iterations_(11),
+		hierarchical_clustering_branching_(32),
+		hierarchical_clustering_number_of_trees_(4),
+		hierarchical_clustering_leaf_max_size_(100),
+		autotuned_target_precision_(0.9f),
+		number_of_dimensions_(0) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <DescriptorsSearchIndex-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename FeatureT>
+void DescriptorsSearchIndex<FeatureT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	std::string final_param_name;
+	std::string search_namespace = private_node_handle->getNamespace() + "/" + configuration_namespace;
+
+	std::string index_type_name = "kdtree_single";
+	if (ros::param::search(search_namespace, "descriptors_search_index/index_type", final_param_name)) { private_node_handle->param(final_param_name, index_type_name, std::string("kdtree_single")); }
+	if (!parseIndexType(index_type_name, index_type_)) {
+		ROS_WARN_STREAM("Unknown descriptors search index type [" << index_type_name << "] -> using kdtree_single (exact search)");
+		index_type_ = KDTREE_SINGLE;
+	}
+
+	double search_epsilon = search_epsilon_, autotuned_target_precision = autotuned_target_precision_;
+	if (ros::param::search(search_namespace, "descriptors_search_index/search_checks", final_param_name)) { private_node_handle->param(final_param_name, search_checks_, 256); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/search_epsilon", final_param_name)) { private_node_handle->param(final_param_name, search_epsilon, 0.0); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/kdtree_single_leaf_max_size", final_param_name)) { private_node_handle->param(final_param_name, kdtree_single_leaf_max_size_, 15); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/number_of_randomized_kdtrees", final_param_name)) { private_node_handle->param(final_param_name, number_of_randomized_kdtrees_, 4); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/kmeans_branching", final_param_name)) { private_node_handle->param(final_param_name, kmeans_branching_, 32); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/kmeans_iterations", final_param_name)) { private_node_handle->param(final_param_name, kmeans_iterations_, 11); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/hierarchical_clustering_branching", final_param_name)) { private_node_handle->param(final_param_name, hierarchical_clustering_branching_, 32); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/hierarchical_clustering_number_of_trees", final_param_name)) { private_node_handle->param(final_param_name, hierarchical_clustering_number_of_trees_, 4); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/hierarchical_clustering_leaf_max_size", final_param_name)) { private_node_handle->param(final_param_name, hierarchical_clustering_leaf_max_size_, 100); }
+	if (ros::param::search(search_namespace, "descriptors_search_index/autotuned_target_precision", final_param_name)) { private_node_handle->param(final_param_name, autotuned_target_precision, 0.9); }
+	search_epsilon_ = (float)search_epsilon;
+	autotuned_target_precision_ = (float)autotuned_target_precision;
+}
+
+
+template<typename FeatureT>
+bool DescriptorsSearchIndex<FeatureT>::parseIndexType(const std::string& index_type_name, IndexType& index_type_out) {
+	if (index_type_name == "kdtree_single") { index_type_out = KDTREE_SINGLE; }
+	else if (index_type_name == "randomized_kdtrees") { index_type_out = RANDOMIZED_KDTREES; }
+	else if (index_type_name == "hierarchical_kmeans") { index_type_out = HIERARCHICAL_KMEANS; }
+	else if (index_type_name == "hierarchical_clustering") { index_type_out = HIERARCHICAL_CLUSTERING; }
+	else if (index_type_name == "autotuned") { index_type_out = AUTOTUNED; }
+	else if (index_type_name == "linear") { index_type_out = LINEAR; }
+	else { return false; }
+	return true;
+}
+
+
+template<typename FeatureT>
+void DescriptorsSearchIndex<FeatureT>::setInputCloud(const PointCloudConstPtr& cloud, const IndicesConstPtr& indices) {
+	pcl::KdTree<FeatureT>::setInputCloud(cloud, indices);
+	convertDescriptorsToFLANNMatrix(cloud, indices);
+	flann_index_.reset();
+	if (index_mapping_.empty()) { return; }
+
+	flann_index_.reset(new FLANNIndex(flann::Matrix<float>(&descriptors_data_[0], index_mapping_.size(), number_of_dimensions_), createIndexParams()));
+	flann_index_->buildIndex();
+	ROS_DEBUG_STREAM("Built descriptors search index with " << index_mapping_.size() << " descriptors of " << number_of_dimensions_ << " dimensions");
+}
+
+
+template<typename FeatureT>
+bool DescriptorsSearchIndex<FeatureT>::loadIndex(const PointCloudConstPtr& cloud, const std::string& filepath) {
+	std::ifstream index_file(filepath.c_str(), std::ios::binary);
+	if (!index_file.good()) {
+		setInputCloud(cloud);
+		return false;
+	}
+	index_file.close();
+
+	pcl::KdTree<FeatureT>::setInputCloud(cloud, IndicesConstPtr());
+	convertDescriptorsToFLANNMatrix(cloud, IndicesConstPtr());
+	flann_index_.reset();
+	if (index_mapping_.empty()) { return false; }
+
+	std::ifstream signature_file(getSignatureFilePath(filepath).c_str());
+	size_t saved_number_of_descriptors = 0;
+	int saved_number_of_dimensions = 0;
+	std::uint64_t saved_descriptors_signature = 0;
+	if (!(signature_file >> saved_number_of_descriptors >> saved_number_of_dimensions >> saved_descriptors_signature)
+			|| saved_number_of_descriptors != index_mapping_.size() || saved_number_of_dimensions != number_of_dimensions_ || saved_descriptors_signature != computeDescriptorsSignature()) {
+		ROS_WARN_STREAM("Descriptors search index in file " << filepath << " was not saved with the reference descriptors (missing or different signature file) -> rebuilding index");
+		setInputCloud(cloud);
+		return false;
+	}
+
+	try {
+		flann_index_.reset(new FLANNIndex(flann::Matrix<float>(&descriptors_data_[0], index_mapping_.size(), number_of_dimensions_), flann::SavedIndexParams(filepath)));
+		flann_index_->buildIndex();
+	} catch (flann::FLANNException& e) {
+		ROS_WARN_STREAM("Descriptors search index in file " << filepath << " does not match the reference descriptors (" << e.what() << ") -> rebuilding index");
+		setInputCloud(cloud);
+		return false;
+	}
+
+	ROS_INFO_STREAM("Loaded descriptors search index with " << index_mapping_.size() << " descriptors from file " << filepath);
+	return true;
+}
+
+
+template<typename FeatureT>
+bool DescriptorsSearchIndex<FeatureT>::saveIndex(const std::string& filepath) const {
+	if (!flann_index_) { return false; }
+	try {
+		flann_index_->save(filepath);
+	} catch (flann::FLANNException& e) {
+		ROS_WARN_STREAM("Failed to save descriptors search index to file " << filepath << " (" << e.what() << ")");
+		return false;
+	}
+
+	std::ofstream signature_file(getSignatureFilePath(filepath).c_str());
+	signature_file << index_mapping_.size() << " " << number_of_dimensions_ << " " << computeDescriptorsSignature() << std::endl;
+	if (!signature_file.good()) {
+		ROS_WARN_STREAM("Failed to save descriptors search index signature to file " << getSignatureFilePath(filepath));
+		return false;
+	}
+	return true;
+}
+
+
+template<typename FeatureT>
+int DescriptorsSearchIndex<FeatureT>::nearestKSearch(const FeatureT& point, unsigned int k, pcl::Indices& k_indices, std::vector<float>& k_sqr_distances) const {
+	std::vector<float> query;
+	k = std::min(k, (unsigned int)index_mapping_.size());
+	if (!flann_index_ || k == 0 || !convertDescriptorToQuery(point, query)) {
+		k_indices.clear();
+		k_sqr_distances.clear();
+		return 0;
+	}
+
+	k_indices.resize(k);
+	k_sqr_distances.resize(k);
+	flann::Matrix<float> query_matrix(&query[0], 1, number_of_dimensions_);
+	flann::Matrix<int> indices_matrix(&k_indices[0], 1, k);
+	flann::Matrix<float> distances_matrix(&k_sqr_distances[0], 1, k);
+	flann_index_->knnSearch(query_matrix, indices_matrix, distances_matrix, k, createSearchParams());
+
+	// approximate indexes may return less than k neighbors (remaining entries have negative indices)
+	size_t number_of_neighbors = 0;
+	for (size_t i = 0; i < k_indices.size(); ++i) {
+		if (k_indices[i] >= 0 && k_indices[i] < (int)index_mapping_.size()) {
+			k_indices[number_of_neighbors] = index_mapping_[k_indices[i]];
+			k_sqr_distances[number_of_neighbors] = k_sqr_distances[i];
+			++number_of_neighbors;
+		}
+	}
+	k_indices.resize(number_of_neighbors);
+	k_sqr_distances.resize(number_of_neighbors);
+	return (int)number_of_neighbors;
+}
+
+
+template<typename FeatureT>
+int DescriptorsSearchIndex<FeatureT>::radiusSearch(const FeatureT& point, double radius, pcl::Indices& k_indices, std::vector<float>& k_sqr_distances, unsigned int max_nn) const {
+	std::vector<float> query;
+	k_indices.clear();
+	k_sqr_distances.clear();
+	if (!flann_index_ || !convertDescriptorToQuery(point, query)) { return 0; }
+
+	flann::SearchParams search_params = createSearchParams();
+	search_params.max_neighbors = (max_nn > 0 && max_nn < index_mapping_.size()) ? (int)max_nn : -1;
+	std::vector< std::vector<int> > indices(1);
+	std::vector< std::vector<float> > sqr_distances(1);
+	flann::Matrix<float> query_matrix(&query[0], 1, number_of_dimensions_);
+	flann_index_->radiusSearch(query_matrix, indices, sqr_distances, (float)(radius * radius), search_params);
+
+	k_indices.reserve(indices[0].size());
+	k_sqr_distances.reserve(indices[0].size());
+	for (size_t i = 0; i < indices[0].size(); ++i) {
+		if (indices[0][i] >= 0 && indices[0][i] < (int)index_mapping_.size()) {
+			k_indices.push_back(index_mapping_[indices[0][i]]);
+			k_sqr_distances.push_back(sqr_distances[0][i]);
+		}
+	}
+	return (int)k_indices.size();
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </DescriptorsSearchIndex-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename FeatureT>
+flann::IndexParams DescriptorsSearchIndex<FeatureT>::createIndexParams() const {
+	switch (index_type_) {
+		case RANDOMIZED_KDTREES:
+			return flann::KDTreeIndexParams(std::max(number_of_randomized_kdtrees_, 1));
+		case HIERARCHICAL_KMEANS:
+			return flann::KMeansIndexParams(std::max(kmeans_branching_, 2), kmeans_iterations_, flann::FLANN_CENTERS_RANDOM, 0.2f);
+		case HIERARCHICAL_CLUSTERING:
+			return flann::HierarchicalClusteringIndexParams(std::max(hierarchical_clustering_branching_, 2), flann::FLANN_CENTERS_RANDOM,
+					std::max(hierarchical_clustering_number_of_trees_, 1), std::max(hierarchical_clustering_leaf_max_size_, 1));
+		case AUTOTUNED:
+			return flann::AutotunedIndexParams(autotuned_target_precision_, 0.01f, 0.0f, 0.1f);
+		case LINEAR:
+			return flann::LinearIndexParams();
+		default:
+			return flann::KDTreeSingleIndexParams(std::max(kdtree_single_leaf_max_size_, 1));
+	}
+}
+
+
+template<typename FeatureT>
+void DescriptorsSearchIndex<FeatureT>::convertDescriptorsToFLANNMatrix(const PointCloudConstPtr& cloud, const IndicesConstPtr& indices) {
+	descriptors_data_.clear();
+	index_mapping_.clear();
+	number_of_dimensions_ = pcl::KdTree<FeatureT>::point_representation_->getNumberOfDimensions();
+	if (!cloud || number_of_dimensions_ <= 0) { return; }
+
+	size_t number_of_descriptors = indices ? indices->size() : cloud->size();
+	descriptors_data_.resize(number_of_descriptors * number_of_dimensions_);
+	index_mapping_.reserve(number_of_descriptors);
+	for (size_t i = 0; i < number_of_descriptors; ++i) {
+		int descriptor_index = indices ? (*indices)[i] : (int)i;
+		const FeatureT& descriptor = (*cloud)[descriptor_index];
+		if (!pcl::KdTree<FeatureT>::point_representation_->isValid(descriptor)) { continue; }
+		pcl::KdTree<FeatureT>::point_representation_->copyToFloatArray(descriptor, &descriptors_data_[index_mapping_.size() * number_of_dimensions_]);
+		index_mapping_.push_back(descriptor_index);
+	}
+	descriptors_data_.resize(index_mapping_.size() * number_of_dimensions_);
+}
+
+
+template<typename FeatureT>
+bool DescriptorsSearchIndex<FeatureT>::convertDescriptorToQuery(const FeatureT& point, std::vector<float>& query) const {
+	if (number_of_dimensions_ <= 0 || !pcl::KdTree<FeatureT>::point_representation_->isValid(point)) { return false; }
+	query.resize(number_of_dimensions_);
+	pcl::KdTree<FeatureT>::point_representation_->copyToFloatArray(point, &query[0]);
+	return true;
+}
+
+
+template<typename FeatureT>
+std::uint64_t DescriptorsSearchIndex<FeatureT>::computeDescriptorsSignature() const {
+	std::uint64_t signature = pointcloud_conversions::computeHash(descriptors_data_.data(), descriptors_data_.size() * sizeof(float));
+	return pointcloud_conversions::computeHash(index_mapping_.data(), index_mapping_.size() * sizeof(int), signature);
+}
+
+
+template<typename FeatureT>
+flann::SearchParams DescriptorsSearchIndex<FeatureT>::createSearchParams() const {
+	int checks = search_checks_;
+	if (checks <= 0) { checks = (index_type_ == AUTOTUNED) ? flann::FLANN_CHECKS_AUTOTUNED : flann::FLANN_CHECKS_UNLIMITED; }
+	flann::SearchParams search_params(checks, search_epsilon_, pcl::KdTree<FeatureT>::sorted_);
+	return search_params;
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
@@ -29,6 +29,11 @@ void FeatureMatcher<PointT, FeatureT>::setupConfigurationFromParameterServer(ros
 	if (ros::param::search(search_namespace, "reference_pointcloud_descriptors_filename", final_param_name)) { private_node_handle->param(final_param_name, reference_pointcloud_descriptors_filename_, std::string("")); }
 	if (ros::param::search(search_namespace, "reference_pointcloud_descriptors_save_filename", final_param_name)) { private_node_handle->param(final_param_name, reference_pointcloud_descriptors_save_filename_, std::string("")); }
 	if (ros::param::search(search_namespace, "save_descriptors_in_binary_format", final_param_name)) { private_node_handle->param(final_param_name, save_descriptors_in_binary_format_, true); }
+	if (ros::param::search(search_namespace, "reference_pointcloud_descriptors_search_index_filename", final_param_name)) { private_node_handle->param(final_param_name, reference_pointcloud_descriptors_search_index_filename_, std::string("")); }
+	if (ros::param::search(search_namespace, "reference_pointcloud_descriptors_search_index_save_filename", final_param_name)) { private_node_handle->param(final_param_name, reference_pointcloud_descriptors_search_index_save_filename_, std::string("")); }
+
+	descriptors_search_index_.reset(new DescriptorsSearchIndex<FeatureT>());
+	descriptors_search_index_->setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 
 	CloudMatcher<PointT>::setDisplayCloudAligment(display_feature_matching);
 
@@ -60,18 +65,32 @@ void FeatureMatcher<PointT, FeatureT>::setupReferenceCloud(typename pcl::PointCl
 	}
 
 	typename pcl::PointCloud<FeatureT>::Ptr reference_descriptors(new pcl::PointCloud<FeatureT>());
-	if (reference_pointcloud_descriptors_filename_.empty() || !pointcloud_conversions::fromFile(*reference_descriptors, reference_pointcloud_descriptors_filename_, reference_pointclouds_database_folder_path_)) {
+	bool reference_descriptors_loaded_from_file = false;
+	pointcloud_conversions::DescriptorsCacheSignature descriptors_cache_signature = computeReferenceDescriptorsCacheSignature(*reference_cloud_final, *reference_cloud);
+	bool use_descriptors_cache_file = pointcloud_utils::getFileExtension(reference_pointcloud_descriptors_filename_) == pointcloud_conversions::DESCRIPTORS_CACHE_FILE_EXTENSION;
+	bool reference_descriptors_loaded = use_descriptors_cache_file ?
+			pointcloud_conversions::fromDescriptorsCacheFile(*reference_descriptors, pointcloud_utils::parseFilePath(reference_pointcloud_descriptors_filename_, reference_pointclouds_database_folder_path_), descriptors_cache_signature) :
+			(!reference_pointcloud_descriptors_filename_.empty() && pointcloud_conversions::fromFile(*reference_descriptors, reference_pointcloud_descriptors_filename_, reference_pointclouds_database_folder_path_));
+
+	if (!reference_descriptors_loaded) {
 		if (keypoint_descriptor_) // must be set previously
 			reference_descriptors = keypoint_descriptor_->computeKeypointsDescriptors(reference_cloud_final, reference_cloud, search_method);
 	} else {
+		reference_descriptors_loaded_from_file = true;
 		ROS_INFO_STREAM("Loaded " << reference_descriptors->size() << " keypoint descriptors from file " << reference_pointcloud_descriptors_filename_);
 	}
 
 	if (!reference_pointcloud_descriptors_save_filename_.empty() && !reference_descriptors->empty()) {
-		ROS_INFO_STREAM("Saving " << reference_descriptors->size() << " reference pointcloud keypoint descriptors to file " << reference_pointcloud_descriptors_save_filename_);
-		pcl::io::savePCDFile<FeatureT>(reference_pointcloud_descriptors_save_filename_, *reference_descriptors, save_descriptors_in_binary_format_);
+		std::string descriptors_save_filepath = pointcloud_utils::parseFilePath(reference_pointcloud_descriptors_save_filename_, reference_pointclouds_database_folder_path_);
+		ROS_INFO_STREAM("Saving " << reference_descriptors->size() << " reference pointcloud keypoint descriptors to file " << descriptors_save_filepath);
+		if (pointcloud_utils::getFileExtension(descriptors_save_filepath) == pointcloud_conversions::DESCRIPTORS_CACHE_FILE_EXTENSION) {
+			pointcloud_conversions::toDescriptorsCacheFile(descriptors_save_filepath, *reference_descriptors, descriptors_cache_signature);
+		} else {
+			pcl::io::savePCDFile<FeatureT>(descriptors_save_filepath, *reference_descriptors, save_descriptors_in_binary_format_);
+		}
 	}
 
+	setupReferenceDescriptorsSearchIndex(reference_descriptors, reference_descriptors_loaded_from_file);
 	setMatcherReferenceDescriptors(reference_descriptors);
 }
 
@@ -95,6 +114,36 @@ void FeatureMatcher<PointT, FeatureT>::processKeypoints(typename pcl::PointCloud
 // =============================================================================  </public-section>  ===========================================================================
 
 // =============================================================================   <protected-section>   =======================================================================
+template<typename PointT, typename FeatureT>
+pointcloud_conversions::DescriptorsCacheSignature FeatureMatcher<PointT, FeatureT>::computeReferenceDescriptorsCacheSignature(const typename pcl::PointCloud<PointT>& reference_cloud_keypoints, const typename pcl::PointCloud<PointT>& reference_cloud) {
+	pointcloud_conversions::DescriptorsCacheSignature signature;
+	signature.number_of_keypoints = reference_cloud_keypoints.size();
+	signature.keypoints_signature = pointcloud_conversions::computePointCloudSignature(reference_cloud_keypoints);
+	signature.number_of_surface_points = reference_cloud.size();
+	std::string configuration_description = keypoint_descriptor_ ? keypoint_descriptor_->getConfigurationDescription() : std::string("");
+	signature.configuration_signature = pointcloud_conversions::computeHash(configuration_description.data(), configuration_description.size());
+	return signature;
+}
+
+
+template<typename PointT, typename FeatureT>
+void FeatureMatcher<PointT, FeatureT>::setupReferenceDescriptorsSearchIndex(typename pcl::PointCloud<FeatureT>::Ptr& reference_descriptors, bool reference_descriptors_loaded_from_file) {
+	if (!descriptors_search_index_ || reference_descriptors->empty()) { return; }
+
+	// a saved index is only valid for the descriptors that were used to build it
+	std::string search_index_filepath = pointcloud_utils::parseFilePath(reference_pointcloud_descriptors_search_index_filename_, reference_pointclouds_database_folder_path_);
+	if (reference_descriptors_loaded_from_file && !search_index_filepath.empty()) {
+		descriptors_search_index_->loadIndex(reference_descriptors, search_index_filepath);
+	} else {
+		descriptors_search_index_->setInputCloud(reference_descriptors);
+	}
+
+	std::string search_index_save_filepath = pointcloud_utils::parseFilePath(reference_pointcloud_descriptors_search_index_save_filename_, reference_pointclouds_database_folder_path_);
+	if (!search_index_save_filepath.empty()) {
+		ROS_INFO_STREAM("Saving reference pointcloud descriptors search index to file " << search_index_save_filepath);
+		descriptors_search_index_->saveIndex(search_index_save_filepath);
+	}
+}
 // =============================================================================   </protected-section>  =======================================================================
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
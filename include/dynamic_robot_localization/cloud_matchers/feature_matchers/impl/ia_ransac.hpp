@@ -66,7 +66,8 @@ dynamic_robot_localization::SampleConsensusInitialAlignmentRegistration<PointT,
     return;
   }
   target_features_ = features;
-  feature_tree_->setInputCloud (target_features_);
+  if (feature_tree_->getInputCloud () != target_features_)
+    feature_tree_->setInputCloud (target_features_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,7 @@ void SampleConsensusInitialAlignment<PointT, FeatureT>::setupConfigurationFromPa
 
 template<typename PointT, typename FeatureT>
 void SampleConsensusInitialAlignment<PointT, FeatureT>::setMatcherReferenceDescriptors(typename pcl::PointCloud<FeatureT>::Ptr& reference_descriptors) {
+	matcher_scia_->setFeatureSearchMethod(FeatureMatcher<PointT, FeatureT>::getDescriptorsSearchIndex());
 	matcher_scia_->setTargetFeatures(reference_descriptors);
 }
 
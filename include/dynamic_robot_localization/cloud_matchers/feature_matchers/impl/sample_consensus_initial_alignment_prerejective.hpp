@@ -58,12 +58,54 @@ void SampleConsensusInitialAlignmentPrerejective<PointT, FeatureT>::setupConfigu
 	private_node_handle->param(configuration_namespace + "correspondence_randomness", correspondence_randomness, 3);
 	matcher_scia_->setCorrespondenceRandomness(correspondence_randomness);
 
+	double sample_consensus_rejector_inlier_threshold;
+	private_node_handle->param(configuration_namespace + "sample_consensus_rejector_inlier_threshold", sample_consensus_rejector_inlier_threshold, 0.25);
+	matcher_scia_->setSampleConsensusRejectorInlierThreshold(sample_consensus_rejector_inlier_threshold);
+
+	int sample_consensus_rejector_maximum_iterations;
+	private_node_handle->param(configuration_namespace + "sample_consensus_rejector_maximum_iterations", sample_consensus_rejector_maximum_iterations, 0);
+	matcher_scia_->setSampleConsensusRejectorMaximumIterations(sample_consensus_rejector_maximum_iterations);
+
+	std::string correspondences_grouping_method;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/method", correspondences_grouping_method, std::string(""));
+	if (correspondences_grouping_method == "geometric_consistency") {
+		matcher_scia_->setCorrespondencesGrouping(SampleConsensusPrerejective<PointT, PointT, FeatureT>::GEOMETRIC_CONSISTENCY);
+	} else if (correspondences_grouping_method == "hough_3d") {
+		matcher_scia_->setCorrespondencesGrouping(SampleConsensusPrerejective<PointT, PointT, FeatureT>::HOUGH_3D);
+	} else {
+		if (!correspondences_grouping_method.empty()) {
+			ROS_WARN_STREAM("Unknown correspondences grouping method [" << correspondences_grouping_method << "] -> using random sampling of correspondences");
+		}
+		matcher_scia_->setCorrespondencesGrouping(SampleConsensusPrerejective<PointT, PointT, FeatureT>::NO_GROUPING);
+	}
+
+	double grouping_maximum_descriptor_distance;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/maximum_descriptor_distance", grouping_maximum_descriptor_distance, 0.5);
+	matcher_scia_->setGroupingMaximumDescriptorDistance(grouping_maximum_descriptor_distance);
+
+	double grouping_consensus_set_resolution;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/consensus_set_resolution", grouping_consensus_set_resolution, 0.05);
+	matcher_scia_->setGroupingConsensusSetResolution(grouping_consensus_set_resolution);
+
+	int grouping_consensus_set_minimum_size;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/consensus_set_minimum_size", grouping_consensus_set_minimum_size, 5);
+	matcher_scia_->setGroupingConsensusSetMinimumSize(grouping_consensus_set_minimum_size);
+
+	double grouping_reference_frames_radius;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/reference_frames_radius", grouping_reference_frames_radius, 0.25);
+	matcher_scia_->setGroupingReferenceFramesRadius(grouping_reference_frames_radius);
+
+	int grouping_refinement_iterations;
+	private_node_handle->param(configuration_namespace + "correspondences_grouping/refinement_iterations", grouping_refinement_iterations, 3);
+	matcher_scia_->setGroupingRefinementIterations(grouping_refinement_iterations);
+
 	FeatureMatcher<PointT, FeatureT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 }
 
 
 template<typename PointT, typename FeatureT>
 void SampleConsensusInitialAlignmentPrerejective<PointT, FeatureT>::setMatcherReferenceDescriptors(typename pcl::PointCloud<FeatureT>::Ptr& reference_descriptors) {
+	matcher_scia_->setFeatureSearchMethod(FeatureMatcher<PointT, FeatureT>::getDescriptorsSearchIndex());
 	matcher_scia_->setTargetFeatures(reference_descriptors);
 }
 
@@ -63,7 +63,9 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 		return;
 	}
 	target_features_ = features;
-	feature_tree_->setInputCloud(target_features_);
+	if (feature_tree_->getInputCloud() != target_features_) {
+		feature_tree_->setInputCloud(target_features_);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -184,12 +186,6 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 
 	convergence_timer_.reset();
 
-	// Initialize prerejector (similarity threshold already set to default value in constructor)
-	/*correspondence_rejector_poly_->setInputSource(input_);
-	correspondence_rejector_poly_->setInputTarget(target_);
-	correspondence_rejector_poly_->setCardinality(nr_samples_);*/
-	pcl::Registration<PointSource, PointTarget>::clearCorrespondenceRejectors();
-	setupCorrespondanceRejectors(correspondence_rejectors_);
 	//int num_rejections = 0; // For debugging
 
 	// Initialize results
@@ -226,149 +222,32 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 	}
 
 
-#ifdef USE_GROUPING
-	//
-	//  Find Model-Scene Correspondences with KdTree
-	//
-	pcl::CorrespondencesPtr model_scene_corrs (new pcl::Correspondences ());
-
-	//  For each scene keypoint descriptor, find nearest neighbor into the model keypoints descriptor cloud and add it to the correspondences vector.
-	for (size_t i = 0; i < input_features_->size (); ++i)
-	{
-		std::vector<int> neigh_indices (1);
-		std::vector<float> neigh_sqr_dists (1);
-		if (!pcl::isFinite(input_features_->at(i))) { continue; }
-		if (!pcl::isFinite(input_->at(i)) || !pcl::isFinite(target_->at(i))) { continue; }
-
-		int found_neighs = feature_tree_->nearestKSearch (input_features_->at(i), 1, neigh_indices, neigh_sqr_dists);
-		if(found_neighs == 1 && neigh_sqr_dists[0] < 0.25f) { //  add match only if the squared descriptor distance is less than 0.25 (SHOT descriptor distances are between 0 and 1 by design)
-			pcl::Correspondence corr(neigh_indices[0], static_cast<int> (i), neigh_sqr_dists[0]);
-			model_scene_corrs->push_back (corr);
-		}
-	}
-	std::cout << "Correspondences found: " << model_scene_corrs->size () << std::endl;
-
-
-	//
-	// filter outliers
-	//
-	pcl::CorrespondencesPtr filtered_corrs(new pcl::Correspondences());
-	for (size_t i = 0; i < correspondence_rejectors_.size(); ++i) {
-		filtered_corrs = pcl::CorrespondencesPtr(new pcl::Correspondences());
-		correspondence_rejectors_[i]->getRemainingCorrespondences(*model_scene_corrs, *filtered_corrs);
-		if (filtered_corrs->size() < 3) break;
-		model_scene_corrs = filtered_corrs;
-	}
-	model_scene_corrs = filtered_corrs;
-
-	//
-	//  Actual Clustering
-	//
-	std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > rototranslations;
-	std::vector<pcl::Correspondences> clustered_corrs;
-
-	#ifdef USE_HOUGH
-	if (use_hough_) {
-		//
-		//  Compute (Keypoints) Reference Frames only for Hough
-		//
-		pcl::PointCloud<pcl::ReferenceFrame>::Ptr model_rf (new pcl::PointCloud<pcl::ReferenceFrame> ());
-		pcl::PointCloud<pcl::ReferenceFrame>::Ptr scene_rf (new pcl::PointCloud<pcl::ReferenceFrame> ());
-
-		pcl::BOARDLocalReferenceFrameEstimation<pcl::PointNormal, pcl::PointNormal, pcl::ReferenceFrame> rf_est;
-		rf_est.setFindHoles (true);
-		rf_est.setRadiusSearch (0.25);
-
-		rf_est.setInputCloud (target_);
-		rf_est.setInputNormals (target_);
-//		rf_est.setSearchSurface (model);
-		rf_est.compute (*model_rf);
-
-		rf_est.setInputCloud (input_);
-		rf_est.setInputNormals (input_);
-//		rf_est.setSearchSurface (scene);
-		rf_est.compute (*scene_rf);
-
-		//  Clustering
-		pcl::Hough3DGrouping<pcl::PointNormal, pcl::PointNormal, pcl::ReferenceFrame, pcl::ReferenceFrame> clusterer;
-		clusterer.setHoughBinSize(0.01);
-		clusterer.setHoughThreshold(5);
-		clusterer.setUseInterpolation(true);
-		clusterer.setUseDistanceWeight(false);
-
-		clusterer.setInputCloud(target_);
-		clusterer.setInputRf(model_rf);
-		clusterer.setSceneCloud(input_);
-		clusterer.setSceneRf(scene_rf);
-		clusterer.setModelSceneCorrespondences(model_scene_corrs);
-
-		//clusterer.cluster (clustered_corrs);
-		clusterer.recognize (rototranslations, clustered_corrs);
-	#else
-		pcl::GeometricConsistencyGrouping<PointSource, PointTarget> gc_clusterer;
-		gc_clusterer.setGCSize(0.01);
-		gc_clusterer.setGCThreshold(5);
-
-		gc_clusterer.setInputCloud(target_);
-		gc_clusterer.setSceneCloud(input_);
-		gc_clusterer.setModelSceneCorrespondences(model_scene_corrs);
-		gc_clusterer.recognize(rototranslations, clustered_corrs);
-	#endif
-
-
-	if (update_visualizer_ != 0) {
-		std::vector<int> sample_indices_filtered, corresponding_indices_filtered;
-		for (size_t i = 0; i < model_scene_corrs->size(); ++i) {
-			sample_indices_filtered.push_back((*model_scene_corrs)[i].index_query);
-			corresponding_indices_filtered.push_back((*model_scene_corrs)[i].index_match);
-		}
-
-		update_visualizer_(*input_, sample_indices_filtered, *target_, corresponding_indices_filtered);
-	}
-
-	for (int i = 0; i < rototranslations.size(); ++i) {
-		if (clustered_corrs[i].size() > 2) {
-			// Estimate the transform from the correspondences, write to transformation_
-			//    transformation_estimation_->estimateRigidTransformation(*input_, sample_indices, *target_, corresponding_indices, transformation_);
-//			transformation_estimation_->estimateRigidTransformation(*input_, *target_, *filtered_corrs, transformation_);
-
-			// Transform the input dataset using the final transformation
-			PointCloudSource input_transformed;
-			input_transformed.resize(input_->size());
-			transformPointCloudWithNormals(*input_, input_transformed, rototranslations[i]);
-
-			// Transform the input and compute the error (uses input_ and final_transformation_)
-			getFitness(input_transformed, inliers, error);
-
-			// If the new fit is better, update results
-			inlier_fraction = static_cast<float>(inliers.size()) / static_cast<float>(input_->size());
-
-			if (update_visualizer_ != 0) {
-				std::vector<int> sample_indices_filtered, corresponding_indices_filtered;
-				for (size_t j = 0; j < clustered_corrs[i].size(); ++j) {
-					sample_indices_filtered.push_back(clustered_corrs[i][j].index_query);
-					corresponding_indices_filtered.push_back(clustered_corrs[i][j].index_match);
-				}
-
-				update_visualizer_(input_transformed, sample_indices_filtered, *target_, corresponding_indices_filtered);
-			}
+	accepted_transformations_->clear();
 
-			// Update result if pose hypothesis is better
-			if (inlier_fraction >= inlier_fraction_ && error < lowest_error) {
-				inliers_ = inliers;
-				lowest_error = error;
-				converged_ = true;
-				final_transformation_ = transformation_;
-			}
-		}
+	if (correspondences_grouping_ != NO_GROUPING) {
+		computeGroupedPoseHypotheses(lowest_error);
+	} else {
+		computeSampledPoseHypotheses(lowest_error);
 	}
 
-#else //-----------------------------------------------------------------------------------------------------------------------------------
+	// Apply the final transformation
+	output.clear();
+	if (converged_) pcl::transformPointCloudWithNormals(*input_, output, final_transformation_);
+}
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget, typename FeatureT>
+void SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::computeSampledPoseHypotheses(double& lowest_error) {
 	//double highest_inlier_fraction = 0.0;
-	accepted_transformations_->clear();
+#ifdef _OPENMP
+	const int number_of_threads = omp_get_max_threads();
+#else
+	const int number_of_threads = 1;
+#endif
+	setupThreadsCorrespondenceRejectors(number_of_threads);
+	int number_of_prerejected_hypotheses = 0;
 
-	#pragma omp parallel for
+	#pragma omp parallel for num_threads(number_of_threads) reduction(+:number_of_prerejected_hypotheses)
 	for (int i = 0; i < max_iterations_; ++i) {
 		if (convergence_timer_.getTimeSeconds() > convergence_time_limit_seconds_) {
 			continue;
@@ -383,33 +262,24 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 			// Find corresponding features in the target cloud
 			findSimilarFeatures(sample_indices, corresponding_indices);
 
-			// Apply prerejection
-			/*if (!correspondence_rejector_poly_->thresholdPolygon (sample_indices, corresponding_indices)) {
-			++num_rejections;
-			continue;
-			}*/
-
+			// Apply prerejection (before the heavier correspondence rejectors)
 			pcl::CorrespondencesPtr temp_corrs(new pcl::Correspondences());
-			pcl::CorrespondencesPtr filtered_corrs(new pcl::Correspondences());
-			for (size_t i = 0; i < sample_indices.size(); ++i) {
-				float distance = pcl::euclideanDistance((*input_)[sample_indices[i]], (*target_)[corresponding_indices[i]]);
-				temp_corrs->push_back(pcl::Correspondence(sample_indices[i], corresponding_indices[i], distance));
+			if (!prerejectCorrespondences(sample_indices, corresponding_indices, *temp_corrs)) {
+				++number_of_prerejected_hypotheses;
+				continue;
 			}
 
-			if (temp_corrs->empty()) continue;
 
+#ifdef _OPENMP
+			std::vector< typename pcl::registration::CorrespondenceRejector::Ptr >& correspondence_rejectors = threads_correspondence_rejectors_[omp_get_thread_num()];
+#else
+			std::vector< typename pcl::registration::CorrespondenceRejector::Ptr >& correspondence_rejectors = threads_correspondence_rejectors_[0];
+#endif
 
-			// correspondence grouping
-			// TODO: aa
-
-			std::vector< typename pcl::registration::CorrespondenceRejector::Ptr > correspondence_rejectors;
-			setupCorrespondanceRejectors(correspondence_rejectors);
-
-			for (size_t i = 0; i < correspondence_rejectors.size(); ++i) {
+			pcl::CorrespondencesPtr filtered_corrs = temp_corrs;
+			for (size_t j = 0; j < correspondence_rejectors.size(); ++j) {
 				filtered_corrs = pcl::CorrespondencesPtr(new pcl::Correspondences());
-
-				//			#pragma omp critical
-				correspondence_rejectors[i]->getRemainingCorrespondences(*temp_corrs, *filtered_corrs);
+				correspondence_rejectors[j]->getRemainingCorrespondences(*temp_corrs, *filtered_corrs);
 
 				if (filtered_corrs->size() < 3) break;
 				temp_corrs = filtered_corrs;
@@ -421,7 +291,6 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 
 				// Estimate the transform from the correspondences, write to transformation_
 				//    transformation_estimation_->estimateRigidTransformation(*input_, sample_indices, *target_, corresponding_indices, transformation_);
-				//			#pragma omp critical
 				transformation_estimation.estimateRigidTransformation(*input_, *target_, *filtered_corrs, transformation);
 
 				// Transform the input dataset using the final transformation
@@ -442,9 +311,9 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 
 					if (update_visualizer_ != 0) {
 						std::vector<int> sample_indices_filtered, corresponding_indices_filtered;
-						for (size_t i = 0; i < filtered_corrs->size(); ++i) {
-							sample_indices_filtered.push_back((*filtered_corrs)[i].index_query);
-							corresponding_indices_filtered.push_back((*filtered_corrs)[i].index_match);
+						for (size_t j = 0; j < filtered_corrs->size(); ++j) {
+							sample_indices_filtered.push_back((*filtered_corrs)[j].index_query);
+							corresponding_indices_filtered.push_back((*filtered_corrs)[j].index_match);
 						}
 						#pragma omp critical
 						update_visualizer_(input_transformed, sample_indices_filtered, *target_, corresponding_indices_filtered);
@@ -467,16 +336,184 @@ template<typename PointSource, typename PointTarget, typename FeatureT> void Sam
 			}
 //		}
 	}
-#endif //--------------------------------------------------------------------------------------------------------------------------------
 
+	// Debug output
+	PCL_DEBUG("[pcl::%s::computeSampledPoseHypotheses] Prerejected %i out of %i generated pose hypotheses.\n", getClassName().c_str(), number_of_prerejected_hypotheses, max_iterations_);
+	PCL_DEBUG("[pcl::%s::computeSampledPoseHypotheses] Accepted %i out of %i generated pose hypotheses.\n", getClassName().c_str(), accepted_transformations_->size(), max_iterations_);
+}
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget, typename FeatureT>
+void SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::computeGroupedPoseHypotheses(double& lowest_error) {
+	// Find the best descriptor match of each source point (correspondences from model (target) to scene (input), as expected by the grouping algorithms)
+	const float maximum_descriptor_squared_distance = (grouping_maximum_descriptor_distance_ > 0.0 ?
+			grouping_maximum_descriptor_distance_ * grouping_maximum_descriptor_distance_ : std::numeric_limits<float>::max());
+	std::vector<pcl::Correspondence> source_matches(input_features_->size());
+	std::vector<bool> valid_source_matches(input_features_->size(), false);
+
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int i = 0; i < (int)input_features_->size(); ++i) {
+		if (!pcl::isFinite((*input_)[i])) { continue; }
+		std::vector<int> neigh_indices(1);
+		std::vector<float> neigh_sqr_dists(1);
+		int found_neighs = feature_tree_->nearestKSearch(*input_features_, i, 1, neigh_indices, neigh_sqr_dists);
+		if (found_neighs == 1 && neigh_sqr_dists[0] <= maximum_descriptor_squared_distance && pcl::isFinite((*target_)[neigh_indices[0]])) {
+			source_matches[i] = pcl::Correspondence(neigh_indices[0], i, neigh_sqr_dists[0]);
+			valid_source_matches[i] = true;
+		}
+	}
 
-	// Apply the final transformation
-	output.clear();
-	if (converged_) pcl::transformPointCloudWithNormals(*input_, output, final_transformation_);
+	pcl::CorrespondencesPtr model_scene_corrs(new pcl::Correspondences());
+	for (size_t i = 0; i < source_matches.size(); ++i) {
+		if (valid_source_matches[i]) { model_scene_corrs->push_back(source_matches[i]); }
+	}
+
+	if (model_scene_corrs->size() < 3) {
+		PCL_DEBUG("[pcl::%s::computeGroupedPoseHypotheses] Only %lu descriptor correspondences were found.\n", getClassName().c_str(), model_scene_corrs->size());
+		return;
+	}
+
+
+	// Cluster the correspondences that are geometrically consistent with each other (each cluster is a pose hypothesis)
+	std::vector<pcl::Correspondences> clustered_corrs;
+	if (correspondences_grouping_ == HOUGH_3D) {
+		if (!hough_grouping_ || hough_grouping_target_ != target_ || hough_grouping_target_size_ != target_->size()) {
+			pcl::PointCloud<pcl::ReferenceFrame>::Ptr target_reference_frames(new pcl::PointCloud<pcl::ReferenceFrame>());
+			pcl::BOARDLocalReferenceFrameEstimation<PointTarget, PointTarget, pcl::ReferenceFrame> target_reference_frames_estimation;
+			target_reference_frames_estimation.setFindHoles(true);
+			target_reference_frames_estimation.setRadiusSearch(grouping_reference_frames_radius_);
+			target_reference_frames_estimation.setInputCloud(target_);
+			target_reference_frames_estimation.setInputNormals(target_);
+			target_reference_frames_estimation.compute(*target_reference_frames);
+
+			// the hough space is trained only once for each target cloud
+			hough_grouping_.reset(new Hough3DGrouping());
+			hough_grouping_->setUseInterpolation(true);
+			hough_grouping_->setUseDistanceWeight(false);
+			hough_grouping_->setInputCloud(target_);
+			hough_grouping_->setInputRf(target_reference_frames);
+			hough_grouping_target_ = target_;
+			hough_grouping_target_size_ = target_->size();
+		}
+
+		pcl::PointCloud<pcl::ReferenceFrame>::Ptr source_reference_frames(new pcl::PointCloud<pcl::ReferenceFrame>());
+		pcl::BOARDLocalReferenceFrameEstimation<PointSource, PointSource, pcl::ReferenceFrame> source_reference_frames_estimation;
+		source_reference_frames_estimation.setFindHoles(true);
+		source_reference_frames_estimation.setRadiusSearch(grouping_reference_frames_radius_);
+		source_reference_frames_estimation.setInputCloud(input_);
+		source_reference_frames_estimation.setInputNormals(input_);
+		source_reference_frames_estimation.compute(*source_reference_frames);
+
+		hough_grouping_->setHoughBinSize(grouping_consensus_set_resolution_);
+		hough_grouping_->setHoughThreshold(grouping_consensus_set_minimum_size_);
+		hough_grouping_->setSceneCloud(input_);
+		hough_grouping_->setSceneRf(source_reference_frames);
+		hough_grouping_->setModelSceneCorrespondences(model_scene_corrs);
+		hough_grouping_->cluster(clustered_corrs);
+	} else {
+		pcl::GeometricConsistencyGrouping<PointTarget, PointSource> gc_clusterer;
+		gc_clusterer.setGCSize(grouping_consensus_set_resolution_);
+		gc_clusterer.setGCThreshold(grouping_consensus_set_minimum_size_);
+		gc_clusterer.setInputCloud(target_);
+		gc_clusterer.setSceneCloud(input_);
+		gc_clusterer.setModelSceneCorrespondences(model_scene_corrs);
+		gc_clusterer.cluster(clustered_corrs);
+	}
+
+
+	// Verify and refine each pose hypothesis
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int i = 0; i < (int)clustered_corrs.size(); ++i) {
+		if (convergence_timer_.getTimeSeconds() > convergence_time_limit_seconds_ || clustered_corrs[i].size() < 3) {
+			continue;
+		}
+
+		pcl::Correspondences source_target_corrs;
+		source_target_corrs.reserve(clustered_corrs[i].size());
+		for (size_t j = 0; j < clustered_corrs[i].size(); ++j) {
+			source_target_corrs.push_back(pcl::Correspondence(clustered_corrs[i][j].index_match, clustered_corrs[i][j].index_query, clustered_corrs[i][j].distance));
+		}
+
+		Matrix4 transformation;
+		pcl::registration::TransformationEstimationSVD<PointSource, PointTarget> transformation_estimation;
+		transformation_estimation.estimateRigidTransformation(*input_, *target_, source_target_corrs, transformation);
+
+		PointCloudSource input_transformed;
+		std::vector<int> inliers;
+		double error = std::numeric_limits<double>::max();
+		pcl::transformPointCloudWithNormals(*input_, input_transformed, transformation);
+		getFitness(input_transformed, inliers, error);
+
+		for (int refinement_iteration = 0; refinement_iteration < grouping_refinement_iterations_ && inliers.size() > 2; ++refinement_iteration) {
+			Matrix4 refined_transformation;
+			if (!refineTransformation(input_transformed, inliers, refined_transformation)) { break; }
+
+			PointCloudSource refined_input_transformed;
+			std::vector<int> refined_inliers;
+			double refined_error;
+			pcl::transformPointCloudWithNormals(*input_, refined_input_transformed, refined_transformation);
+			getFitness(refined_input_transformed, refined_inliers, refined_error);
+
+			if (refined_inliers.size() < inliers.size() || (refined_inliers.size() == inliers.size() && refined_error >= error)) { break; }
+
+			transformation = refined_transformation;
+			input_transformed.swap(refined_input_transformed);
+			inliers.swap(refined_inliers);
+			error = refined_error;
+		}
+
+		if (inliers.size() > 2) {
+			double current_inlier_fraction = static_cast<double>(inliers.size()) / static_cast<double>(input_->size());
+
+			if (update_visualizer_ != 0) {
+				std::vector<int> sample_indices_filtered, corresponding_indices_filtered;
+				for (size_t j = 0; j < source_target_corrs.size(); ++j) {
+					sample_indices_filtered.push_back(source_target_corrs[j].index_query);
+					corresponding_indices_filtered.push_back(source_target_corrs[j].index_match);
+				}
+				#pragma omp critical
+				update_visualizer_(input_transformed, sample_indices_filtered, *target_, corresponding_indices_filtered);
+			}
+
+			// Update result if pose hypothesis is better
+			#pragma omp critical
+			if (current_inlier_fraction >= inlier_fraction_ && error < inlier_rmse_) {
+				accepted_transformations_->push_back(transformation);
+				if (error < lowest_error) {
+					inliers_ = inliers;
+					lowest_error = error;
+					converged_ = true;
+					final_transformation_ = transformation;
+					transformation_ = transformation;
+				}
+			}
+		}
+	}
 
 	// Debug output
-	PCL_DEBUG("[pcl::%s::computeTransformation] Accepted %i out of %i generated pose hypotheses.\n", getClassName().c_str(), accepted_transformations_->size(), max_iterations_);
+	PCL_DEBUG("[pcl::%s::computeGroupedPoseHypotheses] Accepted %lu out of %lu grouped pose hypotheses (from %lu descriptor correspondences).\n", getClassName().c_str(),
+			accepted_transformations_->size(), clustered_corrs.size(), model_scene_corrs->size());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget, typename FeatureT>
+bool SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::refineTransformation(const PointCloudSource& input_transformed, const std::vector<int>& inliers,
+		Matrix4& refined_transformation) {
+	pcl::Correspondences inliers_corrs;
+	inliers_corrs.reserve(inliers.size());
+	std::vector<int> nn_indices(1);
+	std::vector<float> nn_dists(1);
+	for (size_t i = 0; i < inliers.size(); ++i) {
+		if (tree_->nearestKSearch(input_transformed.points[inliers[i]], 1, nn_indices, nn_dists) > 0) {
+			inliers_corrs.push_back(pcl::Correspondence(inliers[i], nn_indices[0], nn_dists[0]));
+		}
+	}
+
+	if (inliers_corrs.size() < 3) { return false; }
+
+	pcl::registration::TransformationEstimationSVD<PointSource, PointTarget> transformation_estimation;
+	transformation_estimation.estimateRigidTransformation(*input_, *target_, inliers_corrs, refined_transformation);
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -539,12 +576,79 @@ void SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::setupCorre
 	pcl::Registration<PointSource, PointTarget>::addCorrespondenceRejector(corr_rej_tri);*/
 
 
-	typename pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource>::Ptr corr_rej_sac(new pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource>());
-	corr_rej_sac->setInputSource(input_);
-	corr_rej_sac->setInputTarget(target_);
-	corr_rej_sac->setInlierThreshold(0.25);
-	corr_rej_sac->setMaximumIterations(500);
-	correspondence_rejectors.push_back(corr_rej_sac);
+	if (sample_consensus_rejector_maximum_iterations_ > 0) {
+		typename pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource>::Ptr corr_rej_sac(new pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource>());
+		corr_rej_sac->setInputSource(input_);
+		corr_rej_sac->setInputTarget(target_);
+		corr_rej_sac->setInlierThreshold(sample_consensus_rejector_inlier_threshold_);
+		corr_rej_sac->setMaximumIterations(sample_consensus_rejector_maximum_iterations_);
+		correspondence_rejectors.push_back(corr_rej_sac);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget, typename FeatureT>
+void SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::setupThreadsCorrespondenceRejectors(int number_of_threads) {
+	if ((int)threads_correspondence_rejectors_.size() < number_of_threads) {
+		threads_correspondence_rejectors_.resize(number_of_threads);
+	}
+
+	for (size_t i = 0; i < threads_correspondence_rejectors_.size(); ++i) {
+		if (threads_correspondence_rejectors_[i].empty()) {
+			setupCorrespondanceRejectors(threads_correspondence_rejectors_[i]);
+		} else {
+			for (size_t j = 0; j < threads_correspondence_rejectors_[i].size(); ++j) {
+				typename pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource>::Ptr corr_rej_sac =
+						std::dynamic_pointer_cast< pcl::registration::CorrespondenceRejectorSampleConsensus<PointSource> >(threads_correspondence_rejectors_[i][j]);
+				if (corr_rej_sac) {
+					corr_rej_sac->setInputSource(input_);
+					corr_rej_sac->setInputTarget(target_);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget, typename FeatureT>
+bool SampleConsensusPrerejective<PointSource, PointTarget, FeatureT>::prerejectCorrespondences(const std::vector<int> &sample_indices, const std::vector<int> &corresponding_indices,
+		pcl::Correspondences &correspondences) const {
+	correspondences.clear();
+	const size_t number_of_samples = std::min(sample_indices.size(), corresponding_indices.size());
+	if (number_of_samples < 3) return false;
+
+	const float similarity_threshold = correspondence_rejector_poly_->getSimilarityThreshold();
+	std::vector<bool> similar_edges(number_of_samples, true);
+
+	if (similarity_threshold > 0.0f) {
+		const float similarity_threshold_squared = similarity_threshold * similarity_threshold;
+		size_t number_of_similar_edges = 0;
+
+		// Edge i connects sample i with sample i + 1 (closing the polygon on the first sample)
+		for (size_t i = 0; i < number_of_samples; ++i) {
+			const size_t next_i = (i + 1) % number_of_samples;
+			const float source_edge_squared_length = (input_->points[sample_indices[i]].getVector3fMap() - input_->points[sample_indices[next_i]].getVector3fMap()).squaredNorm();
+			const float target_edge_squared_length = (target_->points[corresponding_indices[i]].getVector3fMap() - target_->points[corresponding_indices[next_i]].getVector3fMap()).squaredNorm();
+			const float edge_similarity_squared = (source_edge_squared_length < target_edge_squared_length ?
+					source_edge_squared_length / target_edge_squared_length : target_edge_squared_length / source_edge_squared_length);
+			similar_edges[i] = (edge_similarity_squared >= similarity_threshold_squared); // false for degenerated edges (0/0 -> NaN)
+			if (similar_edges[i]) ++number_of_similar_edges;
+		}
+
+		if (number_of_samples == 3 && number_of_similar_edges != 3) return false;
+		if (number_of_similar_edges < 2) return false;
+	}
+
+	correspondences.reserve(number_of_samples);
+	for (size_t i = 0; i < number_of_samples; ++i) {
+		const size_t previous_i = (i + number_of_samples - 1) % number_of_samples;
+		if (similar_edges[i] || similar_edges[previous_i]) {
+			float distance = pcl::euclideanDistance((*input_)[sample_indices[i]], (*target_)[corresponding_indices[i]]);
+			correspondences.push_back(pcl::Correspondence(sample_indices[i], corresponding_indices[i], distance));
+		}
+	}
+
+	return correspondences.size() > 2;
 }
 
 } /* namespace dynamic_robot_localization */
@@ -36,6 +36,25 @@ void KeypointDescriptor<PointT, FeatureT>::setupConfigurationFromParameterServer
 		} else {
 			feature_descriptor_->setRadiusSearch(0.0);
 		}
+
+		if (ros::param::search(search_namespace, "number_of_threads", final_param_name)) { private_node_handle->param(final_param_name, number_of_threads_, 0); }
+
+		std::stringstream configuration_description;
+		configuration_description << configuration_namespace << "|k:" << feature_descriptor_->getKSearch() << "|radius:" << feature_descriptor_->getRadiusSearch();
+		std::string descriptor_parameters_namespace = configuration_namespace;
+		if (!descriptor_parameters_namespace.empty() && descriptor_parameters_namespace.back() == '/') { descriptor_parameters_namespace.pop_back(); }
+		XmlRpc::XmlRpcValue descriptor_parameters;
+		if (!descriptor_parameters_namespace.empty() && private_node_handle->getParam(descriptor_parameters_namespace, descriptor_parameters)) {
+			if (descriptor_parameters.getType() == XmlRpc::XmlRpcValue::TypeStruct) {
+				XmlRpc::XmlRpcValue descriptor_parameters_affecting_descriptors;
+				for (XmlRpc::XmlRpcValue::iterator it = descriptor_parameters.begin(); it != descriptor_parameters.end(); ++it) {
+					if (it->first != "number_of_threads") { descriptor_parameters_affecting_descriptors[it->first] = it->second; } // the number of threads does not change the computed descriptors
+				}
+				descriptor_parameters = descriptor_parameters_affecting_descriptors;
+			}
+			if (descriptor_parameters.valid()) { configuration_description << "|" << descriptor_parameters.toXml(); }
+		}
+		configuration_description_ = configuration_description.str();
 	}
 }
 
@@ -52,7 +71,9 @@ typename pcl::PointCloud<FeatureT>::Ptr KeypointDescriptor<PointT, FeatureT>::co
 		feature_descriptor_->setSearchMethod(surface_search_method);
 		feature_descriptor_->setSearchSurface(surface);
 		feature_descriptor_->setInputCloud(pointcloud_keypoints);
-		feature_descriptor_->compute(*descriptors);
+		if (!computeKeypointsDescriptorsInParallel(pointcloud_keypoints, *descriptors)) {
+			feature_descriptor_->compute(*descriptors);
+		}
 		ROS_DEBUG_STREAM("Finished computation of " << pointcloud_keypoints->size() << " descriptors");
 	}
 
@@ -62,6 +83,63 @@ typename pcl::PointCloud<FeatureT>::Ptr KeypointDescriptor<PointT, FeatureT>::co
 // =============================================================================  </public-section>  ===========================================================================
 
 // =============================================================================   <protected-section>   =======================================================================
+template<typename PointT, typename FeatureT>
+bool KeypointDescriptor<PointT, FeatureT>::computeKeypointsDescriptorsInParallel(typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints, typename pcl::PointCloud<FeatureT>& descriptors) {
+	size_t number_of_blocks = 1;
+#ifdef _OPENMP
+	number_of_blocks = (size_t)(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads());
+#endif
+	number_of_blocks = std::min(number_of_blocks, pointcloud_keypoints->size());
+	if (number_of_blocks < 2) { return false; }
+
+	std::vector< typename pcl::Feature<PointT, FeatureT>::Ptr > feature_descriptors;
+	for (size_t block_index = 0; block_index < number_of_blocks; ++block_index) {
+		typename pcl::Feature<PointT, FeatureT>::Ptr feature_descriptor = cloneFeatureDescriptor();
+		if (!feature_descriptor) { return false; }
+		feature_descriptors.push_back(feature_descriptor);
+	}
+
+	// the search method is shared by all threads and must be ready for read only queries before the parallel section
+	typename pcl::search::Search<PointT>::Ptr search_method = feature_descriptor_->getSearchMethod();
+	typename pcl::PointCloud<PointT>::ConstPtr search_surface = feature_descriptor_->getSearchSurface();
+	if (search_method && search_surface && search_method->getInputCloud() != search_surface) { search_method->setInputCloud(search_surface); }
+
+	descriptors.resize(pointcloud_keypoints->size());
+	descriptors.header = pointcloud_keypoints->header;
+	descriptors.width = pointcloud_keypoints->width;
+	descriptors.height = pointcloud_keypoints->height;
+	std::vector<char> blocks_dense(number_of_blocks, 1);
+	std::vector<char> blocks_computed(number_of_blocks, 1);
+
+	#pragma omp parallel for schedule(static, 1) num_threads(number_of_blocks)
+	for (int block_index = 0; block_index < (int)number_of_blocks; ++block_index) {
+		size_t block_begin = (pointcloud_keypoints->size() * block_index) / number_of_blocks;
+		size_t block_end = (pointcloud_keypoints->size() * (block_index + 1)) / number_of_blocks;
+		pcl::IndicesPtr block_indices(new std::vector<int>(block_end - block_begin));
+		for (size_t i = block_begin; i < block_end; ++i) {
+			(*block_indices)[i - block_begin] = (int)i;
+		}
+
+		typename pcl::PointCloud<FeatureT> block_descriptors;
+		feature_descriptors[block_index]->setIndices(block_indices);
+		feature_descriptors[block_index]->compute(block_descriptors);
+
+		if (block_descriptors.size() == block_indices->size()) {
+			std::copy(block_descriptors.begin(), block_descriptors.end(), descriptors.begin() + block_begin);
+			blocks_dense[block_index] = block_descriptors.is_dense;
+		} else {
+			blocks_computed[block_index] = 0;
+		}
+	}
+
+	if (std::find(blocks_computed.begin(), blocks_computed.end(), 0) != blocks_computed.end()) {
+		descriptors.clear();
+		return true;
+	}
+
+	descriptors.is_dense = (std::find(blocks_dense.begin(), blocks_dense.end(), 0) == blocks_dense.end());
+	return true;
+}
 // =============================================================================   </protected-section>  =======================================================================
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -34,6 +34,14 @@ void PFH<PointT, FeatureT>::setupConfigurationFromParameterServer(ros::NodeHandl
 	KeypointDescriptor<PointT, FeatureT>::setFeatureDescriptor(feature_descriptor);
 	KeypointDescriptor<PointT, FeatureT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 }
+
+
+template<typename PointT, typename FeatureT>
+typename pcl::Feature<PointT, FeatureT>::Ptr PFH<PointT, FeatureT>::cloneFeatureDescriptor() {
+	typename pcl::PFHEstimation<PointT, PointT, FeatureT>::Ptr feature_descriptor = std::static_pointer_cast< pcl::PFHEstimation<PointT, PointT, FeatureT> >(KeypointDescriptor<PointT, FeatureT>::getFeatureDescriptor());
+	if (!feature_descriptor) { return typename pcl::Feature<PointT, FeatureT>::Ptr(); }
+	return typename pcl::Feature<PointT, FeatureT>::Ptr(new pcl::PFHEstimation<PointT, PointT, FeatureT>(*feature_descriptor));
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PFH-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
@@ -44,7 +44,15 @@ void SpinImage<PointT, FeatureT>::setupConfigurationFromParameterServer(ros::Nod
 	feature_descriptor->setRadialStructure(use_radial_structure);
 
 	KeypointDescriptor<PointT, FeatureT>::setFeatureDescriptor(feature_descriptor);
-	KeypointDescriptor<PointT, FeatureT>::setupConfigurationFromParameterServer(node_handle, private_node_handle);
+	KeypointDescriptor<PointT, FeatureT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+}
+
+
+template<typename PointT, typename FeatureT>
+typename pcl::Feature<PointT, FeatureT>::Ptr SpinImage<PointT, FeatureT>::cloneFeatureDescriptor() {
+	typename pcl::SpinImageEstimation<PointT, PointT, FeatureT>::Ptr feature_descriptor = std::static_pointer_cast< pcl::SpinImageEstimation<PointT, PointT, FeatureT> >(KeypointDescriptor<PointT, FeatureT>::getFeatureDescriptor());
+	if (!feature_descriptor) { return typename pcl::Feature<PointT, FeatureT>::Ptr(); }
+	return typename pcl::Feature<PointT, FeatureT>::Ptr(new pcl::SpinImageEstimation<PointT, PointT, FeatureT>(*feature_descriptor));
 }
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </SpinImage-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
@@ -34,6 +34,14 @@ void UniqueShapeContext<PointT, FeatureT>::setupConfigurationFromParameterServer
 	KeypointDescriptor<PointT, FeatureT>::setFeatureDescriptor(feature_descriptor);
 	KeypointDescriptor<PointT, FeatureT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
 }
+
+
+template<typename PointT, typename FeatureT>
+typename pcl::Feature<PointT, FeatureT>::Ptr UniqueShapeContext<PointT, FeatureT>::cloneFeatureDescriptor() {
+	typename pcl::UniqueShapeContext<PointT, FeatureT>::Ptr feature_descriptor = std::static_pointer_cast< pcl::UniqueShapeContext<PointT, FeatureT> >(KeypointDescriptor<PointT, FeatureT>::getFeatureDescriptor());
+	if (!feature_descriptor) { return typename pcl::Feature<PointT, FeatureT>::Ptr(); }
+	return typename pcl::Feature<PointT, FeatureT>::Ptr(new pcl::UniqueShapeContext<PointT, FeatureT>(*feature_descriptor));
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </UniqueShapeContext-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
@@ -9,8 +9,11 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 // ROS includes
 #include <ros/ros.h>
@@ -23,6 +26,10 @@
 
 // project includes
 #include <dynamic_robot_localization/common/configurable_object.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 namespace dynamic_robot_localization {
@@ -40,7 +47,7 @@ class KeypointDescriptor : public ConfigurableObject {
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-		KeypointDescriptor() {}
+		KeypointDescriptor() : number_of_threads_(0) {}
 		virtual ~KeypointDescriptor() {}
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -49,20 +56,34 @@ class KeypointDescriptor : public ConfigurableObject {
 		virtual typename pcl::PointCloud<FeatureT>::Ptr computeKeypointsDescriptors(typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints,
 				typename pcl::PointCloud<PointT>::Ptr& surface,
 				typename pcl::search::KdTree<PointT>::Ptr& surface_search_method);
+
+		/**
+		 * Returns a copy of the configured feature_descriptor_ (sharing its input clouds and search method) for computing the descriptors of a subset of keypoints in another thread.
+		 * Descriptors whose estimation is not independent for each keypoint (such as shape_context_3d, which draws random numbers from the estimator rng) must return a null pointer (default), which disables the parallel computation.
+		 */
+		virtual typename pcl::Feature<PointT, FeatureT>::Ptr cloneFeatureDescriptor() { return typename pcl::Feature<PointT, FeatureT>::Ptr(); }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </KeypointDescriptor-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		const typename pcl::Feature<PointT, FeatureT>::Ptr getFeatureDescriptor() { return feature_descriptor_; }
+		/// Descriptor namespace and parameters, used for checking if cached descriptors were computed with the current configuration
+		const std::string& getConfigurationDescription() const { return configuration_description_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		void setFeatureDescriptor(const typename pcl::Feature<PointT, FeatureT>::Ptr& feature_descriptor) { feature_descriptor_ = feature_descriptor; }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 	// ========================================================================   </public-section>  ===========================================================================
 
 	// ========================================================================   <protected-section>   ========================================================================
 	protected:
+		/// Splits the keypoints in contiguous blocks, each one processed by a copy of feature_descriptor_ (with its own neighbors buffers and caches)
+		bool computeKeypointsDescriptorsInParallel(typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints, typename pcl::PointCloud<FeatureT>& descriptors);
+
 		typename pcl::Feature<PointT, FeatureT>::Ptr feature_descriptor_;
+		int number_of_threads_;
+		std::string configuration_description_;
 	// ========================================================================   </protected-section>  ========================================================================
 };
 
@@ -56,6 +56,13 @@ void IntrinsicShapeSignature3D<PointT>::setupConfigurationFromParameterServer(ro
 	private_node_handle->param(configuration_namespace + "angle_threshold", angle_threshold, 1.57);
 	keypoint_detector->setAngleThreshold(angle_threshold);
 
+	// pcl::ISSKeypoint3D is already multithreaded and owns raw buffers that cannot be copied (so it does not use the parallel blocks of KeypointDetector)
+	KeypointDetector<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	keypoint_detector->setNumberOfThreads((unsigned int)std::max(KeypointDetector<PointT>::getNumberOfThreads(), 0));
+	if (KeypointDetector<PointT>::getKeypointSupportRadius() <= 0.0) {
+		KeypointDetector<PointT>::setKeypointSupportRadius(salient_radius + non_max_radius + (border_radius > 0.0 ? std::max(normal_radius, border_radius) : 0.0));
+	}
+
 	KeypointDetector<PointT>::setKeypointDetector(keypoint_detector_base);
 	typename CloudPublisher<PointT>::Ptr cloud_publisher(new CloudPublisher<PointT>());
 	cloud_publisher->setParameterServerArgumentToLoadTopicName(configuration_namespace + "iss3d_keypoints_cloud_publish_topic");
@@ -19,15 +19,25 @@ namespace dynamic_robot_localization {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <KeypointDetector-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void KeypointDetector<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads_, 0);
+	private_node_handle->param(configuration_namespace + "parallel_block_size", parallel_block_size_, 0.0);
+	private_node_handle->param(configuration_namespace + "keypoint_support_radius", keypoint_support_radius_, 0.0);
+}
+
+
 template<typename PointT>
 void KeypointDetector<PointT>::findKeypoints(typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints_out,
 		typename pcl::PointCloud<PointT>::Ptr& surface, typename pcl::search::KdTree<PointT>::Ptr& surface_search_method) {
 
 	ROS_DEBUG_STREAM("Finding keypoints in a pointcloud with " << pointcloud->size());
-	keypoint_detector_->setSearchMethod(surface_search_method);
-	keypoint_detector_->setSearchSurface(surface);
-	keypoint_detector_->setInputCloud(pointcloud);
-	keypoint_detector_->compute(*pointcloud_keypoints_out);
+	if (parallel_block_size_ <= 0.0 || number_of_threads_ == 1 || !findKeypointsInParallelBlocks(pointcloud, pointcloud_keypoints_out, surface)) {
+		keypoint_detector_->setSearchMethod(surface_search_method);
+		keypoint_detector_->setSearchSurface(surface);
+		keypoint_detector_->setInputCloud(pointcloud);
+		keypoint_detector_->compute(*pointcloud_keypoints_out);
+	}
 
 	pointcloud_keypoints_out->header = pointcloud->header;
 	if (cloud_publisher_ && pointcloud_keypoints_out) { cloud_publisher_->publishPointCloud(*pointcloud_keypoints_out); }
@@ -36,6 +46,87 @@ void KeypointDetector<PointT>::findKeypoints(typename pcl::PointCloud<PointT>::P
 // =============================================================================  </public-section>  ===========================================================================
 
 // =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+bool KeypointDetector<PointT>::findKeypointsInParallelBlocks(const typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints_out, const typename pcl::PointCloud<PointT>::Ptr& surface) {
+	if (!keypoint_detector_ || pointcloud->empty() || !cloneKeypointDetector()) { return false; }
+
+	PointT min_point, max_point;
+	pcl::getMinMax3D(*pointcloud, min_point, max_point);
+	Eigen::Array3f blocks_origin = min_point.getArray3fMap();
+	Eigen::Array3f number_of_blocks_along_axes = ((max_point.getArray3fMap() - blocks_origin) / (float)parallel_block_size_).floor() + 1.0f;
+	if (!number_of_blocks_along_axes.allFinite()) { return false; }
+	double total_number_of_blocks_along_axes = (double)number_of_blocks_along_axes.x() * (double)number_of_blocks_along_axes.y() * (double)number_of_blocks_along_axes.z();
+	if (total_number_of_blocks_along_axes < 2.0) { return false; }
+	if (total_number_of_blocks_along_axes > (double)pointcloud->size()) {
+		ROS_WARN_STREAM("Skipping keypoint detection in parallel blocks because the parallel_block_size " << parallel_block_size_ << " would create " << total_number_of_blocks_along_axes << " blocks for a cloud with " << pointcloud->size() << " points");
+		return false;
+	}
+	Eigen::Array3i number_of_blocks = number_of_blocks_along_axes.template cast<int>();
+	size_t total_number_of_blocks = (size_t)number_of_blocks.x() * (size_t)number_of_blocks.y() * (size_t)number_of_blocks.z();
+
+	float block_overlap = (float)std::max(keypoint_support_radius_, 0.0);
+	std::vector< std::vector<int> > blocks_points_indices, blocks_surface_indices;
+	assignPointsToParallelBlocks(*pointcloud, blocks_origin, number_of_blocks, block_overlap, blocks_points_indices);
+	bool surface_is_pointcloud = (!surface || surface == pointcloud);
+	if (!surface_is_pointcloud) { assignPointsToParallelBlocks(*surface, blocks_origin, number_of_blocks, block_overlap, blocks_surface_indices); }
+
+	std::vector< typename pcl::PointCloud<PointT>::Ptr > blocks_keypoints(total_number_of_blocks);
+	bool all_blocks_computed = true;
+	#pragma omp parallel for schedule(dynamic, 1) reduction(&&:all_blocks_computed) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int block_index = 0; block_index < (int)total_number_of_blocks; ++block_index) {
+		if (blocks_points_indices[block_index].empty()) { continue; }
+
+		typename pcl::Keypoint<PointT, PointT>::Ptr block_keypoint_detector = cloneKeypointDetector();
+		if (!block_keypoint_detector) { all_blocks_computed = false; continue; }
+
+		typename pcl::PointCloud<PointT>::Ptr block_pointcloud(new pcl::PointCloud<PointT>(*pointcloud, blocks_points_indices[block_index]));
+		typename pcl::PointCloud<PointT>::Ptr block_surface = surface_is_pointcloud ? block_pointcloud : typename pcl::PointCloud<PointT>::Ptr(new pcl::PointCloud<PointT>(*surface, blocks_surface_indices[block_index]));
+		typename pcl::search::KdTree<PointT>::Ptr block_search_method(new pcl::search::KdTree<PointT>());
+		block_keypoint_detector->setSearchMethod(block_search_method);
+		block_keypoint_detector->setSearchSurface(block_surface);
+		block_keypoint_detector->setInputCloud(block_pointcloud);
+		pcl::PointCloud<PointT> block_keypoints_with_overlap;
+		block_keypoint_detector->compute(block_keypoints_with_overlap);
+
+		Eigen::Array3i block_coordinates(block_index % number_of_blocks.x(), (block_index / number_of_blocks.x()) % number_of_blocks.y(), block_index / (number_of_blocks.x() * number_of_blocks.y()));
+		typename pcl::PointCloud<PointT>::Ptr block_keypoints(new pcl::PointCloud<PointT>());
+		for (size_t i = 0; i < block_keypoints_with_overlap.size(); ++i) {
+			Eigen::Array3i keypoint_block_coordinates = ((block_keypoints_with_overlap[i].getArray3fMap() - blocks_origin) / (float)parallel_block_size_).floor().template cast<int>().max(0).min(number_of_blocks - 1);
+			if ((keypoint_block_coordinates == block_coordinates).all()) { block_keypoints->push_back(block_keypoints_with_overlap[i]); }
+		}
+		blocks_keypoints[block_index] = block_keypoints;
+	}
+
+	if (!all_blocks_computed) { return false; }
+
+	pointcloud_keypoints_out->clear();
+	for (size_t i = 0; i < blocks_keypoints.size(); ++i) {
+		if (blocks_keypoints[i]) { *pointcloud_keypoints_out += *blocks_keypoints[i]; }
+	}
+
+	ROS_DEBUG_STREAM("Computed " << pointcloud_keypoints_out->size() << " keypoints in " << total_number_of_blocks << " parallel blocks");
+	return true;
+}
+
+
+template<typename PointT>
+void KeypointDetector<PointT>::assignPointsToParallelBlocks(const pcl::PointCloud<PointT>& pointcloud, const Eigen::Array3f& blocks_origin, const Eigen::Array3i& number_of_blocks, float block_overlap, std::vector< std::vector<int> >& blocks_points_indices) {
+	blocks_points_indices.clear();
+	blocks_points_indices.resize((size_t)number_of_blocks.x() * (size_t)number_of_blocks.y() * (size_t)number_of_blocks.z());
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		if (!pcl::isFinite(pointcloud[i])) { continue; }
+		Eigen::Array3f point = pointcloud[i].getArray3fMap() - blocks_origin;
+		Eigen::Array3i first_block = ((point - block_overlap) / (float)parallel_block_size_).floor().template cast<int>().max(0).min(number_of_blocks - 1);
+		Eigen::Array3i last_block = ((point + block_overlap) / (float)parallel_block_size_).floor().template cast<int>().max(0).min(number_of_blocks - 1);
+		for (int z = first_block.z(); z <= last_block.z(); ++z) {
+			for (int y = first_block.y(); y <= last_block.y(); ++y) {
+				for (int x = first_block.x(); x <= last_block.x(); ++x) {
+					blocks_points_indices[((size_t)z * number_of_blocks.y() + y) * number_of_blocks.x() + x].push_back((int)i);
+				}
+			}
+		}
+	}
+}
 // =============================================================================   </protected-section>  =======================================================================
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -34,6 +34,12 @@ void SIFT3D<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& n
 	keypoint_detector->setScales(min_scale, number_octaves, number_scales_per_octave);
 	keypoint_detector->setMinimumContrast(min_contrast);
 
+	KeypointDetector<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	if (KeypointDetector<PointT>::getKeypointSupportRadius() <= 0.0) {
+		// largest scale of the scale space times the radius used for the difference of gaussians
+		KeypointDetector<PointT>::setKeypointSupportRadius(3.0 * min_scale * std::pow(2.0, (double)number_octaves));
+	}
+
 	KeypointDetector<PointT>::setKeypointDetector(keypoint_detector_base);
 	typename CloudPublisher<PointT>::Ptr cloud_publisher(new CloudPublisher<PointT>());
 	cloud_publisher->setParameterServerArgumentToLoadTopicName(configuration_namespace + "sift3d_keypoints_cloud_publish_topic");
@@ -49,6 +55,14 @@ void SIFT3D<PointT>::findKeypoints(typename pcl::PointCloud<PointT>::Ptr& pointc
 	KeypointDetector<PointT>::findKeypoints(pointcloud, pointcloud_keypoints_out, surface, surface_search_method);
 	ROS_DEBUG_STREAM("SIFT3D found " << pointcloud_keypoints_out->size() << " keypoints in pointcloud with " << pointcloud->size() << " points");
 }
+
+
+template<typename PointT>
+typename pcl::Keypoint<PointT, PointT>::Ptr SIFT3D<PointT>::cloneKeypointDetector() {
+	typename pcl::SIFTKeypoint<PointT, PointT>::Ptr keypoint_detector = std::static_pointer_cast< pcl::SIFTKeypoint<PointT, PointT> >(KeypointDetector<PointT>::getKeypointDetector());
+	if (!keypoint_detector) { return typename pcl::Keypoint<PointT, PointT>::Ptr(); }
+	return typename pcl::Keypoint<PointT, PointT>::Ptr(new pcl::SIFTKeypoint<PointT, PointT>(*keypoint_detector));
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </SIFT3D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // =============================================================================  </public-section>  ===========================================================================
 
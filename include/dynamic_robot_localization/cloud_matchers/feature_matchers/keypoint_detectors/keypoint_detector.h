@@ -9,7 +9,11 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <string>
+#include <vector>
 
 // ROS includes
 #include <ros/ros.h>
@@ -21,10 +25,15 @@
 #include <pcl/keypoints/keypoint.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <pcl/search/kdtree.h>
+#include <pcl/common/common.h>
 
 // project includes
 #include <dynamic_robot_localization/common/configurable_object.h>
 #include <dynamic_robot_localization/common/cloud_publisher.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 namespace dynamic_robot_localization {
@@ -42,30 +51,53 @@ class KeypointDetector : public ConfigurableObject {
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-		KeypointDetector() {}
+		KeypointDetector() : number_of_threads_(0), parallel_block_size_(0.0), keypoint_support_radius_(0.0) {}
 		virtual ~KeypointDetector() {}
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <KeypointDetector-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Loads the parallelization parameters (subclasses must call it from their own setupConfigurationFromParameterServer)
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
 		virtual void findKeypoints(typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints_out,
 		        typename pcl::PointCloud<PointT>::Ptr& surface, typename pcl::search::KdTree<PointT>::Ptr& surface_search_method);
+		/// Copy of the configured pcl detector for computing keypoints in parallel blocks (null -> detector cannot be safely copied and blocks are disabled)
+		virtual typename pcl::Keypoint<PointT, PointT>::Ptr cloneKeypointDetector() { return typename pcl::Keypoint<PointT, PointT>::Ptr(); }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </KeypointDetector-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		typename CloudPublisher<PointT>::Ptr getCloudPublisher() { return cloud_publisher_; }
 		typename pcl::Keypoint<PointT, PointT>::Ptr getKeypointDetector() { return keypoint_detector_; }
+		int getNumberOfThreads() const { return number_of_threads_; }
+		double getParallelBlockSize() const { return parallel_block_size_; }
+		/// Distance up to which the surface points influence the detection of a keypoint (overlap between parallel blocks and margin for region limited recomputation)
+		double getKeypointSupportRadius() const { return keypoint_support_radius_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		void setCloudPublisher(typename CloudPublisher<PointT>::Ptr& cloud_publisher) { cloud_publisher_ = cloud_publisher; }
 		void setKeypointDetector(typename pcl::Keypoint<PointT, PointT>::Ptr& keypoint_detector) { keypoint_detector_ = keypoint_detector; }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		/// <= 0 -> disables the computation of keypoints in parallel blocks
+		void setParallelBlockSize(double parallel_block_size) { parallel_block_size_ = parallel_block_size; }
+		void setKeypointSupportRadius(double keypoint_support_radius) { keypoint_support_radius_ = keypoint_support_radius; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 	// ========================================================================   </public-section>  ===========================================================================
 
 	// ========================================================================   <protected-section>   ========================================================================
 	protected:
+		/**
+		 * Splits the bounding box of the pointcloud in cubic blocks and detects the keypoints of each block in parallel (using a copy of the detector and the points
+		 * within the block expanded by the keypoint support radius), keeping only the keypoints inside each block
+		 * @return false if the detector cannot be copied or the cloud fits in a single block
+		 */
+		bool findKeypointsInParallelBlocks(const typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints_out, const typename pcl::PointCloud<PointT>::Ptr& surface);
+		void assignPointsToParallelBlocks(const pcl::PointCloud<PointT>& pointcloud, const Eigen::Array3f& blocks_origin, const Eigen::Array3i& number_of_blocks, float block_overlap, std::vector< std::vector<int> >& blocks_points_indices);
+
 		typename CloudPublisher<PointT>::Ptr cloud_publisher_;
 		typename pcl::Keypoint<PointT, PointT>::Ptr keypoint_detector_;
+		int number_of_threads_;
+		double parallel_block_size_;
+		double keypoint_support_radius_;
 	// ========================================================================   </protected-section>  ========================================================================
 };
 
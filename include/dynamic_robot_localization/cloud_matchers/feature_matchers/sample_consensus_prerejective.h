@@ -51,7 +51,7 @@
 //#include <pcl/recognition/cg/hough_3d.h>
 #include <pcl/recognition/impl/cg/hough_3d.hpp>
 #include <pcl/recognition/cg/geometric_consistency.h>
-//#include <pcl/recognition/impl/cg/geometric_consistency.hpp>
+#include <pcl/recognition/impl/cg/geometric_consistency.hpp>
 #include <pcl/registration/correspondence_rejection_poly.h>
 #include <pcl/registration/correspondence_rejection.h>
 #include <pcl/registration/correspondence_rejection_one_to_one.h>
@@ -124,6 +124,7 @@ namespace dynamic_robot_localization
       using PointCloudSourceConstPtr = typename PointCloudSource::ConstPtr;
 
       using PointCloudTarget = typename pcl::Registration<PointSource, PointTarget>::PointCloudTarget;
+      using PointCloudTargetConstPtr = typename PointCloudTarget::ConstPtr;
 
       using PointIndicesPtr = pcl::PointIndices::Ptr;
       using PointIndicesConstPtr = pcl::PointIndices::ConstPtr;
@@ -135,12 +136,23 @@ namespace dynamic_robot_localization
       using Ptr = std::shared_ptr<SampleConsensusPrerejective<PointSource, PointTarget, FeatureT> >;
       using ConstPtr = std::shared_ptr<const SampleConsensusPrerejective<PointSource, PointTarget, FeatureT> >;
 
-      using FeatureKdTreePtr = typename pcl::KdTreeFLANN<FeatureT>::Ptr;
+      using FeatureKdTreePtr = typename pcl::KdTree<FeatureT>::Ptr;
 
       using CorrespondenceRejectorPoly = pcl::registration::CorrespondenceRejectorPoly<PointSource, PointTarget>;
       using CorrespondenceRejectorPolyPtr = typename CorrespondenceRejectorPoly::Ptr;
       using CorrespondenceRejectorPolyConstPtr = typename CorrespondenceRejectorPoly::ConstPtr;
 
+      using Hough3DGrouping = pcl::Hough3DGrouping<PointTarget, PointSource, pcl::ReferenceFrame, pcl::ReferenceFrame>;
+      using Hough3DGroupingPtr = std::shared_ptr<Hough3DGrouping>;
+
+      /** \brief Method used for generating the pose hypotheses */
+      enum CorrespondencesGrouping
+      {
+        NO_GROUPING,            ///< pose hypotheses estimated from random samples of the descriptor correspondences
+        GEOMETRIC_CONSISTENCY,  ///< pose hypotheses estimated from clusters of descriptor correspondences with consistent pairwise distances
+        HOUGH_3D                ///< pose hypotheses estimated from clusters of descriptor correspondences that vote for the same position in a 3D hough space (requires local reference frames)
+      };
+
       /** \brief Constructor */
       SampleConsensusPrerejective ()
         : input_features_ ()
@@ -153,6 +165,15 @@ namespace dynamic_robot_localization
         , inlier_rmse_(0.0f)
         , accepted_transformations_(new std::vector<Matrix4>())
         , convergence_time_limit_seconds_(std::numeric_limits<double>::max())
+        , sample_consensus_rejector_inlier_threshold_(0.25)
+        , sample_consensus_rejector_maximum_iterations_(0)
+        , correspondences_grouping_(NO_GROUPING)
+        , grouping_maximum_descriptor_distance_(0.5)
+        , grouping_consensus_set_resolution_(0.05)
+        , grouping_consensus_set_minimum_size_(5)
+        , grouping_reference_frames_radius_(0.25)
+        , grouping_refinement_iterations_(3)
+        , hough_grouping_target_size_(0)
       {
         reg_name_ = "SampleConsensusPrerejective";
         correspondence_rejector_poly_->setSimilarityThreshold (0.6f);
@@ -165,6 +186,17 @@ namespace dynamic_robot_localization
       {
       }
 
+      /** \brief Provide a pointer to the target point cloud (discards the hough grouping trained with the previous target, even if the cloud was changed in place)
+        * \param cloud the target point cloud
+        */
+      void
+      setInputTarget (const PointCloudTargetConstPtr &cloud) override
+      {
+        pcl::Registration<PointSource, PointTarget>::setInputTarget (cloud);
+        hough_grouping_.reset ();
+        hough_grouping_target_.reset ();
+      }
+
       /** \brief Provide a shared pointer to the source point cloud's feature descriptors
         * \param features the source point cloud's features
         */
@@ -191,6 +223,17 @@ namespace dynamic_robot_localization
         return (target_features_);
       }
 
+      /** \brief Provide the search method used to find the correspondences between the source and target features
+        * (if it was already built with the target features, setTargetFeatures will not rebuild it)
+        * \param feature_tree the search method in the features space
+        */
+      inline void
+      setFeatureSearchMethod (const FeatureKdTreePtr &feature_tree)
+      {
+        if (feature_tree)
+          feature_tree_ = feature_tree;
+      }
+
       /** \brief Set the number of samples to use during each iteration
         * \param nr_samples the number of samples to use during each iteration
         */
@@ -278,6 +321,47 @@ namespace dynamic_robot_localization
 
       void setupCorrespondanceRejectors(std::vector< typename pcl::registration::CorrespondenceRejector::Ptr >& correspondence_rejectors);
 
+      /** \brief Set the inlier threshold of the sample consensus rejector that filters the correspondences of each pose hypothesis
+       * \param inlier_threshold maximum distance between the transformed source point and its corresponding target point
+       */
+      inline void
+      setSampleConsensusRejectorInlierThreshold (double inlier_threshold)
+      {
+        sample_consensus_rejector_inlier_threshold_ = inlier_threshold;
+        threads_correspondence_rejectors_.clear ();
+      }
+
+      /** \brief Set the number of iterations of the sample consensus rejector that filters the correspondences of each pose hypothesis
+       * \param maximum_iterations number of iterations (<= 0 disables the sample consensus rejector, leaving only the polygonal prerejection and the one to one rejector)
+       * (PCL rebuilds the sample consensus model for every hypothesis, so this is expensive and disabled by default)
+       */
+      inline void
+      setSampleConsensusRejectorMaximumIterations (int maximum_iterations)
+      {
+        sample_consensus_rejector_maximum_iterations_ = maximum_iterations;
+        threads_correspondence_rejectors_.clear ();
+      }
+
+      /** \brief Set the method used for generating the pose hypotheses
+       * (with grouping, only the few hypotheses given by the clusters of consistent descriptor correspondences are verified, instead of max_iterations_ random samples)
+       */
+      inline void setCorrespondencesGrouping(CorrespondencesGrouping correspondences_grouping) { correspondences_grouping_ = correspondences_grouping; }
+
+      /** \brief Maximum distance in the descriptors space for using a descriptor correspondence in the grouping (<= 0 -> no limit) */
+      inline void setGroupingMaximumDescriptorDistance(double maximum_descriptor_distance) { grouping_maximum_descriptor_distance_ = maximum_descriptor_distance; }
+
+      /** \brief Geometric consistency size or hough bin size (in meters) */
+      inline void setGroupingConsensusSetResolution(double consensus_set_resolution) { grouping_consensus_set_resolution_ = consensus_set_resolution; }
+
+      /** \brief Minimum number of correspondences of a cluster (or minimum number of votes of a hough bin) */
+      inline void setGroupingConsensusSetMinimumSize(int consensus_set_minimum_size) { grouping_consensus_set_minimum_size_ = consensus_set_minimum_size; }
+
+      /** \brief Radius used for computing the local reference frames of the hough grouping */
+      inline void setGroupingReferenceFramesRadius(double reference_frames_radius) { grouping_reference_frames_radius_ = reference_frames_radius; hough_grouping_.reset(); }
+
+      /** \brief Number of point to point refinement iterations (using the inliers) applied to each grouped pose hypothesis */
+      inline void setGroupingRefinementIterations(int refinement_iterations) { grouping_refinement_iterations_ = refinement_iterations; }
+
       std::shared_ptr< std::vector<Matrix4> > getAcceptedTransformations() { return accepted_transformations_; }
 
       inline void setConvergenceTimeLimitSeconds(double convergence_time_limit_seconds) { convergence_time_limit_seconds_ = convergence_time_limit_seconds; }
@@ -329,6 +413,48 @@ namespace dynamic_robot_localization
       void 
       getFitness (PointCloudSource& input_transformed, std::vector<int>& inliers, double& fitness_score);
 
+      /** \brief Generates and verifies pose hypotheses from random samples of descriptor correspondences
+        * \param lowest_error the error of the best pose hypothesis found so far (updated when a better one is found)
+        */
+      void
+      computeSampledPoseHypotheses (double& lowest_error);
+
+      /** \brief Generates pose hypotheses by clustering the descriptor correspondences (using geometric consistency or hough voting)
+        * and then verifies and refines them
+        * \param lowest_error the error of the best pose hypothesis found so far (updated when a better one is found)
+        */
+      void
+      computeGroupedPoseHypotheses (double& lowest_error);
+
+      /** \brief Estimates a new transformation from the correspondences between the inliers and their nearest neighbors in the target cloud
+        * \param input_transformed the input cloud transformed with the current transformation
+        * \param inliers indices of the inliers of the current transformation
+        * \param refined_transformation the refined transformation
+        * \return false if there were not enough correspondences
+        */
+      bool
+      refineTransformation (const PointCloudSource& input_transformed, const std::vector<int>& inliers, Matrix4& refined_transformation);
+
+      /** \brief Creates the correspondence rejectors of each thread (only once, they are reused across pose hypotheses and alignments, which avoids their allocation
+        * and configuration but not the work done inside them for each hypothesis) and updates them with the current source and target clouds
+        * \param number_of_threads the number of threads that will evaluate pose hypotheses
+        */
+      void
+      setupThreadsCorrespondenceRejectors (int number_of_threads);
+
+      /** \brief Fast prerejection of a pose hypothesis based on the similarity of the edge lengths of the polygons formed by the
+        * sample points and their corresponding points (the edge lengths must be preserved by a rigid transformation).
+        * With 3 samples all the triangle edges must be similar (as in \ref registration::CorrespondenceRejectorPoly "CorrespondenceRejectorPoly"),
+        * while with more samples only the correspondences without any similar adjacent edge are discarded.
+        * \param sample_indices the indices of the sample points
+        * \param corresponding_indices the indices of each sample's corresponding point in the target cloud
+        * \param correspondences the correspondences that were not discarded
+        * \return false if the pose hypothesis should be rejected
+        */
+      bool
+      prerejectCorrespondences (const std::vector<int> &sample_indices, const std::vector<int> &corresponding_indices,
+              pcl::Correspondences &correspondences) const;
+
       /** \brief The source point cloud's feature descriptors. */
       FeatureCloudConstPtr input_features_;
 
@@ -359,6 +485,24 @@ namespace dynamic_robot_localization
 
       pcl::StopWatch convergence_timer_;
       double convergence_time_limit_seconds_;
+
+      double sample_consensus_rejector_inlier_threshold_;
+      int sample_consensus_rejector_maximum_iterations_;
+
+      /** \brief Correspondence rejectors of each thread, reused across pose hypotheses */
+      std::vector< std::vector< typename pcl::registration::CorrespondenceRejector::Ptr > > threads_correspondence_rejectors_;
+
+      CorrespondencesGrouping correspondences_grouping_;
+      double grouping_maximum_descriptor_distance_;
+      double grouping_consensus_set_resolution_;
+      int grouping_consensus_set_minimum_size_;
+      double grouping_reference_frames_radius_;
+      int grouping_refinement_iterations_;
+
+      /** \brief Hough grouping trained with the target cloud (and its reference frames), reused while the target does not change */
+      Hough3DGroupingPtr hough_grouping_;
+      PointCloudTargetConstPtr hough_grouping_target_;
+      size_t hough_grouping_target_size_;
   };
 
 } /* namespace dynamic_robot_localization */
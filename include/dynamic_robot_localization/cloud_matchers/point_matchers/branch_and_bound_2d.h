@@ -0,0 +1,125 @@
+#pragma once
+
+/**\file branch_and_bound_2d.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+
+// external libs includes
+#include <Eigen/Core>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/cloud_matchers/cloud_matcher.h>
+#include <dynamic_robot_localization/common/likelihood_grid_2d.h>
+#include <dynamic_robot_localization/common/math_utils.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// ###########################################################################   BranchAndBound2D   ###########################################################################
+/**
+ * \brief Global 2D scan matcher (x, y, yaw) that finds the pose with the highest mean likelihood of the ambient cloud points in a likelihood grid of the reference cloud.
+ * The search window is explored with a depth first branch and bound over a precomputed multi resolution grid (in which each cell is an upper bound of the
+ * likelihoods of the cells it covers), which gives the same result as an exhaustive search over all the (discretized) poses, but evaluating only a small fraction of them.
+ * The rotations are performed around the centroid of the ambient cloud and the branches of the coarsest level are explored in parallel.
+ */
+template <typename PointT>
+class BranchAndBound2D : public CloudMatcher<PointT> {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< BranchAndBound2D<PointT> >;
+		using ConstPtr = std::shared_ptr< const BranchAndBound2D<PointT> >;
+		using ScanCells = typename LikelihoodGrid2D<PointT>::ScanCells;
+		using Points2D = std::vector<Eigen::Vector2f, Eigen::aligned_allocator<Eigen::Vector2f> >;
+
+		struct Candidate {
+			int angle_index;
+			int offset_x;
+			int offset_y;
+			float score;
+			bool operator>(const Candidate& other) const { return score > other.score; }
+		};
+
+		struct SearchWindow {
+			int minimum_offset_x, maximum_offset_x;
+			int minimum_offset_y, maximum_offset_y;
+		};
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		BranchAndBound2D();
+		virtual ~BranchAndBound2D() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <BranchAndBound2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		virtual void setupReferenceCloud(typename pcl::PointCloud<PointT>::Ptr& reference_cloud, typename pcl::PointCloud<PointT>::Ptr& reference_cloud_keypoints,
+				typename pcl::search::KdTree<PointT>::Ptr& search_method);
+		virtual bool registerCloud(typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud, typename pcl::search::KdTree<PointT>::Ptr& ambient_pointcloud_search_method,
+				typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints, tf2::Transform& best_pose_correction_out, std::vector< tf2::Transform >& accepted_pose_corrections_out,
+				typename pcl::PointCloud<PointT>::Ptr& pointcloud_registered_out, bool return_aligned_keypoints = false);
+		/// Finds the correction (rotation around the centroid of the cloud followed by a translation) with the highest score inside the search window
+		virtual bool findBestPose(const pcl::PointCloud<PointT>& ambient_pointcloud, Eigen::Matrix4f& transformation_out, float& score_out);
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </BranchAndBound2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual std::string getCloudMatcherName() { return "BranchAndBound2D"; }
+		virtual bool registrationRequiresNormalsOnAmbientPointCloud() { return false; }
+		virtual std::string getMatcherConvergenceState() { return "Best score: " + std::to_string(best_score_); }
+		const typename LikelihoodGrid2D<PointT>::Ptr& getLikelihoodGrid() const { return likelihood_grid_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		void setupLikelihoodGrid(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, const std::string& configuration_namespace);
+		/// Finite points projected to the xy plane (returns false if there is less than 3 points)
+		bool extractPoints(const pcl::PointCloud<PointT>& pointcloud, Points2D& points_out, Eigen::Vector2f& centroid_out) const;
+		double computeAngularStep(const Points2D& points, const Eigen::Vector2f& rotation_center) const;
+		/// Rotation around the rotation center followed by a translation of the given number of cells
+		Eigen::Matrix4f computeCorrection(float angle, int offset_x, int offset_y, const Eigen::Vector2f& rotation_center) const;
+		void computeScanCells(const Points2D& points, const Eigen::Vector2f& rotation_center, float angle, ScanCells& scan_cells_out) const;
+		void branchAndBound(const std::vector<ScanCells>& scans_cells, const SearchWindow& search_window, const Candidate& candidate, int level,
+				std::atomic<float>& best_score, Candidate& best_candidate) const;
+
+		typename LikelihoodGrid2D<PointT>::Ptr likelihood_grid_;
+		int branch_and_bound_depth_;
+		double linear_search_window_;
+		double angular_search_window_;
+		double angular_resolution_;
+		double minimum_score_;
+		int number_of_threads_;
+		float best_score_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/impl/branch_and_bound_2d.hpp>
+#endif
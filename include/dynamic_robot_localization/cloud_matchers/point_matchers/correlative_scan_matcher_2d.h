@@ -0,0 +1,72 @@
+#pragma once
+
+/**\file correlative_scan_matcher_2d.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+
+// external libs includes
+#include <Eigen/Core>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/branch_and_bound_2d.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// #######################################################################   CorrelativeScanMatcher2D   ########################################################################
+/**
+ * \brief Local 2D scan matcher (x, y, yaw) that exhaustively scores all the poses of a bounded window around the current pose estimate on the full resolution likelihood grid
+ * of the reference cloud (the rotations are evaluated in parallel).
+ * It has a bounded computation time and does not suffer from local minima inside the window, and as such, it is meant to be used in the tracking recovery matchers
+ * for seeding the point matchers that are applied after it (such as ICP).
+ */
+template <typename PointT>
+class CorrelativeScanMatcher2D : public BranchAndBound2D<PointT> {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< CorrelativeScanMatcher2D<PointT> >;
+		using ConstPtr = std::shared_ptr< const CorrelativeScanMatcher2D<PointT> >;
+		using Points2D = typename BranchAndBound2D<PointT>::Points2D;
+		using ScanCells = typename BranchAndBound2D<PointT>::ScanCells;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		CorrelativeScanMatcher2D();
+		virtual ~CorrelativeScanMatcher2D() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <CorrelativeScanMatcher2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		/// Finds the correction with the highest score inside the window (ties are resolved in favor of the smallest correction)
+		virtual bool findBestPose(const pcl::PointCloud<PointT>& ambient_pointcloud, Eigen::Matrix4f& transformation_out, float& score_out);
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </CorrelativeScanMatcher2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual std::string getCloudMatcherName() { return "CorrelativeScanMatcher2D"; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/impl/correlative_scan_matcher_2d.hpp>
+#endif
@@ -0,0 +1,298 @@
+/**\file branch_and_bound_2d.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/branch_and_bound_2d.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+BranchAndBound2D<PointT>::BranchAndBound2D() :
+	likelihood_grid_(new LikelihoodGrid2D<PointT>()),
+	branch_and_bound_depth_(7),
+	linear_search_window_(-1.0),
+	angular_search_window_(M_PI),
+	angular_resolution_(-1.0),
+	minimum_score_(0.55),
+	number_of_threads_(0),
+	best_score_(0.0f) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <BranchAndBound2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void BranchAndBound2D<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	CloudMatcher<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	private_node_handle->param(configuration_namespace + "branch_and_bound_depth", branch_and_bound_depth_, 7);
+	private_node_handle->param(configuration_namespace + "linear_search_window", linear_search_window_, -1.0);
+	private_node_handle->param(configuration_namespace + "angular_search_window", angular_search_window_, M_PI);
+	private_node_handle->param(configuration_namespace + "angular_resolution", angular_resolution_, -1.0);
+	private_node_handle->param(configuration_namespace + "minimum_score", minimum_score_, 0.55);
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads_, 0);
+	branch_and_bound_depth_ = std::max(branch_and_bound_depth_, 1);
+	setupLikelihoodGrid(node_handle, private_node_handle, configuration_namespace + "likelihood_grid/");
+}
+
+
+template<typename PointT>
+void BranchAndBound2D<PointT>::setupReferenceCloud(typename pcl::PointCloud<PointT>::Ptr& reference_cloud, typename pcl::PointCloud<PointT>::Ptr& reference_cloud_keypoints,
+		typename pcl::search::KdTree<PointT>::Ptr& search_method) {
+	CloudMatcher<PointT>::setupReferenceCloud(reference_cloud, reference_cloud_keypoints, search_method);
+	if (reference_cloud && likelihood_grid_->setupReferenceCloud(*reference_cloud)) {
+		likelihood_grid_->computeMultiResolutionLevels(branch_and_bound_depth_);
+	}
+}
+
+
+template<typename PointT>
+bool BranchAndBound2D<PointT>::registerCloud(typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud,
+		typename pcl::search::KdTree<PointT>::Ptr& ambient_pointcloud_search_method,
+		typename pcl::PointCloud<PointT>::Ptr& pointcloud_keypoints,
+		tf2::Transform& best_pose_correction_out, std::vector< tf2::Transform >& accepted_pose_corrections_out, typename pcl::PointCloud<PointT>::Ptr& pointcloud_registered_out, bool return_aligned_keypoints) {
+	accepted_pose_corrections_out.clear();
+	CloudMatcher<PointT>::cloud_align_time_ms_ = 0;
+
+	if (!likelihood_grid_->isValid()) {
+		ROS_WARN("Discarded ambient cloud because there is no reference point cloud for performing the branch and bound search.");
+		return false;
+	}
+
+	bool use_keypoints = CloudMatcher<PointT>::match_only_keypoints_ && pointcloud_keypoints && !pointcloud_keypoints->empty();
+	const pcl::PointCloud<PointT>& matching_pointcloud = (use_keypoints ? *pointcloud_keypoints : *ambient_pointcloud);
+	if (matching_pointcloud.size() < 3) {
+		ROS_WARN("Discarded ambient cloud with less than 3 points before performing the branch and bound search.");
+		return false;
+	}
+
+	PerformanceTimer performance_timer;
+	performance_timer.start();
+
+	Eigen::Matrix4f final_transformation;
+	bool pose_found = findBestPose(matching_pointcloud, final_transformation, best_score_);
+	CloudMatcher<PointT>::cloud_align_time_ms_ = performance_timer.getElapsedTimeInMilliSec();
+	if (!pose_found) { return false; }
+
+	pcl::transformPointCloudWithNormals(*ambient_pointcloud, *pointcloud_registered_out, final_transformation);
+
+	if (CloudMatcher<PointT>::postProcessRegistrationMatrix(ambient_pointcloud, final_transformation, best_pose_correction_out)) {
+		pointcloud_registered_out->header = ambient_pointcloud->header;
+
+		if (pointcloud_keypoints && !pointcloud_keypoints->empty()) {
+			pcl::transformPointCloudWithNormals(*pointcloud_keypoints, *pointcloud_keypoints, final_transformation);
+		}
+
+		if (CloudMatcher<PointT>::cloud_publisher_ && pointcloud_registered_out) {
+			CloudMatcher<PointT>::cloud_publisher_->publishPointCloud(*pointcloud_registered_out);
+		}
+
+		if (CloudMatcher<PointT>::reference_cloud_publisher_ && CloudMatcher<PointT>::reference_cloud_) {
+			CloudMatcher<PointT>::reference_cloud_publisher_->setCloudPublishStamp(ambient_pointcloud->header.stamp);
+			CloudMatcher<PointT>::reference_cloud_publisher_->publishPointCloud(*CloudMatcher<PointT>::reference_cloud_);
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+
+template<typename PointT>
+bool BranchAndBound2D<PointT>::findBestPose(const pcl::PointCloud<PointT>& ambient_pointcloud, Eigen::Matrix4f& transformation_out, float& score_out) {
+	score_out = 0.0f;
+	Points2D points;
+	Eigen::Vector2f rotation_center;
+	if (!extractPoints(ambient_pointcloud, points, rotation_center)) { return false; }
+
+	const double cell_resolution = likelihood_grid_->getCellResolution();
+	const double angular_step = computeAngularStep(points, rotation_center);
+	const int number_of_angular_steps = (angular_search_window_ > 0.0 ? (int)std::ceil(std::min(angular_search_window_, M_PI) / angular_step) : 0);
+
+	std::vector<ScanCells> scans_cells(2 * number_of_angular_steps + 1);
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)scans_cells.size(); ++i) {
+		computeScanCells(points, rotation_center, (float)((i - number_of_angular_steps) * angular_step), scans_cells[i]);
+	}
+
+	// offsets (in cells) of the search window (the whole reference grid when the linear search window is not specified)
+	SearchWindow search_window;
+	if (linear_search_window_ > 0.0) {
+		int window_cells = (int)std::ceil(linear_search_window_ / cell_resolution);
+		search_window.minimum_offset_x = -window_cells; search_window.maximum_offset_x = window_cells;
+		search_window.minimum_offset_y = -window_cells; search_window.maximum_offset_y = window_cells;
+	} else {
+		typename LikelihoodGrid2D<PointT>::CellCoordinates center_cell = likelihood_grid_->computeCellCoordinates(rotation_center.x(), rotation_center.y());
+		search_window.minimum_offset_x = -center_cell.x(); search_window.maximum_offset_x = likelihood_grid_->getSizeX() - 1 - center_cell.x();
+		search_window.minimum_offset_y = -center_cell.y(); search_window.maximum_offset_y = likelihood_grid_->getSizeY() - 1 - center_cell.y();
+	}
+
+	if (search_window.minimum_offset_x > search_window.maximum_offset_x || search_window.minimum_offset_y > search_window.maximum_offset_y) { return false; }
+
+	// candidates of the coarsest level, sorted by score for finding good solutions early (which allows to prune more branches)
+	const int top_level = std::min(branch_and_bound_depth_, likelihood_grid_->getNumberOfLevels()) - 1;
+	const int top_level_step = 1 << top_level;
+	std::vector<Candidate> candidates;
+	for (int angle_index = 0; angle_index < (int)scans_cells.size(); ++angle_index) {
+		for (int offset_y = search_window.minimum_offset_y; offset_y <= search_window.maximum_offset_y; offset_y += top_level_step) {
+			for (int offset_x = search_window.minimum_offset_x; offset_x <= search_window.maximum_offset_x; offset_x += top_level_step) {
+				Candidate candidate;
+				candidate.angle_index = angle_index;
+				candidate.offset_x = offset_x;
+				candidate.offset_y = offset_y;
+				candidate.score = 0.0f;
+				candidates.push_back(candidate);
+			}
+		}
+	}
+
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)candidates.size(); ++i) {
+		candidates[i].score = likelihood_grid_->computeScore(scans_cells[candidates[i].angle_index], candidates[i].offset_x, candidates[i].offset_y, top_level);
+	}
+	std::sort(candidates.begin(), candidates.end(), std::greater<Candidate>());
+
+	std::atomic<float> best_score((float)minimum_score_);
+	Candidate best_candidate;
+	best_candidate.angle_index = -1;
+
+	#pragma omp parallel for schedule(dynamic, 1) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)candidates.size(); ++i) {
+		branchAndBound(scans_cells, search_window, candidates[i], top_level, best_score, best_candidate);
+	}
+
+	if (best_candidate.angle_index < 0) {
+		ROS_DEBUG_STREAM("Branch and bound did not find any pose with score above " << minimum_score_ << " (" << candidates.size() << " candidates in the coarsest level and " << scans_cells.size() << " angles)");
+		return false;
+	}
+
+	score_out = best_candidate.score;
+	const float angle = (float)((best_candidate.angle_index - number_of_angular_steps) * angular_step);
+	transformation_out = computeCorrection(angle, best_candidate.offset_x, best_candidate.offset_y, rotation_center);
+
+	ROS_DEBUG_STREAM("Branch and bound found a pose with score " << score_out << " (yaw correction: " << angle << " rad, translation correction: ["
+			<< best_candidate.offset_x * cell_resolution << ", " << best_candidate.offset_y * cell_resolution << "] m)");
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </BranchAndBound2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+void BranchAndBound2D<PointT>::setupLikelihoodGrid(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, const std::string& configuration_namespace) {
+	likelihood_grid_->setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	likelihood_grid_->setNumberOfThreads(number_of_threads_);
+	if (CloudMatcher<PointT>::reference_cloud_ && likelihood_grid_->setupReferenceCloud(*CloudMatcher<PointT>::reference_cloud_)) {
+		likelihood_grid_->computeMultiResolutionLevels(branch_and_bound_depth_);
+	}
+}
+
+
+template<typename PointT>
+bool BranchAndBound2D<PointT>::extractPoints(const pcl::PointCloud<PointT>& pointcloud, Points2D& points_out, Eigen::Vector2f& centroid_out) const {
+	points_out.clear();
+	points_out.reserve(pointcloud.size());
+	centroid_out = Eigen::Vector2f(0.0f, 0.0f);
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		if (pcl::isFinite(pointcloud[i])) {
+			points_out.push_back(Eigen::Vector2f(pointcloud[i].x, pointcloud[i].y));
+			centroid_out += points_out.back();
+		}
+	}
+	if (points_out.size() < 3) { return false; }
+	centroid_out /= (float)points_out.size();
+	return true;
+}
+
+
+template<typename PointT>
+double BranchAndBound2D<PointT>::computeAngularStep(const Points2D& points, const Eigen::Vector2f& rotation_center) const {
+	if (angular_resolution_ > 0.0) { return angular_resolution_; }
+
+	// angular step that moves the farthest point by at most one cell
+	const double cell_resolution = likelihood_grid_->getCellResolution();
+	float maximum_range = 0.0f;
+	for (size_t i = 0; i < points.size(); ++i) {
+		maximum_range = std::max(maximum_range, (points[i] - rotation_center).norm());
+	}
+	return (maximum_range > cell_resolution ? std::acos(1.0 - (cell_resolution * cell_resolution) / (2.0 * maximum_range * maximum_range)) : M_PI);
+}
+
+
+template<typename PointT>
+Eigen::Matrix4f BranchAndBound2D<PointT>::computeCorrection(float angle, int offset_x, int offset_y, const Eigen::Vector2f& rotation_center) const {
+	Eigen::Matrix2f rotation;
+	rotation << std::cos(angle), -std::sin(angle),
+			std::sin(angle), std::cos(angle);
+	const double cell_resolution = likelihood_grid_->getCellResolution();
+	Eigen::Vector2f translation((float)(offset_x * cell_resolution), (float)(offset_y * cell_resolution));
+	Eigen::Matrix4f correction = Eigen::Matrix4f::Identity();
+	correction.block<2, 2>(0, 0) = rotation;
+	correction.block<2, 1>(0, 3) = rotation_center + translation - rotation * rotation_center;
+	return correction;
+}
+
+
+template<typename PointT>
+void BranchAndBound2D<PointT>::computeScanCells(const Points2D& points, const Eigen::Vector2f& rotation_center, float angle, ScanCells& scan_cells_out) const {
+	Eigen::Matrix2f rotation;
+	rotation << std::cos(angle), -std::sin(angle),
+			std::sin(angle), std::cos(angle);
+	scan_cells_out.clear();
+	scan_cells_out.reserve(points.size());
+	for (size_t i = 0; i < points.size(); ++i) {
+		Eigen::Vector2f rotated_point = rotation * (points[i] - rotation_center) + rotation_center;
+		scan_cells_out.push_back(likelihood_grid_->computeCellCoordinates(rotated_point.x(), rotated_point.y()));
+	}
+}
+
+
+template<typename PointT>
+void BranchAndBound2D<PointT>::branchAndBound(const std::vector<ScanCells>& scans_cells, const SearchWindow& search_window, const Candidate& candidate, int level,
+		std::atomic<float>& best_score, Candidate& best_candidate) const {
+	// the score of a candidate is an upper bound of the scores of all the poses inside its branch
+	if (candidate.score <= best_score.load()) { return; }
+
+	if (level == 0) {
+		#pragma omp critical
+		{
+			if (candidate.score > best_score.load()) {
+				best_score.store(candidate.score);
+				best_candidate = candidate;
+			}
+		}
+		return;
+	}
+
+	const int child_step = 1 << (level - 1);
+	std::vector<Candidate> children;
+	children.reserve(4);
+	for (int offset_y = candidate.offset_y; offset_y <= std::min(candidate.offset_y + child_step, search_window.maximum_offset_y); offset_y += child_step) {
+		for (int offset_x = candidate.offset_x; offset_x <= std::min(candidate.offset_x + child_step, search_window.maximum_offset_x); offset_x += child_step) {
+			Candidate child;
+			child.angle_index = candidate.angle_index;
+			child.offset_x = offset_x;
+			child.offset_y = offset_y;
+			child.score = likelihood_grid_->computeScore(scans_cells[candidate.angle_index], offset_x, offset_y, level - 1);
+			if (child.score > best_score.load()) {
+				children.push_back(child);
+			}
+		}
+	}
+
+	std::sort(children.begin(), children.end(), std::greater<Candidate>());
+	for (size_t i = 0; i < children.size(); ++i) {
+		branchAndBound(scans_cells, search_window, children[i], level - 1, best_score, best_candidate);
+	}
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,114 @@
+/**\file correlative_scan_matcher_2d.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/correlative_scan_matcher_2d.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+CorrelativeScanMatcher2D<PointT>::CorrelativeScanMatcher2D() : BranchAndBound2D<PointT>() {
+	BranchAndBound2D<PointT>::branch_and_bound_depth_ = 1;
+	BranchAndBound2D<PointT>::linear_search_window_ = 0.5;
+	BranchAndBound2D<PointT>::angular_search_window_ = 0.35;
+	BranchAndBound2D<PointT>::minimum_score_ = 0.5;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <CorrelativeScanMatcher2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void CorrelativeScanMatcher2D<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	CloudMatcher<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	private_node_handle->param(configuration_namespace + "linear_search_window", BranchAndBound2D<PointT>::linear_search_window_, 0.5);
+	private_node_handle->param(configuration_namespace + "angular_search_window", BranchAndBound2D<PointT>::angular_search_window_, 0.35);
+	private_node_handle->param(configuration_namespace + "angular_resolution", BranchAndBound2D<PointT>::angular_resolution_, -1.0);
+	private_node_handle->param(configuration_namespace + "minimum_score", BranchAndBound2D<PointT>::minimum_score_, 0.5);
+	private_node_handle->param(configuration_namespace + "number_of_threads", BranchAndBound2D<PointT>::number_of_threads_, 0);
+	BranchAndBound2D<PointT>::branch_and_bound_depth_ = 1; // only the full resolution grid is used
+	BranchAndBound2D<PointT>::setupLikelihoodGrid(node_handle, private_node_handle, configuration_namespace + "likelihood_grid/");
+}
+
+
+template<typename PointT>
+bool CorrelativeScanMatcher2D<PointT>::findBestPose(const pcl::PointCloud<PointT>& ambient_pointcloud, Eigen::Matrix4f& transformation_out, float& score_out) {
+	score_out = 0.0f;
+	Points2D points;
+	Eigen::Vector2f rotation_center;
+	if (!BranchAndBound2D<PointT>::extractPoints(ambient_pointcloud, points, rotation_center)) { return false; }
+
+	const typename LikelihoodGrid2D<PointT>::Ptr& likelihood_grid = BranchAndBound2D<PointT>::likelihood_grid_;
+	const double cell_resolution = likelihood_grid->getCellResolution();
+	const double angular_step = BranchAndBound2D<PointT>::computeAngularStep(points, rotation_center);
+	const double angular_search_window = BranchAndBound2D<PointT>::angular_search_window_;
+	const double linear_search_window = BranchAndBound2D<PointT>::linear_search_window_;
+	const int number_of_angular_steps = (angular_search_window > 0.0 ? (int)std::ceil(std::min(angular_search_window, M_PI) / angular_step) : 0);
+	const int window_cells = (linear_search_window > 0.0 ? (int)std::ceil(linear_search_window / cell_resolution) : 0);
+	const int number_of_threads = BranchAndBound2D<PointT>::number_of_threads_;
+
+	// the search window is centered in the current pose estimate (the ambient cloud is already in the map frame)
+	float best_score = (float)BranchAndBound2D<PointT>::minimum_score_;
+	int best_angle_index = 0, best_offset_x = 0, best_offset_y = 0, best_correction_cost = -1;
+
+	#pragma omp parallel for schedule(dynamic, 1) num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+	for (int angle_index = -number_of_angular_steps; angle_index <= number_of_angular_steps; ++angle_index) {
+		ScanCells scan_cells;
+		BranchAndBound2D<PointT>::computeScanCells(points, rotation_center, (float)(angle_index * angular_step), scan_cells);
+
+		float angle_best_score = -1.0f;
+		int angle_best_offset_x = 0, angle_best_offset_y = 0, angle_best_correction_cost = 0;
+		for (int offset_y = -window_cells; offset_y <= window_cells; ++offset_y) {
+			for (int offset_x = -window_cells; offset_x <= window_cells; ++offset_x) {
+				float score = likelihood_grid->computeScore(scan_cells, offset_x, offset_y);
+				int correction_cost = offset_x * offset_x + offset_y * offset_y + angle_index * angle_index;
+				if (score > angle_best_score || (score == angle_best_score && correction_cost < angle_best_correction_cost)) {
+					angle_best_score = score;
+					angle_best_offset_x = offset_x;
+					angle_best_offset_y = offset_y;
+					angle_best_correction_cost = correction_cost;
+				}
+			}
+		}
+
+		#pragma omp critical
+		{
+			if (angle_best_score > best_score || (angle_best_score == best_score && best_correction_cost >= 0 && angle_best_correction_cost < best_correction_cost)) {
+				best_score = angle_best_score;
+				best_angle_index = angle_index;
+				best_offset_x = angle_best_offset_x;
+				best_offset_y = angle_best_offset_y;
+				best_correction_cost = angle_best_correction_cost;
+			}
+		}
+	}
+
+	if (best_correction_cost < 0) {
+		ROS_DEBUG_STREAM("Correlative scan matcher did not find any pose with score above " << BranchAndBound2D<PointT>::minimum_score_ << " ("
+				<< (2 * number_of_angular_steps + 1) << " angles and " << (2 * window_cells + 1) << "x" << (2 * window_cells + 1) << " translations)");
+		return false;
+	}
+
+	score_out = best_score;
+	const float angle = (float)(best_angle_index * angular_step);
+	transformation_out = BranchAndBound2D<PointT>::computeCorrection(angle, best_offset_x, best_offset_y, rotation_center);
+
+	ROS_DEBUG_STREAM("Correlative scan matcher found a pose with score " << score_out << " (yaw correction: " << angle << " rad, translation correction: ["
+			<< best_offset_x * cell_resolution << ", " << best_offset_y * cell_resolution << "] m)");
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </CorrelativeScanMatcher2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
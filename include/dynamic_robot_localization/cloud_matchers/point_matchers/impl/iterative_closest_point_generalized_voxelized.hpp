@@ -0,0 +1,269 @@
+/**\file iterative_closest_point_generalized_voxelized.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_generalized_voxelized.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// ############################################################   IterativeClosestPointGeneralizedVoxelizedRegistration   ######################################################
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::IterativeClosestPointGeneralizedVoxelizedRegistration() :
+	voxel_map_(new VoxelCovarianceMap<PointT>()),
+	voxel_map_update_required_(true),
+	neighbor_search_method_(VoxelCovarianceMap<PointT>::DIRECT1),
+	use_normals_for_source_covariances_(false),
+	maximum_step_length_(1.0),
+	number_of_threads_(0),
+	number_of_correspondences_(0),
+	root_mean_square_error_of_correspondences_(-1.0) {
+	pcl::Registration<PointT, PointT, float>::reg_name_ = "IterativeClosestPointGeneralizedVoxelizedRegistration";
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <IterativeClosestPointGeneralizedVoxelizedRegistration-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::setInputTarget(const PointCloudTargetConstPtr& cloud) {
+	pcl::Registration<PointT, PointT, float>::setInputTarget(cloud);
+	voxel_map_update_required_ = true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </IterativeClosestPointGeneralizedVoxelizedRegistration-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+void IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::computeTransformation(PointCloudSource& output, const Matrix4& guess) {
+	using RegistrationBase = pcl::Registration<PointT, PointT, float>;
+	RegistrationBase::nr_iterations_ = 0;
+	RegistrationBase::converged_ = false;
+	number_of_correspondences_ = 0;
+	root_mean_square_error_of_correspondences_ = -1.0;
+
+	// only done once after each setInputTarget (and only integrates the new points when the reference cloud grew since the last update)
+	if (voxel_map_update_required_) {
+		voxel_map_->setNumberOfThreads(number_of_threads_);
+		voxel_map_->updateReferenceCloud(RegistrationBase::target_, RegistrationBase::tree_);
+		voxel_map_update_required_ = false;
+	}
+
+	if (voxel_map_->empty()) {
+		PCL_ERROR("[%s::computeTransformation] The voxel map of the target cloud is empty!\n", RegistrationBase::getClassName().c_str());
+		return;
+	}
+
+	voxel_map_->computePointCovariances(RegistrationBase::input_, RegistrationBase::tree_reciprocal_, use_normals_for_source_covariances_, source_covariances_);
+
+	Eigen::Matrix4d transformation = guess.template cast<double>();
+	Matrix6d hessian;
+	Vector6d gradient;
+	double squared_distances_sum = 0.0;
+	bool transformation_updated_after_derivatives = false;
+
+	while (RegistrationBase::nr_iterations_ < RegistrationBase::max_iterations_) {
+		number_of_correspondences_ = computeDerivatives(transformation, hessian, gradient, squared_distances_sum);
+		transformation_updated_after_derivatives = false;
+		if (number_of_correspondences_ < 6) {
+			PCL_DEBUG("[%s::computeTransformation] Not enough source points were matched to the voxel map (%d)!\n", RegistrationBase::getClassName().c_str(), number_of_correspondences_);
+			return;
+		}
+		root_mean_square_error_of_correspondences_ = std::sqrt(squared_distances_sum / (double)number_of_correspondences_);
+
+		bool converged = false;
+		if (!math_utils::applyGaussNewtonPoseUpdate(hessian, gradient, maximum_step_length_, false,
+				RegistrationBase::transformation_epsilon_, RegistrationBase::transformation_rotation_epsilon_, transformation, converged)) {
+			PCL_DEBUG("[%s::computeTransformation] Singular Hessian!\n", RegistrationBase::getClassName().c_str());
+			break;
+		}
+
+		transformation_updated_after_derivatives = true;
+		++RegistrationBase::nr_iterations_;
+		if (converged) { break; }
+	}
+
+	// the correspondences statistics must be given for the final transformation (and not for the one before the last pose update)
+	if (transformation_updated_after_derivatives) {
+		number_of_correspondences_ = computeDerivatives(transformation, hessian, gradient, squared_distances_sum);
+		root_mean_square_error_of_correspondences_ = number_of_correspondences_ > 0 ? std::sqrt(squared_distances_sum / (double)number_of_correspondences_) : -1.0;
+	}
+
+	RegistrationBase::converged_ = true;
+	RegistrationBase::final_transformation_ = transformation.cast<float>();
+	RegistrationBase::transformation_ = RegistrationBase::final_transformation_;
+	pcl::transformPointCloud(*RegistrationBase::input_, output, RegistrationBase::final_transformation_);
+}
+
+
+template<typename PointT>
+int IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::computeDerivatives(const Eigen::Matrix4d& transformation, Matrix6d& hessian, Vector6d& gradient, double& squared_distances_sum) const {
+	using RegistrationBase = pcl::Registration<PointT, PointT, float>;
+	const pcl::PointCloud<PointT>& source_cloud = *RegistrationBase::input_;
+	const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+	const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
+	const int number_of_points = (int)source_cloud.size();
+
+	hessian.setZero();
+	gradient.setZero();
+	squared_distances_sum = 0.0;
+	int number_of_correspondences = 0;
+
+	#pragma omp parallel num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	{
+		Matrix6d thread_hessian = Matrix6d::Zero();
+		Vector6d thread_gradient = Vector6d::Zero();
+		double thread_squared_distances_sum = 0.0;
+		int thread_number_of_correspondences = 0;
+		const typename VoxelCovarianceMap<PointT>::Voxel* neighbors[VoxelCovarianceMap<PointT>::MAXIMUM_NUMBER_OF_NEIGHBORS];
+		Eigen::Matrix<double, 3, 6> point_jacobian;
+		point_jacobian.block<3, 3>(0, 0).setIdentity();
+
+		#pragma omp for schedule(static)
+		for (int i = 0; i < number_of_points; ++i) {
+			const PointT& source_point = source_cloud[i];
+			if (!pcl::isFinite(source_point)) { continue; }
+
+			Eigen::Vector3d point = rotation * Eigen::Vector3d(source_point.x, source_point.y, source_point.z) + translation;
+			int number_of_neighbors = voxel_map_->findNeighborVoxels(point, neighbor_search_method_, neighbors);
+			if (number_of_neighbors == 0) { continue; }
+
+			// derivative of the point in relation to a pose update [translation, rotation] applied on the left of the transformation
+			point_jacobian(0, 3) = 0.0;        point_jacobian(0, 4) = point.z();  point_jacobian(0, 5) = -point.y();
+			point_jacobian(1, 3) = -point.z(); point_jacobian(1, 4) = 0.0;        point_jacobian(1, 5) = point.x();
+			point_jacobian(2, 3) = point.y();  point_jacobian(2, 4) = -point.x(); point_jacobian(2, 5) = 0.0;
+
+			const Eigen::Matrix3d rotated_source_covariance = rotation * source_covariances_[i] * rotation.transpose();
+			for (int n = 0; n < number_of_neighbors; ++n) {
+				// mahalanobis distance with the combined covariances of the voxel and the source point, weighted by the number of reference points in the voxel [Koide 2021]
+				const Eigen::Vector3d point_to_mean = point - neighbors[n]->mean;
+				const Eigen::Matrix3d information = (neighbors[n]->covariance + rotated_source_covariance).inverse();
+				if (!information.allFinite()) { continue; }
+
+				const double weight = (double)neighbors[n]->number_of_points;
+				const Eigen::Matrix<double, 3, 6> information_times_jacobian = information * point_jacobian;
+				thread_gradient.noalias() += weight * (point_jacobian.transpose() * (information * point_to_mean));
+				thread_hessian.noalias() += weight * (point_jacobian.transpose() * information_times_jacobian);
+				thread_squared_distances_sum += point_to_mean.squaredNorm();
+				++thread_number_of_correspondences;
+			}
+		}
+
+		#pragma omp critical
+		{
+			hessian += thread_hessian;
+			gradient += thread_gradient;
+			squared_distances_sum += thread_squared_distances_sum;
+			number_of_correspondences += thread_number_of_correspondences;
+		}
+	}
+
+	return number_of_correspondences;
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+
+
+// ##################################################################   IterativeClosestPointGeneralizedVoxelized   ############################################################
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <IterativeClosestPointGeneralizedVoxelized-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void IterativeClosestPointGeneralizedVoxelized<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr matcher(new IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>());
+
+	double transformation_rotation_epsilon;
+	private_node_handle->param(configuration_namespace + "transformation_rotation_epsilon", transformation_rotation_epsilon, 0.0);
+	matcher->setTransformationRotationEpsilon(transformation_rotation_epsilon);
+
+	int number_of_threads;
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads, 0);
+	matcher->setNumberOfThreads(number_of_threads);
+	voxel_map_->setNumberOfThreads(number_of_threads);
+
+	double voxel_grid_resolution;
+	private_node_handle->param(configuration_namespace + "voxel_grid_resolution", voxel_grid_resolution, 1.0);
+	voxel_map_->setResolution(voxel_grid_resolution);
+
+	int minimum_number_of_points_per_voxel;
+	private_node_handle->param(configuration_namespace + "minimum_number_of_points_per_voxel", minimum_number_of_points_per_voxel, 1);
+	voxel_map_->setMinimumNumberOfPointsPerVoxel(minimum_number_of_points_per_voxel);
+
+	int number_of_neighbors_for_covariance_estimation;
+	private_node_handle->param(configuration_namespace + "number_of_neighbors_for_covariance_estimation", number_of_neighbors_for_covariance_estimation, 20);
+	voxel_map_->setNumberOfNeighborsForCovarianceEstimation(number_of_neighbors_for_covariance_estimation);
+
+	double covariance_epsilon;
+	private_node_handle->param(configuration_namespace + "covariance_epsilon", covariance_epsilon, 0.001);
+	voxel_map_->setCovarianceEpsilon(covariance_epsilon);
+
+	bool use_normals_for_reference_covariances;
+	private_node_handle->param(configuration_namespace + "use_normals_for_reference_covariances", use_normals_for_reference_covariances, true);
+	voxel_map_->setUseNormalsForReferenceCovariances(use_normals_for_reference_covariances);
+	matcher->setVoxelMap(voxel_map_);
+
+	private_node_handle->param(configuration_namespace + "use_normals_for_ambient_covariances", use_normals_for_source_covariances_, false);
+	matcher->setUseNormalsForSourceCovariances(use_normals_for_source_covariances_);
+
+	std::string neighbor_search_method;
+	private_node_handle->param(configuration_namespace + "neighbor_search_method", neighbor_search_method, std::string("DIRECT1"));
+	if (neighbor_search_method == "DIRECT7") {
+		matcher->setNeighborSearchMethod(VoxelCovarianceMap<PointT>::DIRECT7);
+	} else if (neighbor_search_method == "DIRECT27") {
+		matcher->setNeighborSearchMethod(VoxelCovarianceMap<PointT>::DIRECT27);
+	} else {
+		matcher->setNeighborSearchMethod(VoxelCovarianceMap<PointT>::DIRECT1);
+	}
+
+	double maximum_step_length;
+	private_node_handle->param(configuration_namespace + "maximum_step_length", maximum_step_length, 1.0);
+	matcher->setMaximumStepLength(maximum_step_length);
+
+	CloudMatcher<PointT>::setCloudMatcher(matcher);
+	CloudMatcher<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+
+	if (CloudMatcher<PointT>::reference_cloud_) {
+		CloudMatcher<PointT>::setupReferenceCloud(CloudMatcher<PointT>::reference_cloud_, CloudMatcher<PointT>::reference_cloud_keypoints_, CloudMatcher<PointT>::search_method_);
+	}
+}
+
+
+template<typename PointT>
+int IterativeClosestPointGeneralizedVoxelized<PointT>::getNumberOfRegistrationIterations() {
+	typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr matcher = getRegistration();
+	if (matcher) { return matcher->getNumberOfRegistrationIterations(); }
+	return -1;
+}
+
+
+template<typename PointT>
+double IterativeClosestPointGeneralizedVoxelized<PointT>::getRootMeanSquareErrorOfRegistrationCorrespondences() {
+	typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr matcher = getRegistration();
+	if (matcher) { return matcher->getRootMeanSquareErrorOfCorrespondences(); }
+	return -1.0;
+}
+
+
+template<typename PointT>
+int IterativeClosestPointGeneralizedVoxelized<PointT>::getNumberCorrespondencesInLastRegistrationIteration() {
+	typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr matcher = getRegistration();
+	if (matcher) { return matcher->getNumberOfCorrespondences(); }
+	return -1;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </IterativeClosestPointGeneralizedVoxelized-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr IterativeClosestPointGeneralizedVoxelized<PointT>::getRegistration() {
+	return std::dynamic_pointer_cast< IterativeClosestPointGeneralizedVoxelizedRegistration<PointT> >(CloudMatcher<PointT>::cloud_matcher_);
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,254 @@
+/**\file normal_distributions_transform_voxel_map.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/normal_distributions_transform_voxel_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// #############################################################   NormalDistributionsTransformVoxelMapRegistration   ##########################################################
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointSource, typename PointTarget>
+NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget>::NormalDistributionsTransformVoxelMapRegistration() :
+	voxel_map_(new VoxelGaussianMap<PointTarget>()),
+	neighbor_search_method_(VoxelGaussianMap<PointTarget>::DIRECT7),
+	outlier_ratio_(0.55),
+	maximum_step_length_(1.0),
+	estimate_2d_pose_(false),
+	number_of_threads_(0),
+	gauss_d1_(0.0),
+	gauss_d2_(0.0),
+	transformation_probability_(0.0),
+	number_of_correspondences_(0) {
+	pcl::Registration<PointSource, PointTarget, float>::reg_name_ = "NormalDistributionsTransformVoxelMapRegistration";
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <NormalDistributionsTransformVoxelMapRegistration-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointSource, typename PointTarget>
+void NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget>::setInputTarget(const PointCloudTargetConstPtr& cloud) {
+	pcl::Registration<PointSource, PointTarget, float>::setInputTarget(cloud);
+	voxel_map_->setNumberOfThreads(number_of_threads_);
+	voxel_map_->updateReferenceCloud(cloud);
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </NormalDistributionsTransformVoxelMapRegistration-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointSource, typename PointTarget>
+void NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget>::computeTransformation(PointCloudSource& output, const Matrix4& guess) {
+	using RegistrationBase = pcl::Registration<PointSource, PointTarget, float>;
+	RegistrationBase::nr_iterations_ = 0;
+	RegistrationBase::converged_ = false;
+	transformation_probability_ = 0.0;
+	number_of_correspondences_ = 0;
+
+	if (voxel_map_->empty()) {
+		PCL_ERROR("[%s::computeTransformation] The voxel map of the target cloud is empty!\n", RegistrationBase::getClassName().c_str());
+		return;
+	}
+
+	// constants of the mixture of a normal and an uniform distribution used in the pcl ndt score [Magnusson 2009, eq. 6.8]
+	const double resolution = voxel_map_->getResolution();
+	const double gauss_c1 = 10.0 * (1.0 - outlier_ratio_);
+	const double gauss_c2 = outlier_ratio_ / (resolution * resolution * resolution);
+	const double gauss_d3 = -std::log(gauss_c2);
+	gauss_d1_ = -std::log(gauss_c1 + gauss_c2) - gauss_d3;
+	gauss_d2_ = -2.0 * std::log((-std::log(gauss_c1 * std::exp(-0.5) + gauss_c2) - gauss_d3) / gauss_d1_);
+
+	Eigen::Matrix4d transformation = guess.template cast<double>();
+	Matrix6d hessian;
+	Vector6d gradient;
+	double score = 0.0;
+
+	while (RegistrationBase::nr_iterations_ < RegistrationBase::max_iterations_) {
+		number_of_correspondences_ = computeDerivatives(transformation, hessian, gradient, score);
+		if (number_of_correspondences_ == 0) {
+			PCL_DEBUG("[%s::computeTransformation] No source point was matched to the voxel map!\n", RegistrationBase::getClassName().c_str());
+			return;
+		}
+
+		bool converged = false;
+		if (!math_utils::applyGaussNewtonPoseUpdate(hessian, gradient, maximum_step_length_, estimate_2d_pose_,
+				RegistrationBase::transformation_epsilon_, RegistrationBase::transformation_rotation_epsilon_, transformation, converged)) {
+			PCL_DEBUG("[%s::computeTransformation] Singular Hessian!\n", RegistrationBase::getClassName().c_str());
+			break;
+		}
+
+		++RegistrationBase::nr_iterations_;
+		if (converged) { break; }
+	}
+
+	// same as the pcl ndt, reaching the maximum number of iterations is considered convergence (the transformation validators decide if the pose is acceptable)
+	RegistrationBase::converged_ = true;
+	RegistrationBase::final_transformation_ = transformation.cast<float>();
+	RegistrationBase::transformation_ = RegistrationBase::final_transformation_;
+	transformation_probability_ = score / (double)std::max(RegistrationBase::input_->size(), (size_t)1);
+	pcl::transformPointCloud(*RegistrationBase::input_, output, RegistrationBase::final_transformation_);
+}
+
+
+template<typename PointSource, typename PointTarget>
+int NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget>::computeDerivatives(const Eigen::Matrix4d& transformation, Matrix6d& hessian, Vector6d& gradient, double& score) const {
+	using RegistrationBase = pcl::Registration<PointSource, PointTarget, float>;
+	const pcl::PointCloud<PointSource>& source_cloud = *RegistrationBase::input_;
+	const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+	const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
+	const int number_of_points = (int)source_cloud.size();
+
+	hessian.setZero();
+	gradient.setZero();
+	score = 0.0;
+	int number_of_correspondences = 0;
+
+	#pragma omp parallel num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	{
+		Matrix6d thread_hessian = Matrix6d::Zero();
+		Vector6d thread_gradient = Vector6d::Zero();
+		double thread_score = 0.0;
+		int thread_number_of_correspondences = 0;
+		const typename VoxelGaussianMap<PointTarget>::Voxel* neighbors[VoxelGaussianMap<PointTarget>::MAXIMUM_NUMBER_OF_NEIGHBORS];
+		Eigen::Matrix<double, 3, 6> point_jacobian;
+		point_jacobian.block<3, 3>(0, 0).setIdentity();
+
+		#pragma omp for schedule(static)
+		for (int i = 0; i < number_of_points; ++i) {
+			const PointSource& source_point = source_cloud[i];
+			if (!pcl::isFinite(source_point)) { continue; }
+
+			Eigen::Vector3d point = rotation * Eigen::Vector3d(source_point.x, source_point.y, source_point.z) + translation;
+			int number_of_neighbors = voxel_map_->findNeighborVoxels(point, neighbor_search_method_, neighbors);
+			if (number_of_neighbors == 0) { continue; }
+
+			// derivative of the point in relation to a pose update [translation, rotation] applied on the left of the transformation
+			point_jacobian(0, 3) = 0.0;        point_jacobian(0, 4) = point.z();  point_jacobian(0, 5) = -point.y();
+			point_jacobian(1, 3) = -point.z(); point_jacobian(1, 4) = 0.0;        point_jacobian(1, 5) = point.x();
+			point_jacobian(2, 3) = point.y();  point_jacobian(2, 4) = -point.x(); point_jacobian(2, 5) = 0.0;
+
+			for (int n = 0; n < number_of_neighbors; ++n) {
+				const Eigen::Vector3d point_to_mean = point - neighbors[n]->mean;
+				const Eigen::Vector3d inverse_covariance_times_point_to_mean = neighbors[n]->inverse_covariance * point_to_mean;
+				const double exponential = std::exp(-0.5 * gauss_d2_ * point_to_mean.dot(inverse_covariance_times_point_to_mean));
+				if (!std::isfinite(exponential)) { continue; }
+
+				// gradient and Gauss-Newton Hessian of the negative score (the weight is positive because gauss_d1_ < 0)
+				const double weight = -gauss_d1_ * gauss_d2_ * exponential;
+				const Eigen::Matrix<double, 3, 6> inverse_covariance_times_jacobian = neighbors[n]->inverse_covariance * point_jacobian;
+				thread_score += -gauss_d1_ * exponential;
+				thread_gradient.noalias() += weight * (point_jacobian.transpose() * inverse_covariance_times_point_to_mean);
+				thread_hessian.noalias() += weight * (point_jacobian.transpose() * inverse_covariance_times_jacobian);
+				++thread_number_of_correspondences;
+			}
+		}
+
+		#pragma omp critical
+		{
+			hessian += thread_hessian;
+			gradient += thread_gradient;
+			score += thread_score;
+			number_of_correspondences += thread_number_of_correspondences;
+		}
+	}
+
+	return number_of_correspondences;
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+
+
+// #################################################################   NormalDistributionsTransformVoxelMap   #################################################################
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <NormalDistributionsTransformVoxelMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void NormalDistributionsTransformVoxelMap<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	typename NormalDistributionsTransformVoxelMapRegistration<PointT, PointT>::Ptr matcher(new NormalDistributionsTransformVoxelMapRegistration<PointT, PointT>());
+
+	double transformation_rotation_epsilon;
+	private_node_handle->param(configuration_namespace + "transformation_rotation_epsilon", transformation_rotation_epsilon, 0.0);
+	matcher->setTransformationRotationEpsilon(transformation_rotation_epsilon);
+
+	int number_of_threads;
+	private_node_handle->param(configuration_namespace + "number_of_threads", number_of_threads, 0);
+	matcher->setNumberOfThreads(number_of_threads);
+	voxel_map_->setNumberOfThreads(number_of_threads);
+
+	double voxel_grid_resolution;
+	private_node_handle->param(configuration_namespace + "voxel_grid_resolution", voxel_grid_resolution, 1.0);
+	voxel_map_->setResolution(voxel_grid_resolution);
+
+	int minimum_number_of_points_per_voxel;
+	private_node_handle->param(configuration_namespace + "minimum_number_of_points_per_voxel", minimum_number_of_points_per_voxel, 6);
+	voxel_map_->setMinimumNumberOfPointsPerVoxel(minimum_number_of_points_per_voxel);
+
+	double minimum_covariance_eigenvalue_ratio;
+	private_node_handle->param(configuration_namespace + "minimum_covariance_eigenvalue_ratio", minimum_covariance_eigenvalue_ratio, 0.01);
+	voxel_map_->setMinimumCovarianceEigenvalueRatio(minimum_covariance_eigenvalue_ratio);
+	matcher->setVoxelMap(voxel_map_);
+
+	std::string neighbor_search_method;
+	private_node_handle->param(configuration_namespace + "neighbor_search_method", neighbor_search_method, std::string("DIRECT7"));
+	if (neighbor_search_method == "DIRECT1") {
+		matcher->setNeighborSearchMethod(VoxelGaussianMap<PointT>::DIRECT1);
+	} else if (neighbor_search_method == "DIRECT27") {
+		matcher->setNeighborSearchMethod(VoxelGaussianMap<PointT>::DIRECT27);
+	} else {
+		matcher->setNeighborSearchMethod(VoxelGaussianMap<PointT>::DIRECT7);
+	}
+
+	double outlier_ratio;
+	private_node_handle->param(configuration_namespace + "outlier_ratio", outlier_ratio, 0.55);
+	matcher->setOutlierRatio(outlier_ratio);
+
+	double maximum_step_length;
+	private_node_handle->param(configuration_namespace + "maximum_step_length", maximum_step_length, 1.0);
+	matcher->setMaximumStepLength(maximum_step_length);
+
+	bool estimate_2d_pose;
+	private_node_handle->param(configuration_namespace + "estimate_2d_pose", estimate_2d_pose, false);
+	matcher->setEstimate2DPose(estimate_2d_pose);
+
+	CloudMatcher<PointT>::setCloudMatcher(matcher);
+	CloudMatcher<PointT>::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+
+	// the voxel map is only rebuilt if the reference cloud or the voxel parameters changed
+	if (CloudMatcher<PointT>::reference_cloud_) {
+		CloudMatcher<PointT>::setupReferenceCloud(CloudMatcher<PointT>::reference_cloud_, CloudMatcher<PointT>::reference_cloud_keypoints_, CloudMatcher<PointT>::search_method_);
+	}
+}
+
+
+template<typename PointT>
+int NormalDistributionsTransformVoxelMap<PointT>::getNumberOfRegistrationIterations() {
+	typename NormalDistributionsTransformVoxelMapRegistration<PointT, PointT>::Ptr matcher = std::dynamic_pointer_cast< NormalDistributionsTransformVoxelMapRegistration<PointT, PointT> >(CloudMatcher<PointT>::cloud_matcher_);
+	if (matcher) { return matcher->getNumberOfRegistrationIterations(); }
+	return -1;
+}
+
+
+template<typename PointT>
+int NormalDistributionsTransformVoxelMap<PointT>::getNumberCorrespondencesInLastRegistrationIteration() {
+	typename NormalDistributionsTransformVoxelMapRegistration<PointT, PointT>::Ptr matcher = std::dynamic_pointer_cast< NormalDistributionsTransformVoxelMapRegistration<PointT, PointT> >(CloudMatcher<PointT>::cloud_matcher_);
+	if (matcher) { return matcher->getNumberOfCorrespondences(); }
+	return -1;
+}
+
+
+template<typename PointT>
+std::string NormalDistributionsTransformVoxelMap<PointT>::getMatcherConvergenceState() {
+	typename NormalDistributionsTransformVoxelMapRegistration<PointT, PointT>::Ptr matcher = std::dynamic_pointer_cast< NormalDistributionsTransformVoxelMapRegistration<PointT, PointT> >(CloudMatcher<PointT>::cloud_matcher_);
+	if (matcher) { return "Transformation probability: " + std::to_string(matcher->getTransformationProbability()); }
+	return "";
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </NormalDistributionsTransformVoxelMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
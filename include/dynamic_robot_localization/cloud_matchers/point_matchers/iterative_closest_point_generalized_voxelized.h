@@ -0,0 +1,139 @@
+#pragma once
+
+/**\file iterative_closest_point_generalized_voxelized.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cmath>
+#include <memory>
+#include <string>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/common/transforms.h>
+#include <pcl/registration/registration.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/Cholesky>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/cloud_matchers/cloud_matcher.h>
+#include <dynamic_robot_localization/common/math_utils.h>
+#include <dynamic_robot_localization/common/voxel_covariance_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// ############################################################   IterativeClosestPointGeneralizedVoxelizedRegistration   ######################################################
+/**
+ * \brief Voxelized generalized icp, in which each source point is matched against the mean and mean covariance of the reference points inside the voxels around it.
+ * The reference covariances are kept in a persistent VoxelCovarianceMap (only updated with the new points when the target cloud grows) and the source covariances are computed
+ * in parallel (from the point normals or from the k nearest neighbors).
+ * Each iteration solves a fixed size 6x6 Gauss-Newton system (the pose update is applied on the left of the current transformation).
+ */
+template <typename PointT>
+class IterativeClosestPointGeneralizedVoxelizedRegistration : public pcl::Registration<PointT, PointT, float> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< IterativeClosestPointGeneralizedVoxelizedRegistration<PointT> >;
+		using ConstPtr = std::shared_ptr< const IterativeClosestPointGeneralizedVoxelizedRegistration<PointT> >;
+		using PointCloudSource = typename pcl::Registration<PointT, PointT, float>::PointCloudSource;
+		using PointCloudTargetConstPtr = typename pcl::Registration<PointT, PointT, float>::PointCloudTargetConstPtr;
+		using Matrix4 = typename pcl::Registration<PointT, PointT, float>::Matrix4;
+		using Matrix6d = Eigen::Matrix<double, 6, 6>;
+		using Vector6d = Eigen::Matrix<double, 6, 1>;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		IterativeClosestPointGeneralizedVoxelizedRegistration();
+		virtual ~IterativeClosestPointGeneralizedVoxelizedRegistration() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <IterativeClosestPointGeneralizedVoxelizedRegistration-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Flags the voxel map for update (done once in the next registration, because the target search method is only given after the target cloud)
+		virtual void setInputTarget(const PointCloudTargetConstPtr& cloud) override;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </IterativeClosestPointGeneralizedVoxelizedRegistration-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		inline int getNumberOfRegistrationIterations() const { return pcl::Registration<PointT, PointT, float>::nr_iterations_; }
+		inline int getNumberOfCorrespondences() const { return number_of_correspondences_; }
+		/// Root mean square of the distances between the source points (with the final transformation) and the means of their matched voxels
+		inline double getRootMeanSquareErrorOfCorrespondences() const { return root_mean_square_error_of_correspondences_; }
+		inline const typename VoxelCovarianceMap<PointT>::Ptr& getVoxelMap() const { return voxel_map_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Allows to share the voxel map between registrations (and keep it when the registration is reconfigured)
+		inline void setVoxelMap(const typename VoxelCovarianceMap<PointT>::Ptr& voxel_map) { voxel_map_ = voxel_map; voxel_map_update_required_ = true; }
+		inline void setNeighborSearchMethod(typename VoxelCovarianceMap<PointT>::NeighborSearchMethod neighbor_search_method) { neighbor_search_method_ = neighbor_search_method; }
+		inline void setUseNormalsForSourceCovariances(bool use_normals) { use_normals_for_source_covariances_ = use_normals; }
+		/// Maximum norm of the pose update of each iteration
+		inline void setMaximumStepLength(double maximum_step_length) { maximum_step_length_ = maximum_step_length; }
+		inline void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		virtual void computeTransformation(PointCloudSource& output, const Matrix4& guess) override;
+		/// Accumulates the gradient and Gauss-Newton Hessian of the source points transformed by the given transformation (returns the number of matched voxels)
+		int computeDerivatives(const Eigen::Matrix4d& transformation, Matrix6d& hessian, Vector6d& gradient, double& squared_distances_sum) const;
+
+		typename VoxelCovarianceMap<PointT>::Ptr voxel_map_;
+		bool voxel_map_update_required_;
+		typename VoxelCovarianceMap<PointT>::Covariances source_covariances_;
+		typename VoxelCovarianceMap<PointT>::NeighborSearchMethod neighbor_search_method_;
+		bool use_normals_for_source_covariances_;
+		double maximum_step_length_;
+		int number_of_threads_;
+		int number_of_correspondences_;
+		double root_mean_square_error_of_correspondences_;
+};
+
+
+// ##################################################################   IterativeClosestPointGeneralizedVoxelized   ############################################################
+/**
+ * \brief Cloud matcher for the IterativeClosestPointGeneralizedVoxelizedRegistration (the voxel map is kept when the matcher configuration is reloaded).
+ */
+template <typename PointT>
+class IterativeClosestPointGeneralizedVoxelized : public CloudMatcher<PointT> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< IterativeClosestPointGeneralizedVoxelized<PointT> >;
+		using ConstPtr = std::shared_ptr< const IterativeClosestPointGeneralizedVoxelized<PointT> >;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		IterativeClosestPointGeneralizedVoxelized() : voxel_map_(new VoxelCovarianceMap<PointT>()), use_normals_for_source_covariances_(false) {}
+		virtual ~IterativeClosestPointGeneralizedVoxelized() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <IterativeClosestPointGeneralizedVoxelized-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		virtual bool registrationRequiresNormalsOnAmbientPointCloud() { return use_normals_for_source_covariances_; }
+		virtual int getNumberOfRegistrationIterations();
+		virtual double getRootMeanSquareErrorOfRegistrationCorrespondences();
+		virtual int getNumberCorrespondencesInLastRegistrationIteration();
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </IterativeClosestPointGeneralizedVoxelized-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		typename IterativeClosestPointGeneralizedVoxelizedRegistration<PointT>::Ptr getRegistration();
+
+		typename VoxelCovarianceMap<PointT>::Ptr voxel_map_;
+		bool use_normals_for_source_covariances_;
+};
+
+} /* namespace dynamic_robot_localization */
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/impl/iterative_closest_point_generalized_voxelized.hpp>
+#endif
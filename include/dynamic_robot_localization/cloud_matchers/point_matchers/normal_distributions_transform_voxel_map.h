@@ -0,0 +1,137 @@
+#pragma once
+
+/**\file normal_distributions_transform_voxel_map.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cmath>
+#include <memory>
+#include <string>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/common/transforms.h>
+#include <pcl/registration/registration.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/Cholesky>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/cloud_matchers/cloud_matcher.h>
+#include <dynamic_robot_localization/common/math_utils.h>
+#include <dynamic_robot_localization/common/voxel_gaussian_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// #############################################################   NormalDistributionsTransformVoxelMapRegistration   ##########################################################
+/**
+ * \brief Normal distributions transform (using the score function of the pcl ndt) that keeps the voxel normal distributions of the target cloud in a persistent VoxelGaussianMap
+ * (only updated with the new points when the target cloud grows) and that computes the score, gradient and Hessian in parallel.
+ * Each iteration solves a fixed size Gauss-Newton system (the pose update is applied on the left of the current transformation) and
+ * each source point can be matched against several voxels (DIRECT1 / DIRECT7 / DIRECT27).
+ * In 2D mode only x, y and yaw are estimated.
+ */
+template <typename PointSource, typename PointTarget>
+class NormalDistributionsTransformVoxelMapRegistration : public pcl::Registration<PointSource, PointTarget, float> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget> >;
+		using ConstPtr = std::shared_ptr< const NormalDistributionsTransformVoxelMapRegistration<PointSource, PointTarget> >;
+		using PointCloudSource = typename pcl::Registration<PointSource, PointTarget, float>::PointCloudSource;
+		using PointCloudTargetConstPtr = typename pcl::Registration<PointSource, PointTarget, float>::PointCloudTargetConstPtr;
+		using Matrix4 = typename pcl::Registration<PointSource, PointTarget, float>::Matrix4;
+		using Matrix6d = Eigen::Matrix<double, 6, 6>;
+		using Vector6d = Eigen::Matrix<double, 6, 1>;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		NormalDistributionsTransformVoxelMapRegistration();
+		virtual ~NormalDistributionsTransformVoxelMapRegistration() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <NormalDistributionsTransformVoxelMapRegistration-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Updates the voxel map (incrementally if the target starts with the points of the previous target cloud)
+		virtual void setInputTarget(const PointCloudTargetConstPtr& cloud) override;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </NormalDistributionsTransformVoxelMapRegistration-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		inline int getNumberOfRegistrationIterations() const { return pcl::Registration<PointSource, PointTarget, float>::nr_iterations_; }
+		inline double getTransformationProbability() const { return transformation_probability_; }
+		inline int getNumberOfCorrespondences() const { return number_of_correspondences_; }
+		inline const typename VoxelGaussianMap<PointTarget>::Ptr& getVoxelMap() const { return voxel_map_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Allows to share the voxel map between registrations (and keep it when the registration is reconfigured)
+		inline void setVoxelMap(const typename VoxelGaussianMap<PointTarget>::Ptr& voxel_map) { voxel_map_ = voxel_map; }
+		inline void setNeighborSearchMethod(typename VoxelGaussianMap<PointTarget>::NeighborSearchMethod neighbor_search_method) { neighbor_search_method_ = neighbor_search_method; }
+		inline void setOutlierRatio(double outlier_ratio) { outlier_ratio_ = outlier_ratio; }
+		/// Maximum norm of the pose update of each iteration
+		inline void setMaximumStepLength(double maximum_step_length) { maximum_step_length_ = maximum_step_length; }
+		inline void setEstimate2DPose(bool estimate_2d_pose) { estimate_2d_pose_ = estimate_2d_pose; }
+		inline void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		virtual void computeTransformation(PointCloudSource& output, const Matrix4& guess) override;
+		/// Accumulates the score, gradient and Gauss-Newton Hessian of the source points transformed by the given transformation (returns the number of matched voxels)
+		int computeDerivatives(const Eigen::Matrix4d& transformation, Matrix6d& hessian, Vector6d& gradient, double& score) const;
+
+		typename VoxelGaussianMap<PointTarget>::Ptr voxel_map_;
+		typename VoxelGaussianMap<PointTarget>::NeighborSearchMethod neighbor_search_method_;
+		double outlier_ratio_;
+		double maximum_step_length_;
+		bool estimate_2d_pose_;
+		int number_of_threads_;
+		double gauss_d1_;
+		double gauss_d2_;
+		double transformation_probability_;
+		int number_of_correspondences_;
+};
+
+
+// #################################################################   NormalDistributionsTransformVoxelMap   #################################################################
+/**
+ * \brief Cloud matcher for the NormalDistributionsTransformVoxelMapRegistration (the voxel map is kept when the matcher configuration is reloaded).
+ */
+template <typename PointT>
+class NormalDistributionsTransformVoxelMap : public CloudMatcher<PointT> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< NormalDistributionsTransformVoxelMap<PointT> >;
+		using ConstPtr = std::shared_ptr< const NormalDistributionsTransformVoxelMap<PointT> >;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		NormalDistributionsTransformVoxelMap() : voxel_map_(new VoxelGaussianMap<PointT>()) {}
+		virtual ~NormalDistributionsTransformVoxelMap() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <NormalDistributionsTransformVoxelMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		virtual int getNumberOfRegistrationIterations();
+		virtual int getNumberCorrespondencesInLastRegistrationIteration();
+		virtual std::string getMatcherConvergenceState();
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </NormalDistributionsTransformVoxelMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		typename VoxelGaussianMap<PointT>::Ptr voxel_map_;
+};
+
+} /* namespace dynamic_robot_localization */
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/impl/normal_distributions_transform_voxel_map.hpp>
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+/**\file changed_regions_detector.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// ROS includes
+#include <ros/ros.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+
+// project includes
+#include <dynamic_robot_localization/common/configurable_object.h>
+#include <dynamic_robot_localization/common/voxel_coordinates.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ########################################################################   changed_regions_detector   ########################################################################
+/**
+ * \brief Finds the voxels whose points changed between successive versions of a cloud (such as map updates), in order to limit expensive recomputations
+ * (such as keypoint detection) to the regions affected by the changes.
+ * Each voxel is summarized by its number of points and their centroid, and the changed voxels are dilated by the support radius of the computation
+ * (affected region, in which the previous results are discarded) and then again (computation region, that gives the affected region its full neighborhood).
+ */
+template <typename PointT>
+class ChangedRegionsDetector : public ConfigurableObject {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< ChangedRegionsDetector<PointT> >;
+		using ConstPtr = std::shared_ptr< const ChangedRegionsDetector<PointT> >;
+
+		struct VoxelSignature {
+			std::uint32_t number_of_points;
+			double sum_x, sum_y, sum_z;
+		};
+
+		using VoxelsSignatures = std::unordered_map<VoxelCoordinates, VoxelSignature, VoxelCoordinatesHash>;
+		using VoxelsSet = std::unordered_set<VoxelCoordinates, VoxelCoordinatesHash>;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		ChangedRegionsDetector() : voxel_size_(0.0), centroid_tolerance_(0.001), maximum_affected_voxels_ratio_(0.5), support_radius_(0.0) {}
+		virtual ~ChangedRegionsDetector() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <ChangedRegionsDetector-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		/// Forgets the previous cloud (the next call to detectChangedRegions will request a full recomputation)
+		void reset() { previous_voxels_signatures_.clear(); voxels_signatures_.clear(); affected_voxels_.clear(); computation_voxels_.clear(); }
+		/**
+		 * Compares the voxels of the pointcloud with the ones of the last committed cloud and computes the affected and computation regions
+		 * @return true if the recomputation can be limited to the computation region, false if it must be done for the whole cloud
+		 * (first cloud, region limiting disabled or too many affected voxels)
+		 */
+		bool detectChangedRegions(const pcl::PointCloud<PointT>& pointcloud);
+		/// Makes the cloud given to the last detectChangedRegions the reference for the next changes (must be called only after its results were updated successfully)
+		void commitChangedRegions() { previous_voxels_signatures_.swap(voxels_signatures_); voxels_signatures_.clear(); }
+		/// Copies the points of the pointcloud that are inside the computation region
+		void extractComputationRegion(const pcl::PointCloud<PointT>& pointcloud, pcl::PointCloud<PointT>& computation_region_pointcloud_out) const;
+		/// Keeps the previous results outside the affected region and the new results (computed in the computation region) inside it
+		void mergeResults(const pcl::PointCloud<PointT>& previous_results, const pcl::PointCloud<PointT>& computation_region_results, pcl::PointCloud<PointT>& merged_results_out) const;
+		bool isInAffectedRegion(const PointT& point) const { return affected_voxels_.find(computeVoxelCoordinates(point)) != affected_voxels_.end(); }
+		VoxelCoordinates computeVoxelCoordinates(const PointT& point) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </ChangedRegionsDetector-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		double getVoxelSize() const { return voxel_size_; }
+		double getSupportRadius() const { return support_radius_; }
+		size_t getNumberOfAffectedVoxels() const { return affected_voxels_.size(); }
+		size_t getNumberOfVoxels() const { return previous_voxels_signatures_.size(); }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// <= 0 -> disables the region limiting
+		void setVoxelSize(double voxel_size) { voxel_size_ = voxel_size; reset(); }
+		/// Distance up to which a change in the cloud can influence the recomputed results
+		void setSupportRadius(double support_radius) { support_radius_ = support_radius; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		void computeVoxelsSignatures(const pcl::PointCloud<PointT>& pointcloud, VoxelsSignatures& voxels_signatures_out) const;
+		bool isVoxelChanged(const VoxelSignature& previous_voxel_signature, const VoxelSignature& voxel_signature) const;
+		void dilateVoxels(const VoxelsSet& voxels, int number_of_rings, VoxelsSet& dilated_voxels_out) const;
+
+		double voxel_size_;
+		double centroid_tolerance_;
+		double maximum_affected_voxels_ratio_;
+		double support_radius_;
+		VoxelsSignatures previous_voxels_signatures_;
+		VoxelsSignatures voxels_signatures_;
+		VoxelsSet affected_voxels_;
+		VoxelsSet computation_voxels_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/changed_regions_detector.hpp>
+#endif
@@ -10,14 +10,16 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <macros>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // Define all point types that include PointXYZ and Normal data
-#define DRL_POINT_TYPES					\
-	(pcl::PointXYZRGBNormal)			/*\// -> 12 floats
-	(pcl::PointXYZ)						\  // ->  4 floats
-	(pcl::PointXYZI)					\  // ->  8 floats
-	(pcl::PointXYZRGB)					\  // ->  8 floats
-	(pcl::PointXYZRGBA)					\  // ->  8 floats
-	(pcl::PointNormal)					\  // -> 12 floats
-	(pcl::PointXYZINormal)				\  // -> 12 floats*/
+// PointNormal and PointXYZINormal are only compiled when DRL_COMPILE_ALL_POINT_TYPES is defined (cmake option with the same name), given that each point type adds a full instantiation of the localization pipeline
+#ifdef DRL_COMPILE_ALL_POINT_TYPES
+	#define DRL_POINT_TYPES				\
+		(pcl::PointXYZRGBNormal)		\
+		(pcl::PointNormal)				\
+		(pcl::PointXYZINormal)
+#else
+	#define DRL_POINT_TYPES				\
+		(pcl::PointXYZRGBNormal)
+#endif
 
 
 
@@ -0,0 +1,173 @@
+/**\file changed_regions_detector.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/changed_regions_detector.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <ChangedRegionsDetector-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void ChangedRegionsDetector<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	private_node_handle->param(configuration_namespace + "voxel_size", voxel_size_, 0.0);
+	private_node_handle->param(configuration_namespace + "centroid_tolerance", centroid_tolerance_, 0.001);
+	private_node_handle->param(configuration_namespace + "maximum_affected_voxels_ratio", maximum_affected_voxels_ratio_, 0.5);
+	reset();
+}
+
+
+template<typename PointT>
+bool ChangedRegionsDetector<PointT>::detectChangedRegions(const pcl::PointCloud<PointT>& pointcloud) {
+	affected_voxels_.clear();
+	computation_voxels_.clear();
+	if (voxel_size_ <= 0.0) { return false; }
+
+	computeVoxelsSignatures(pointcloud, voxels_signatures_);
+	bool has_previous_cloud = !previous_voxels_signatures_.empty();
+
+	VoxelsSet changed_voxels;
+	if (has_previous_cloud) {
+		for (typename VoxelsSignatures::const_iterator it = voxels_signatures_.begin(); it != voxels_signatures_.end(); ++it) {
+			typename VoxelsSignatures::const_iterator previous_it = previous_voxels_signatures_.find(it->first);
+			if (previous_it == previous_voxels_signatures_.end() || isVoxelChanged(previous_it->second, it->second)) {
+				changed_voxels.insert(it->first);
+			}
+		}
+
+		for (typename VoxelsSignatures::const_iterator previous_it = previous_voxels_signatures_.begin(); previous_it != previous_voxels_signatures_.end(); ++previous_it) {
+			if (voxels_signatures_.find(previous_it->first) == voxels_signatures_.end()) {
+				changed_voxels.insert(previous_it->first);
+			}
+		}
+	}
+
+	if (!has_previous_cloud) { return false; }
+
+	int number_of_rings = (int)std::ceil(std::max(support_radius_, 0.0) / voxel_size_);
+	dilateVoxels(changed_voxels, number_of_rings, affected_voxels_);
+	if ((double)affected_voxels_.size() > maximum_affected_voxels_ratio_ * (double)voxels_signatures_.size()) {
+		ROS_DEBUG_STREAM("Changed regions detector found " << affected_voxels_.size() << " affected voxels in a cloud with " << voxels_signatures_.size() << " voxels (requesting full recomputation)");
+		affected_voxels_.clear();
+		return false;
+	}
+
+	dilateVoxels(affected_voxels_, number_of_rings, computation_voxels_);
+	ROS_DEBUG_STREAM("Changed regions detector found " << changed_voxels.size() << " changed voxels, " << affected_voxels_.size() << " affected voxels and " << computation_voxels_.size() << " computation voxels in a cloud with " << voxels_signatures_.size() << " voxels");
+	return true;
+}
+
+
+template<typename PointT>
+void ChangedRegionsDetector<PointT>::extractComputationRegion(const pcl::PointCloud<PointT>& pointcloud, pcl::PointCloud<PointT>& computation_region_pointcloud_out) const {
+	computation_region_pointcloud_out.clear();
+	computation_region_pointcloud_out.header = pointcloud.header;
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		if (pcl::isFinite(pointcloud[i]) && computation_voxels_.find(computeVoxelCoordinates(pointcloud[i])) != computation_voxels_.end()) {
+			computation_region_pointcloud_out.push_back(pointcloud[i]);
+		}
+	}
+}
+
+
+template<typename PointT>
+void ChangedRegionsDetector<PointT>::mergeResults(const pcl::PointCloud<PointT>& previous_results, const pcl::PointCloud<PointT>& computation_region_results, pcl::PointCloud<PointT>& merged_results_out) const {
+	pcl::PointCloud<PointT> merged_results;
+	merged_results.header = previous_results.header;
+	merged_results.reserve(previous_results.size() + computation_region_results.size());
+
+	for (size_t i = 0; i < previous_results.size(); ++i) {
+		if (!isInAffectedRegion(previous_results[i])) { merged_results.push_back(previous_results[i]); }
+	}
+
+	for (size_t i = 0; i < computation_region_results.size(); ++i) {
+		if (isInAffectedRegion(computation_region_results[i])) { merged_results.push_back(computation_region_results[i]); }
+	}
+
+	merged_results_out.swap(merged_results);
+}
+
+
+template<typename PointT>
+VoxelCoordinates ChangedRegionsDetector<PointT>::computeVoxelCoordinates(const PointT& point) const {
+	VoxelCoordinates voxel_coordinates;
+	voxel_coordinates.x = (std::int64_t)std::floor(point.x / voxel_size_);
+	voxel_coordinates.y = (std::int64_t)std::floor(point.y / voxel_size_);
+	voxel_coordinates.z = (std::int64_t)std::floor(point.z / voxel_size_);
+	return voxel_coordinates;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </ChangedRegionsDetector-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+void ChangedRegionsDetector<PointT>::computeVoxelsSignatures(const pcl::PointCloud<PointT>& pointcloud, VoxelsSignatures& voxels_signatures_out) const {
+	voxels_signatures_out.clear();
+	voxels_signatures_out.reserve(pointcloud.size() / 4 + 1);
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		const PointT& point = pointcloud[i];
+		if (!pcl::isFinite(point)) { continue; }
+		VoxelCoordinates voxel_coordinates = computeVoxelCoordinates(point);
+		typename VoxelsSignatures::iterator it = voxels_signatures_out.find(voxel_coordinates);
+		if (it == voxels_signatures_out.end()) {
+			VoxelSignature voxel_signature;
+			voxel_signature.number_of_points = 1;
+			voxel_signature.sum_x = point.x;
+			voxel_signature.sum_y = point.y;
+			voxel_signature.sum_z = point.z;
+			voxels_signatures_out.insert(std::make_pair(voxel_coordinates, voxel_signature));
+		} else {
+			++it->second.number_of_points;
+			it->second.sum_x += point.x;
+			it->second.sum_y += point.y;
+			it->second.sum_z += point.z;
+		}
+	}
+}
+
+
+template<typename PointT>
+bool ChangedRegionsDetector<PointT>::isVoxelChanged(const VoxelSignature& previous_voxel_signature, const VoxelSignature& voxel_signature) const {
+	if (previous_voxel_signature.number_of_points != voxel_signature.number_of_points) { return true; }
+	double number_of_points = (double)voxel_signature.number_of_points;
+	double centroid_offset_x = (voxel_signature.sum_x - previous_voxel_signature.sum_x) / number_of_points;
+	double centroid_offset_y = (voxel_signature.sum_y - previous_voxel_signature.sum_y) / number_of_points;
+	double centroid_offset_z = (voxel_signature.sum_z - previous_voxel_signature.sum_z) / number_of_points;
+	return (centroid_offset_x * centroid_offset_x + centroid_offset_y * centroid_offset_y + centroid_offset_z * centroid_offset_z) > centroid_tolerance_ * centroid_tolerance_;
+}
+
+
+template<typename PointT>
+void ChangedRegionsDetector<PointT>::dilateVoxels(const VoxelsSet& voxels, int number_of_rings, VoxelsSet& dilated_voxels_out) const {
+	dilated_voxels_out.clear();
+	for (typename VoxelsSet::const_iterator it = voxels.begin(); it != voxels.end(); ++it) {
+		VoxelCoordinates neighbor_voxel;
+		for (std::int64_t x = -number_of_rings; x <= number_of_rings; ++x) {
+			neighbor_voxel.x = it->x + x;
+			for (std::int64_t y = -number_of_rings; y <= number_of_rings; ++y) {
+				neighbor_voxel.y = it->y + y;
+				for (std::int64_t z = -number_of_rings; z <= number_of_rings; ++z) {
+					neighbor_voxel.z = it->z + z;
+					dilated_voxels_out.insert(neighbor_voxel);
+				}
+			}
+		}
+	}
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
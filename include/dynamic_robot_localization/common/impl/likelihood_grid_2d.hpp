@@ -0,0 +1,139 @@
+/**\file likelihood_grid_2d.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/likelihood_grid_2d.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <LikelihoodGrid2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void LikelihoodGrid2D<PointT>::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	private_node_handle->param(configuration_namespace + "cell_resolution", cell_resolution_, 0.05);
+	private_node_handle->param(configuration_namespace + "likelihood_field_sigma", likelihood_field_sigma_, 0.05);
+	private_node_handle->param(configuration_namespace + "maximum_number_of_cells", maximum_number_of_cells_, 200000000);
+	reset();
+}
+
+
+template<typename PointT>
+bool LikelihoodGrid2D<PointT>::setupReferenceCloud(const pcl::PointCloud<PointT>& reference_cloud) {
+	reset();
+	if (cell_resolution_ <= 0.0) {
+		ROS_WARN_STREAM("Likelihood grid cell resolution must be > 0");
+		return false;
+	}
+
+	float min_x = std::numeric_limits<float>::max(), min_y = std::numeric_limits<float>::max();
+	float max_x = -std::numeric_limits<float>::max(), max_y = -std::numeric_limits<float>::max();
+	for (size_t i = 0; i < reference_cloud.size(); ++i) {
+		if (!pcl::isFinite(reference_cloud[i])) { continue; }
+		min_x = std::min(min_x, reference_cloud[i].x);
+		min_y = std::min(min_y, reference_cloud[i].y);
+		max_x = std::max(max_x, reference_cloud[i].x);
+		max_y = std::max(max_y, reference_cloud[i].y);
+	}
+
+	if (min_x > max_x) {
+		ROS_WARN_STREAM("Likelihood grid received a reference cloud without valid points");
+		return false;
+	}
+
+	const int kernel_radius = (likelihood_field_sigma_ > 0.0 ? (int)std::ceil(3.0 * likelihood_field_sigma_ / cell_resolution_) : 0);
+	const double number_of_cells_x = std::floor((max_x - min_x) / cell_resolution_) + 1 + 2 * kernel_radius;
+	const double number_of_cells_y = std::floor((max_y - min_y) / cell_resolution_) + 1 + 2 * kernel_radius;
+	if (number_of_cells_x * number_of_cells_y > (double)maximum_number_of_cells_) {
+		ROS_WARN_STREAM("Likelihood grid would need " << (number_of_cells_x * number_of_cells_y) << " cells, which is more than the maximum of " << maximum_number_of_cells_ << " cells (increase the cell resolution)");
+		return false;
+	}
+
+	origin_x_ = min_x - kernel_radius * cell_resolution_;
+	origin_y_ = min_y - kernel_radius * cell_resolution_;
+	size_x_ = (int)number_of_cells_x;
+	size_y_ = (int)number_of_cells_y;
+	levels_.resize(1);
+	std::vector<std::uint8_t>& grid = levels_[0];
+	grid.assign((size_t)size_x_ * (size_t)size_y_, 0);
+
+	// likelihood of the cells around each point (the kernel is the same for all points, only changing the offset of the point inside its cell)
+	const double inverse_two_sigma_squared = (likelihood_field_sigma_ > 0.0 ? 1.0 / (2.0 * likelihood_field_sigma_ * likelihood_field_sigma_) : 0.0);
+	for (size_t i = 0; i < reference_cloud.size(); ++i) {
+		if (!pcl::isFinite(reference_cloud[i])) { continue; }
+		CellCoordinates point_cell = computeCellCoordinates(reference_cloud[i].x, reference_cloud[i].y);
+		for (int y = std::max(point_cell.y() - kernel_radius, 0); y <= std::min(point_cell.y() + kernel_radius, size_y_ - 1); ++y) {
+			const double distance_y = origin_y_ + (y + 0.5) * cell_resolution_ - reference_cloud[i].y;
+			for (int x = std::max(point_cell.x() - kernel_radius, 0); x <= std::min(point_cell.x() + kernel_radius, size_x_ - 1); ++x) {
+				const double distance_x = origin_x_ + (x + 0.5) * cell_resolution_ - reference_cloud[i].x;
+				const std::uint8_t likelihood = (x == point_cell.x() && y == point_cell.y()) ? 255 :
+						(std::uint8_t)std::round(255.0 * std::exp(-(distance_x * distance_x + distance_y * distance_y) * inverse_two_sigma_squared));
+				std::uint8_t& cell = grid[(size_t)y * (size_t)size_x_ + (size_t)x];
+				cell = std::max(cell, likelihood);
+			}
+		}
+	}
+
+	ROS_DEBUG_STREAM("Likelihood grid built with " << size_x_ << "x" << size_y_ << " cells of " << cell_resolution_ << " m from a reference cloud with " << reference_cloud.size() << " points");
+	return true;
+}
+
+
+template<typename PointT>
+void LikelihoodGrid2D<PointT>::computeMultiResolutionLevels(int number_of_levels) {
+	if (levels_.empty() || number_of_levels <= (int)levels_.size()) { return; }
+
+	for (int level = (int)levels_.size(); level < number_of_levels; ++level) {
+		// each cell is the maximum of the 4 cells of the previous level that cover its 2^level x 2^level window
+		const int half_window = 1 << (level - 1);
+		const int padding = (1 << level) - 1;
+		const int padded_size_x = size_x_ + padding;
+		const int padded_size_y = size_y_ + padding;
+		levels_.push_back(std::vector<std::uint8_t>((size_t)padded_size_x * (size_t)padded_size_y, 0));
+		std::vector<std::uint8_t>& grid = levels_.back();
+
+		#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+		for (int padded_y = 0; padded_y < padded_size_y; ++padded_y) {
+			const int y = padded_y - padding;
+			for (int padded_x = 0; padded_x < padded_size_x; ++padded_x) {
+				const int x = padded_x - padding;
+				grid[(size_t)padded_y * (size_t)padded_size_x + (size_t)padded_x] = std::max(
+						std::max(getCellLikelihood(x, y, level - 1), getCellLikelihood(x + half_window, y, level - 1)),
+						std::max(getCellLikelihood(x, y + half_window, level - 1), getCellLikelihood(x + half_window, y + half_window, level - 1)));
+			}
+		}
+	}
+}
+
+
+template<typename PointT>
+float LikelihoodGrid2D<PointT>::computeScore(const ScanCells& scan_cells, int offset_x, int offset_y, int level) const {
+	if (scan_cells.empty() || level >= (int)levels_.size()) { return 0.0f; }
+
+	std::uint64_t sum = 0;
+	for (size_t i = 0; i < scan_cells.size(); ++i) {
+		sum += getCellLikelihood(scan_cells[i].x() + offset_x, scan_cells[i].y() + offset_y, level);
+	}
+
+	return (float)((double)sum / (255.0 * (double)scan_cells.size()));
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </LikelihoodGrid2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
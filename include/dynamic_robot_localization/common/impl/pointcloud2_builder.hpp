@@ -0,0 +1,114 @@
+/**\file pointcloud2_builder.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/pointcloud2_builder.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloud2Builder-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void PointCloud2Builder::createNewCloudWithPointTypeLayout(std::string frame_id, size_t number_reserved_points) {
+	number_reserved_points_ = number_reserved_points;
+	resetPointcloudMsg(frame_id);
+
+	std::vector<pcl::PCLPointField> point_fields = pcl::getFields<PointT>();
+	pointcloud_msg_->fields.resize(point_fields.size());
+	for (size_t i = 0; i < point_fields.size(); ++i) {
+		pointcloud_msg_->fields[i].name = point_fields[i].name;
+		pointcloud_msg_->fields[i].offset = point_fields[i].offset;
+		pointcloud_msg_->fields[i].datatype = point_fields[i].datatype;
+		pointcloud_msg_->fields[i].count = point_fields[i].count;
+	}
+	pointcloud_msg_->point_step = sizeof(PointT);
+	pointcloud_msg_->data.reserve(number_reserved_points_ * pointcloud_msg_->point_step); // reserve memory to avoid reallocations
+}
+
+
+template<typename PointT>
+bool PointCloud2Builder::isFieldsLayoutEqualToPointType() const {
+	if (pointcloud_msg_->point_step != sizeof(PointT)) { return false; }
+
+	std::vector<pcl::PCLPointField> point_fields = pcl::getFields<PointT>();
+	if (point_fields.size() != pointcloud_msg_->fields.size()) { return false; }
+
+	for (size_t i = 0; i < point_fields.size(); ++i) {
+		const sensor_msgs::PointField& field = pointcloud_msg_->fields[i];
+		if (field.name != point_fields[i].name || field.offset != point_fields[i].offset || field.datatype != point_fields[i].datatype || field.count != point_fields[i].count) { return false; }
+	}
+
+	return true;
+}
+
+
+template<typename PointT>
+void PointCloud2Builder::addPoints(const pcl::PointCloud<PointT>& pointcloud, int number_of_threads) {
+	if (pointcloud.points.empty()) { return; }
+
+	std::uint8_t* data = addPoints(pointcloud.points.size());
+	if (!pointcloud.is_dense) { pointcloud_msg_->is_dense = false; }
+
+	if (isFieldsLayoutEqualToPointType<PointT>()) {
+		std::memcpy(data, pointcloud.points.data(), pointcloud.points.size() * sizeof(PointT));
+		return;
+	}
+
+	std::vector<FieldCopy> fields_copies;
+	std::vector<pcl::PCLPointField> point_fields = pcl::getFields<PointT>();
+	for (size_t i = 0; i < pointcloud_msg_->fields.size(); ++i) {
+		const sensor_msgs::PointField& msg_field = pointcloud_msg_->fields[i];
+		for (size_t j = 0; j < point_fields.size(); ++j) {
+			const pcl::PCLPointField& point_field = point_fields[j];
+			if (msg_field.name == point_field.name) {
+				FieldCopy field_copy;
+				field_copy.source_offset = point_field.offset;
+				field_copy.destination_offset = msg_field.offset;
+				field_copy.source_datatype = point_field.datatype;
+				field_copy.destination_datatype = msg_field.datatype;
+				field_copy.count = std::min(std::max(msg_field.count, (std::uint32_t)1), std::max(point_field.count, (std::uint32_t)1));
+				if ((point_field.name == "rgb" || point_field.name == "rgba") && getDatatypeSize(field_copy.source_datatype) == getDatatypeSize(field_copy.destination_datatype)) {
+					// packed colors must be copied bitwise (float rgb and uint32 rgba have the same memory representation)
+					field_copy.source_datatype = field_copy.destination_datatype;
+				}
+				fields_copies.push_back(field_copy);
+				break;
+			}
+		}
+	}
+
+	const size_t point_step = pointcloud_msg_->point_step;
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+	for (size_t point_index = 0; point_index < pointcloud.points.size(); ++point_index) {
+		const std::uint8_t* point_data = reinterpret_cast<const std::uint8_t*>(&pointcloud.points[point_index]);
+		std::uint8_t* msg_point_data = data + point_index * point_step;
+		for (size_t i = 0; i < fields_copies.size(); ++i) {
+			const FieldCopy& field_copy = fields_copies[i];
+			if (field_copy.source_datatype == field_copy.destination_datatype) {
+				std::memcpy(msg_point_data + field_copy.destination_offset, point_data + field_copy.source_offset, getDatatypeSize(field_copy.source_datatype) * field_copy.count);
+			} else {
+				size_t source_datatype_size = getDatatypeSize(field_copy.source_datatype);
+				size_t destination_datatype_size = getDatatypeSize(field_copy.destination_datatype);
+				for (std::uint32_t element = 0; element < field_copy.count; ++element) {
+					writeValue(msg_point_data + field_copy.destination_offset + element * destination_datatype_size, field_copy.destination_datatype,
+							readValue(point_data + field_copy.source_offset + element * source_datatype_size, field_copy.source_datatype));
+				}
+			}
+		}
+	}
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloud2Builder-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,251 @@
+/**\file pointcloud2_decoder.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/pointcloud2_decoder.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloud2Decoder-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+bool PointCloud2Decoder<PointT>::decode(const sensor_msgs::PointCloud2& pointcloud_msg, typename pcl::PointCloud<PointT>::Ptr& pointcloud) {
+	if (pointcloud_msg.data.size() < (size_t)pointcloud_msg.row_step * pointcloud_msg.height || (size_t)pointcloud_msg.point_step * pointcloud_msg.width > pointcloud_msg.row_step) { return false; }
+
+	const FieldsLayout* fields_layout = retrieveFieldsLayout(pointcloud_msg);
+	if (!fields_layout) { return false; }
+
+	if (!reusable_pointcloud_ || reusable_pointcloud_.use_count() > 1) {
+		reusable_pointcloud_.reset(new pcl::PointCloud<PointT>());
+	}
+
+	size_t number_of_points_in_msg = (size_t)pointcloud_msg.width * (size_t)pointcloud_msg.height;
+	reusable_pointcloud_->points.resize(number_of_points_in_msg);
+	number_of_discarded_nans_ = 0;
+	number_of_discarded_points_outside_limits_ = 0;
+	bool check_limits = hasLimits();
+	size_t number_of_decoded_points = 0;
+
+	int time_field_index = -1;
+	points_times_.clear();
+	if (!time_field_name_.empty()) {
+		for (size_t i = 0; i < pointcloud_msg.fields.size(); ++i) {
+			if (pointcloud_msg.fields[i].name == time_field_name_) { time_field_index = (int)i; break; }
+		}
+		if (time_field_index >= 0) { points_times_.resize(number_of_points_in_msg); }
+	}
+
+	for (std::uint32_t row = 0; row < pointcloud_msg.height; ++row) {
+		const std::uint8_t* point_data = &pointcloud_msg.data[(size_t)row * pointcloud_msg.row_step];
+		for (std::uint32_t column = 0; column < pointcloud_msg.width; ++column, point_data += pointcloud_msg.point_step) {
+			float x, y, z;
+			if (fields_layout->xyz_datatype == sensor_msgs::PointField::FLOAT32) {
+				std::memcpy(&x, point_data + fields_layout->x_offset, sizeof(float));
+				std::memcpy(&y, point_data + fields_layout->y_offset, sizeof(float));
+				std::memcpy(&z, point_data + fields_layout->z_offset, sizeof(float));
+			} else {
+				x = (float)readValue(point_data + fields_layout->x_offset, fields_layout->xyz_datatype);
+				y = (float)readValue(point_data + fields_layout->y_offset, fields_layout->xyz_datatype);
+				z = (float)readValue(point_data + fields_layout->z_offset, fields_layout->xyz_datatype);
+			}
+
+			if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+				++number_of_discarded_nans_;
+				continue;
+			}
+
+			if (check_limits && !isPointInsideLimits(x, y, z)) {
+				++number_of_discarded_points_outside_limits_;
+				continue;
+			}
+
+			if (time_field_index >= 0) {
+				points_times_[number_of_decoded_points] = readValue(point_data + pointcloud_msg.fields[time_field_index].offset, pointcloud_msg.fields[time_field_index].datatype);
+			}
+
+			PointT& point = reusable_pointcloud_->points[number_of_decoded_points++];
+			point = PointT();
+			std::uint8_t* point_fields_data = reinterpret_cast<std::uint8_t*>(&point);
+			for (size_t i = 0; i < fields_layout->fields_copies.size(); ++i) {
+				const FieldCopy& field_copy = fields_layout->fields_copies[i];
+				if (field_copy.source_datatype == field_copy.destination_datatype) {
+					std::memcpy(point_fields_data + field_copy.destination_offset, point_data + field_copy.source_offset, getDatatypeSize(field_copy.source_datatype) * field_copy.count);
+				} else {
+					size_t source_datatype_size = getDatatypeSize(field_copy.source_datatype);
+					size_t destination_datatype_size = getDatatypeSize(field_copy.destination_datatype);
+					for (std::uint32_t element = 0; element < field_copy.count; ++element) {
+						writeValue(point_fields_data + field_copy.destination_offset + element * destination_datatype_size, field_copy.destination_datatype,
+								readValue(point_data + field_copy.source_offset + element * source_datatype_size, field_copy.source_datatype));
+					}
+				}
+			}
+			point.x = x;
+			point.y = y;
+			point.z = z;
+		}
+	}
+
+	reusable_pointcloud_->points.resize(number_of_decoded_points);
+	if (time_field_index >= 0) { points_times_.resize(number_of_decoded_points); }
+	reusable_pointcloud_->width = number_of_decoded_points;
+	reusable_pointcloud_->height = 1;
+	reusable_pointcloud_->is_dense = true;
+	pcl_conversions::toPCL(pointcloud_msg.header, reusable_pointcloud_->header);
+	reusable_pointcloud_->sensor_origin_ = Eigen::Vector4f::Zero();
+	reusable_pointcloud_->sensor_orientation_ = Eigen::Quaternionf::Identity();
+	pointcloud = reusable_pointcloud_;
+	return true;
+}
+
+
+template<typename PointT>
+const typename PointCloud2Decoder<PointT>::FieldsLayout* PointCloud2Decoder<PointT>::retrieveFieldsLayout(const sensor_msgs::PointCloud2& pointcloud_msg) {
+	std::string fields_layout_key = computeFieldsLayoutKey(pointcloud_msg);
+	if (last_fields_layout_ && fields_layout_key == last_fields_layout_key_) { return last_fields_layout_; }
+
+	typename std::map<std::string, FieldsLayout>::iterator fields_layout_it = fields_layouts_.find(fields_layout_key);
+	if (fields_layout_it == fields_layouts_.end()) {
+		FieldsLayout fields_layout;
+		if (!computeFieldsLayout(pointcloud_msg, fields_layout)) { return nullptr; }
+		if (fields_layouts_.size() >= maximum_number_of_cached_layouts_) { fields_layouts_.clear(); }
+		fields_layout_it = fields_layouts_.insert(std::make_pair(fields_layout_key, fields_layout)).first;
+	}
+
+	last_fields_layout_key_ = fields_layout_key;
+	last_fields_layout_ = &fields_layout_it->second;
+	return last_fields_layout_;
+}
+
+
+template<typename PointT>
+bool PointCloud2Decoder<PointT>::computeFieldsLayout(const sensor_msgs::PointCloud2& pointcloud_msg, FieldsLayout& fields_layout) {
+	if (pointcloud_msg.is_bigendian) { return false; }
+
+	int x_index = -1, y_index = -1, z_index = -1;
+	for (size_t i = 0; i < pointcloud_msg.fields.size(); ++i) {
+		const sensor_msgs::PointField& field = pointcloud_msg.fields[i];
+		if (getDatatypeSize(field.datatype) == 0 || field.offset + getDatatypeSize(field.datatype) * std::max(field.count, (std::uint32_t)1) > pointcloud_msg.point_step) { return false; }
+		if (field.name == "x") { x_index = (int)i; }
+		else if (field.name == "y") { y_index = (int)i; }
+		else if (field.name == "z") { z_index = (int)i; }
+	}
+
+	if (x_index < 0 || y_index < 0 || z_index < 0) { return false; }
+
+	const sensor_msgs::PointField& x_field = pointcloud_msg.fields[x_index];
+	const sensor_msgs::PointField& y_field = pointcloud_msg.fields[y_index];
+	const sensor_msgs::PointField& z_field = pointcloud_msg.fields[z_index];
+	if (x_field.datatype != y_field.datatype || x_field.datatype != z_field.datatype) { return false; }
+
+	fields_layout.x_offset = x_field.offset;
+	fields_layout.y_offset = y_field.offset;
+	fields_layout.z_offset = z_field.offset;
+	fields_layout.xyz_datatype = x_field.datatype;
+	fields_layout.fields_copies.clear();
+
+	std::vector<pcl::PCLPointField> point_fields = pcl::getFields<PointT>();
+	for (size_t i = 0; i < point_fields.size(); ++i) {
+		const pcl::PCLPointField& point_field = point_fields[i];
+		if (point_field.name == "x" || point_field.name == "y" || point_field.name == "z" || point_field.name == "_") { continue; }
+
+		for (size_t j = 0; j < pointcloud_msg.fields.size(); ++j) {
+			const sensor_msgs::PointField& msg_field = pointcloud_msg.fields[j];
+			if (fieldNamesMatch(msg_field.name, point_field.name)) {
+				FieldCopy field_copy;
+				field_copy.source_offset = msg_field.offset;
+				field_copy.destination_offset = point_field.offset;
+				field_copy.source_datatype = msg_field.datatype;
+				field_copy.destination_datatype = point_field.datatype;
+				field_copy.count = std::min(std::max(msg_field.count, (std::uint32_t)1), std::max(point_field.count, (std::uint32_t)1));
+				if ((point_field.name == "rgb" || point_field.name == "rgba") && getDatatypeSize(field_copy.source_datatype) == getDatatypeSize(field_copy.destination_datatype)) {
+					// packed colors must be copied bitwise (float rgb and uint32 rgba have the same memory representation)
+					field_copy.source_datatype = field_copy.destination_datatype;
+				}
+				fields_layout.fields_copies.push_back(field_copy);
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+template<typename PointT>
+std::string PointCloud2Decoder<PointT>::computeFieldsLayoutKey(const sensor_msgs::PointCloud2& pointcloud_msg) {
+	std::stringstream fields_layout_key;
+	fields_layout_key << pointcloud_msg.point_step << (pointcloud_msg.is_bigendian ? "B" : "L");
+	for (size_t i = 0; i < pointcloud_msg.fields.size(); ++i) {
+		const sensor_msgs::PointField& field = pointcloud_msg.fields[i];
+		fields_layout_key << "|" << field.name << ":" << field.offset << ":" << (int)field.datatype << ":" << field.count;
+	}
+	return fields_layout_key.str();
+}
+
+
+template<typename PointT>
+bool PointCloud2Decoder<PointT>::fieldNamesMatch(const std::string& source_field_name, const std::string& destination_field_name) {
+	if (source_field_name == destination_field_name) { return true; }
+	// same convention as pcl::fromROSMsg (rgb and rgba share the same packed representation)
+	return (source_field_name == "rgb" && destination_field_name == "rgba") || (source_field_name == "rgba" && destination_field_name == "rgb");
+}
+
+
+template<typename PointT>
+size_t PointCloud2Decoder<PointT>::getDatatypeSize(std::uint8_t datatype) {
+	return PointCloud2Builder::getDatatypeSize(datatype);
+}
+
+
+template<typename PointT>
+double PointCloud2Decoder<PointT>::readValue(const std::uint8_t* data, std::uint8_t datatype) {
+	return PointCloud2Builder::readValue(data, datatype);
+}
+
+
+template<typename PointT>
+void PointCloud2Decoder<PointT>::writeValue(std::uint8_t* data, std::uint8_t datatype, double value) {
+	PointCloud2Builder::writeValue(data, datatype, value);
+}
+
+
+template<typename PointT>
+bool PointCloud2Decoder<PointT>::isPointInsideLimits(float x, float y, float z) const {
+	if (x < box_min_x_ || x > box_max_x_ || y < box_min_y_ || y > box_max_y_ || z < box_min_z_ || z > box_max_z_) { return false; }
+
+	if (minimum_range_ > 0.0f || maximum_range_ > 0.0f) {
+		float range_squared = x * x + y * y + z * z;
+		if (minimum_range_ > 0.0f && range_squared < minimum_range_ * minimum_range_) { return false; }
+		if (maximum_range_ > 0.0f && range_squared > maximum_range_ * maximum_range_) { return false; }
+	}
+
+	return true;
+}
+
+
+template<typename PointT>
+bool PointCloud2Decoder<PointT>::hasLimits() const {
+	return box_min_x_ > -std::numeric_limits<float>::max() || box_min_y_ > -std::numeric_limits<float>::max() || box_min_z_ > -std::numeric_limits<float>::max()
+			|| box_max_x_ < std::numeric_limits<float>::max() || box_max_y_ < std::numeric_limits<float>::max() || box_max_z_ < std::numeric_limits<float>::max()
+			|| minimum_range_ > 0.0f || maximum_range_ > 0.0f;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloud2Decoder-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+// =============================================================================   <private-section>   =========================================================================
+// =============================================================================   </private-section>  =========================================================================
+} /* namespace dynamic_robot_localization */
@@ -7,6 +7,10 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 #include <dynamic_robot_localization/common/pointcloud_conversions.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 namespace dynamic_robot_localization {
@@ -14,11 +18,71 @@ namespace pointcloud_conversions {
 
 
 template<typename PointT>
-bool fromROSMsg(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<PointT>& pointcloud, OccupancyGridValuesPtr occupancy_grid_values, int threshold_for_map_cell_as_obstacle) {
+typename std::enable_if<pcl::traits::has_normal<PointT>::value>::type setOccupancyGridCellNormal(PointT& point, float normal_x, float normal_y, float normal_z) {
+	point.normal_x = normal_x;
+	point.normal_y = normal_y;
+	point.normal_z = normal_z;
+}
+
+template<typename PointT>
+typename std::enable_if<!pcl::traits::has_normal<PointT>::value>::type setOccupancyGridCellNormal(PointT&, float, float, float) {}
+
+
+inline bool isOccupancyGridCellFree(const nav_msgs::OccupancyGrid& occupancy_grid, int x, int y, int threshold_for_map_cell_as_obstacle) {
+	if (x < 0 || y < 0 || x >= (int)occupancy_grid.info.width || y >= (int)occupancy_grid.info.height) { return false; }
+	signed char cell_value = occupancy_grid.data[(size_t)y * occupancy_grid.info.width + x];
+	return cell_value >= 0 && cell_value <= threshold_for_map_cell_as_obstacle;
+}
+
+
+inline bool isOccupancyGridCellInBoundary(const nav_msgs::OccupancyGrid& occupancy_grid, int x, int y, int threshold_for_map_cell_as_obstacle) {
+	return isOccupancyGridCellFree(occupancy_grid, x - 1, y, threshold_for_map_cell_as_obstacle) || isOccupancyGridCellFree(occupancy_grid, x + 1, y, threshold_for_map_cell_as_obstacle)
+			|| isOccupancyGridCellFree(occupancy_grid, x, y - 1, threshold_for_map_cell_as_obstacle) || isOccupancyGridCellFree(occupancy_grid, x, y + 1, threshold_for_map_cell_as_obstacle);
+}
+
+
+/// Direction (in grid coordinates) from the occupied cell to its free 8 neighbors (returns false for cells without free neighbors)
+inline bool computeOccupancyGridCellNormal(const nav_msgs::OccupancyGrid& occupancy_grid, int x, int y, int threshold_for_map_cell_as_obstacle, float& normal_x, float& normal_y) {
+	normal_x = 0.0f;
+	normal_y = 0.0f;
+	int first_free_neighbor_x = 0, first_free_neighbor_y = 0;
+	bool has_free_neighbor = false;
+	for (int y_offset = -1; y_offset <= 1; ++y_offset) {
+		for (int x_offset = -1; x_offset <= 1; ++x_offset) {
+			if ((x_offset != 0 || y_offset != 0) && isOccupancyGridCellFree(occupancy_grid, x + x_offset, y + y_offset, threshold_for_map_cell_as_obstacle)) {
+				float weight = (x_offset != 0 && y_offset != 0) ? 1.0f : 2.0f; // sobel weights
+				normal_x += weight * x_offset;
+				normal_y += weight * y_offset;
+				if (!has_free_neighbor) {
+					first_free_neighbor_x = x_offset;
+					first_free_neighbor_y = y_offset;
+					has_free_neighbor = true;
+				}
+			}
+		}
+	}
+
+	if (!has_free_neighbor) { return false; }
+
+	if (normal_x == 0.0f && normal_y == 0.0f) { // thin walls with free space on opposite sides
+		normal_x = (float)first_free_neighbor_x;
+		normal_y = (float)first_free_neighbor_y;
+	}
+
+	float normal_norm = std::sqrt(normal_x * normal_x + normal_y * normal_y);
+	normal_x /= normal_norm;
+	normal_y /= normal_norm;
+	return true;
+}
+
+
+template<typename PointT>
+bool fromROSMsg(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<PointT>& pointcloud, OccupancyGridValuesPtr occupancy_grid_values, int threshold_for_map_cell_as_obstacle,
+		bool extract_only_boundary_cells, bool compute_normals_from_occupancy_gradient, int number_of_threads) {
 	if (occupancy_grid.data.size() > 0 && (occupancy_grid.data.size() == (occupancy_grid.info.width * occupancy_grid.info.height))) {
 		float map_resolution = occupancy_grid.info.resolution;
-		unsigned int map_width = occupancy_grid.info.width;
-		unsigned int map_height = occupancy_grid.info.height;
+		int map_width = (int)occupancy_grid.info.width;
+		int map_height = (int)occupancy_grid.info.height;
 
 		float map_origin_x = occupancy_grid.info.origin.position.x + map_resolution / 2.0;
 		float map_origin_y = occupancy_grid.info.origin.position.y + map_resolution / 2.0;
@@ -27,34 +91,75 @@ bool fromROSMsg(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<P
 				Eigen::Transform<float, 3, Eigen::Affine>(Eigen::Translation3f(map_origin_x, map_origin_y, 0)) *
 				Eigen::Transform<float, 3, Eigen::Affine>(Eigen::Quaternionf(occupancy_grid.info.origin.orientation.w, occupancy_grid.info.origin.orientation.x, occupancy_grid.info.origin.orientation.y, occupancy_grid.info.origin.orientation.z));
 
-		pointcloud.height = 1;
-		pointcloud.is_dense = false;
 		pointcloud.header.frame_id = occupancy_grid.header.frame_id;
 		pointcloud.header.stamp = occupancy_grid.header.stamp.toNSec() / 1e3;
-		pointcloud.clear();
 
-		size_t data_position = 0;
-		PointT new_point;
-		for (unsigned int y = 0; y < map_height; ++y) {
-			float x_map = 0.0;
+		// first pass -> count the selected cells in each row for knowing where each row will be stored
+		std::vector<size_t> rows_offsets((size_t)map_height + 1, 0);
+		#pragma omp parallel for schedule(dynamic, 16) num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+		for (int y = 0; y < map_height; ++y) {
+			size_t data_position = (size_t)y * map_width;
+			size_t number_of_selected_cells = 0;
+			for (int x = 0; x < map_width; ++x, ++data_position) {
+				if (occupancy_grid.data[data_position] > threshold_for_map_cell_as_obstacle && (!extract_only_boundary_cells || isOccupancyGridCellInBoundary(occupancy_grid, x, y, threshold_for_map_cell_as_obstacle))) {
+					++number_of_selected_cells;
+				}
+			}
+			rows_offsets[y + 1] = number_of_selected_cells;
+		}
+
+		for (int y = 0; y < map_height; ++y) {
+			rows_offsets[y + 1] += rows_offsets[y];
+		}
+
+		size_t number_of_points = rows_offsets.back();
+		pointcloud.resize(number_of_points);
+		pointcloud.width = number_of_points;
+		pointcloud.height = 1;
+		pointcloud.is_dense = false;
+
+		size_t occupancy_grid_values_offset = 0;
+		if (occupancy_grid_values) {
+			occupancy_grid_values_offset = occupancy_grid_values->size();
+			occupancy_grid_values->resize(occupancy_grid_values_offset + number_of_points);
+		}
+
+		// second pass -> fill each row in its preallocated range
+		#pragma omp parallel for schedule(dynamic, 16) num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+		for (int y = 0; y < map_height; ++y) {
+			size_t data_position = (size_t)y * map_width;
+			size_t point_index = rows_offsets[y];
 			float y_map = (float)y * map_resolution;
-			for (unsigned int x = 0; x < map_width; ++x) {
-				if (occupancy_grid.data[data_position] > threshold_for_map_cell_as_obstacle) {
-					x_map = (float)x * map_resolution;
+			for (int x = 0; x < map_width; ++x, ++data_position) {
+				if (occupancy_grid.data[data_position] > threshold_for_map_cell_as_obstacle && (!extract_only_boundary_cells || isOccupancyGridCellInBoundary(occupancy_grid, x, y, threshold_for_map_cell_as_obstacle))) {
+					float x_map = (float)x * map_resolution;
+					PointT new_point;
 					new_point.x = transform (0, 0) * x_map + transform (0, 1) * y_map + transform (0, 3);
 					new_point.y = transform (1, 0) * x_map + transform (1, 1) * y_map + transform (1, 3);
-					pointcloud.push_back(new_point);
 
+					if (compute_normals_from_occupancy_gradient) {
+						float normal_x, normal_y;
+						if (computeOccupancyGridCellNormal(occupancy_grid, x, y, threshold_for_map_cell_as_obstacle, normal_x, normal_y)) {
+							// normals point to the free space
+							setOccupancyGridCellNormal(new_point,
+									transform (0, 0) * normal_x + transform (0, 1) * normal_y,
+									transform (1, 0) * normal_x + transform (1, 1) * normal_y,
+									transform (2, 0) * normal_x + transform (2, 1) * normal_y);
+						} else {
+							float nan = std::numeric_limits<float>::quiet_NaN();
+							setOccupancyGridCellNormal(new_point, nan, nan, nan);
+						}
+					}
+
+					pointcloud[point_index] = new_point;
 					if (occupancy_grid_values) {
-						occupancy_grid_values->push_back(occupancy_grid.data[data_position]);
+						(*occupancy_grid_values)[occupancy_grid_values_offset + point_index] = occupancy_grid.data[data_position];
 					}
+					++point_index;
 				}
-
-				++data_position;
 			}
 		}
 
-		pointcloud.width = pointcloud.size();
 		return true;
 	}
 
@@ -144,6 +249,296 @@ size_t flipPointCloudNormalsUsingOccpancyGrid(const nav_msgs::OccupancyGrid& occ
 }
 
 
+template<typename PointT>
+std::uint64_t computePointTypeSignature() {
+	std::stringstream point_type_description;
+	point_type_description << sizeof(PointT);
+	std::vector<pcl::PCLPointField> fields = pcl::getFields<PointT>();
+	for (size_t i = 0; i < fields.size(); ++i) {
+		point_type_description << "|" << fields[i].name << ":" << fields[i].offset << ":" << (int)fields[i].datatype << ":" << fields[i].count;
+	}
+
+	std::string point_type_description_str = point_type_description.str();
+	return computeHash(point_type_description_str.data(), point_type_description_str.size());
+}
+
+
+template<typename PointT>
+bool fromBinaryFile(pcl::PointCloud<PointT>& pointcloud, const std::string& filepath) {
+	std::FILE* file = std::fopen(filepath.c_str(), "rb");
+	if (!file) { return false; }
+
+	// the number of points in the header is checked against the file size before allocating memory for them (avoids huge allocations with corrupted files)
+	struct stat file_status;
+	if (::fstat(::fileno(file), &file_status) != 0) {
+		std::fclose(file);
+		return false;
+	}
+	const std::uint64_t file_size = (std::uint64_t)file_status.st_size;
+
+	BinaryPointCloudFileHeader header;
+	bool valid_header = file_size >= sizeof(header) && std::fread(&header, sizeof(header), 1, file) == 1
+			&& std::memcmp(header.magic, BINARY_POINTCLOUD_FILE_MAGIC, sizeof(header.magic)) == 0
+			&& header.version == BINARY_POINTCLOUD_FILE_VERSION
+			&& header.endianness_marker == BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER
+			&& header.header_size == sizeof(BinaryPointCloudFileHeader)
+			&& header.point_size == sizeof(PointT)
+			&& header.point_type_signature == computePointTypeSignature<PointT>()
+			&& (std::uint64_t)header.width * header.height == header.number_of_points;
+
+	if (valid_header && (header.number_of_points > (file_size - sizeof(header)) / sizeof(PointT) || sizeof(header) + header.number_of_points * sizeof(PointT) != file_size)) {
+		ROS_WARN_STREAM("File [" << filepath << "] has " << file_size << " bytes, which does not match the " << header.number_of_points << " points stated in its header (truncated or corrupted file)");
+		std::fclose(file);
+		return false;
+	}
+
+	if (!valid_header) {
+		ROS_WARN_STREAM("File [" << filepath << "] is not a binary point cloud file with version " << BINARY_POINTCLOUD_FILE_VERSION << " and a point type compatible with the one being loaded");
+		std::fclose(file);
+		return false;
+	}
+
+	pointcloud.points.resize(header.number_of_points);
+	bool points_loaded = header.number_of_points == 0 || std::fread(pointcloud.points.data(), sizeof(PointT), header.number_of_points, file) == header.number_of_points;
+	std::fclose(file);
+
+	if (!points_loaded) {
+		ROS_WARN_STREAM("File [" << filepath << "] is truncated");
+		pointcloud.clear();
+		return false;
+	}
+
+	pointcloud.width = header.width;
+	pointcloud.height = header.height;
+	pointcloud.is_dense = header.is_dense != 0;
+	pointcloud.sensor_origin_ = Eigen::Vector4f(header.sensor_origin[0], header.sensor_origin[1], header.sensor_origin[2], header.sensor_origin[3]);
+	pointcloud.sensor_orientation_ = Eigen::Quaternionf(header.sensor_orientation[0], header.sensor_orientation[1], header.sensor_orientation[2], header.sensor_orientation[3]);
+	return true;
+}
+
+
+template<typename PointT>
+bool toBinaryFile(const std::string& filepath, const pcl::PointCloud<PointT>& pointcloud) {
+	const std::uint32_t endianness_marker = BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER;
+	if (*reinterpret_cast<const std::uint8_t*>(&endianness_marker) != 0x04) {
+		ROS_WARN("Binary point cloud files can only be saved in little endian platforms");
+		return false;
+	}
+
+	BinaryPointCloudFileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, BINARY_POINTCLOUD_FILE_MAGIC, sizeof(header.magic));
+	header.version = BINARY_POINTCLOUD_FILE_VERSION;
+	header.endianness_marker = BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER;
+	header.header_size = sizeof(BinaryPointCloudFileHeader);
+	header.point_size = sizeof(PointT);
+	header.point_type_signature = computePointTypeSignature<PointT>();
+	header.number_of_points = pointcloud.points.size();
+	bool organized = (std::uint64_t)pointcloud.width * pointcloud.height == pointcloud.points.size();
+	header.width = organized ? pointcloud.width : (std::uint32_t)pointcloud.points.size();
+	header.height = organized ? pointcloud.height : 1;
+	header.is_dense = pointcloud.is_dense ? 1 : 0;
+	for (int i = 0; i < 4; ++i) { header.sensor_origin[i] = pointcloud.sensor_origin_(i); }
+	header.sensor_orientation[0] = pointcloud.sensor_orientation_.w();
+	header.sensor_orientation[1] = pointcloud.sensor_orientation_.x();
+	header.sensor_orientation[2] = pointcloud.sensor_orientation_.y();
+	header.sensor_orientation[3] = pointcloud.sensor_orientation_.z();
+
+	std::FILE* file = std::fopen(filepath.c_str(), "wb");
+	if (!file) { return false; }
+	bool saved = std::fwrite(&header, sizeof(header), 1, file) == 1
+			&& (pointcloud.points.empty() || std::fwrite(pointcloud.points.data(), sizeof(PointT), pointcloud.points.size(), file) == pointcloud.points.size());
+	saved = (std::fclose(file) == 0) && saved;
+	return saved;
+}
+
+
+template<typename PointT>
+std::uint64_t computePointCloudSignature(const pcl::PointCloud<PointT>& pointcloud) {
+	std::uint64_t signature = computeHash(nullptr, 0);
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		const PointT& point = pointcloud[i];
+		const float point_data[6] = { point.x, point.y, point.z, point.normal_x, point.normal_y, point.normal_z };
+		signature = computeHash(point_data, sizeof(point_data), signature);
+	}
+	return signature;
+}
+
+
+template<typename FeatureT>
+bool fromDescriptorsCacheFile(pcl::PointCloud<FeatureT>& descriptors, const std::string& filepath, const DescriptorsCacheSignature& expected_signature) {
+	int file_descriptor = ::open(filepath.c_str(), O_RDONLY);
+	if (file_descriptor < 0) { return false; }
+
+	struct stat file_status;
+	if (::fstat(file_descriptor, &file_status) != 0 || (size_t)file_status.st_size < sizeof(DescriptorsCacheFileHeader)) {
+		::close(file_descriptor);
+		ROS_WARN_STREAM("File [" << filepath << "] is not a keypoint descriptors cache file");
+		return false;
+	}
+
+	size_t file_size = (size_t)file_status.st_size;
+	void* file_data = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+	::close(file_descriptor);
+	if (file_data == MAP_FAILED) { return false; }
+	::madvise(file_data, file_size, MADV_SEQUENTIAL);
+
+	DescriptorsCacheFileHeader header;
+	std::memcpy(&header, file_data, sizeof(header));
+	bool valid_header = std::memcmp(header.magic, DESCRIPTORS_CACHE_FILE_MAGIC, sizeof(header.magic)) == 0
+			&& header.version == DESCRIPTORS_CACHE_FILE_VERSION
+			&& header.endianness_marker == BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER
+			&& header.header_size == sizeof(DescriptorsCacheFileHeader)
+			&& header.descriptor_size == sizeof(FeatureT)
+			&& header.descriptor_type_signature == computePointTypeSignature<FeatureT>()
+			&& header.number_of_descriptors <= (file_size - header.header_size) / header.descriptor_size
+			&& file_size == header.header_size + header.number_of_descriptors * header.descriptor_size;
+
+	bool valid_signature = valid_header
+			&& header.signature.number_of_keypoints == expected_signature.number_of_keypoints
+			&& header.signature.keypoints_signature == expected_signature.keypoints_signature
+			&& header.signature.number_of_surface_points == expected_signature.number_of_surface_points
+			&& header.signature.configuration_signature == expected_signature.configuration_signature;
+
+	if (valid_signature) {
+		descriptors.points.resize(header.number_of_descriptors);
+		if (header.number_of_descriptors > 0) {
+			std::memcpy(descriptors.points.data(), static_cast<const std::uint8_t*>(file_data) + header.header_size, header.number_of_descriptors * sizeof(FeatureT));
+		}
+		descriptors.width = (std::uint32_t)header.number_of_descriptors;
+		descriptors.height = 1;
+		descriptors.is_dense = header.is_dense != 0;
+	} else if (!valid_header) {
+		ROS_WARN_STREAM("File [" << filepath << "] is not a keypoint descriptors cache file with version " << DESCRIPTORS_CACHE_FILE_VERSION << " and a descriptor type compatible with the one being loaded");
+	} else {
+		ROS_WARN_STREAM("Keypoint descriptors cache file [" << filepath << "] was computed with different keypoints, reference point cloud or descriptor configuration");
+	}
+
+	::munmap(file_data, file_size);
+	return valid_signature;
+}
+
+
+template<typename FeatureT>
+bool toDescriptorsCacheFile(const std::string& filepath, const pcl::PointCloud<FeatureT>& descriptors, const DescriptorsCacheSignature& signature) {
+	const std::uint32_t endianness_marker = BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER;
+	if (*reinterpret_cast<const std::uint8_t*>(&endianness_marker) != 0x04) {
+		ROS_WARN("Keypoint descriptors cache files can only be saved in little endian platforms");
+		return false;
+	}
+
+	DescriptorsCacheFileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, DESCRIPTORS_CACHE_FILE_MAGIC, sizeof(header.magic));
+	header.version = DESCRIPTORS_CACHE_FILE_VERSION;
+	header.endianness_marker = BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER;
+	header.header_size = sizeof(DescriptorsCacheFileHeader);
+	header.descriptor_size = sizeof(FeatureT);
+	header.descriptor_type_signature = computePointTypeSignature<FeatureT>();
+	header.number_of_descriptors = descriptors.points.size();
+	header.signature = signature;
+	header.is_dense = descriptors.is_dense ? 1 : 0;
+
+	std::FILE* file = std::fopen(filepath.c_str(), "wb");
+	if (!file) { return false; }
+	bool saved = std::fwrite(&header, sizeof(header), 1, file) == 1
+			&& (descriptors.points.empty() || std::fwrite(descriptors.points.data(), sizeof(FeatureT), descriptors.points.size(), file) == descriptors.points.size());
+	saved = (std::fclose(file) == 0) && saved;
+	return saved;
+}
+
+
+template<typename PointT>
+size_t flipPointCloudNormalsUsingOccpancyGridNearestFreeCells(const nav_msgs::OccupancyGrid& occupancy_grid, const std::vector<int>& nearest_free_cells, pcl::PointCloud<PointT>& pointcloud, float search_radius, int number_of_threads) {
+	int map_width = (int)occupancy_grid.info.width;
+	int map_height = (int)occupancy_grid.info.height;
+	if (nearest_free_cells.size() != (size_t)map_width * map_height || occupancy_grid.data.size() != nearest_free_cells.size() || nearest_free_cells.empty() || occupancy_grid.info.resolution <= 0.0f) { return 0; }
+
+	float map_resolution = occupancy_grid.info.resolution;
+	int search_radius_in_cells = std::max(1, (int)std::ceil(search_radius / map_resolution));
+	float minimum_free_cell_direction_squared_norm = 0.25f * map_resolution * map_resolution;
+	Eigen::Transform<float, 3, Eigen::Affine> transform =
+			Eigen::Transform<float, 3, Eigen::Affine>(Eigen::Translation3f(occupancy_grid.info.origin.position.x, occupancy_grid.info.origin.position.y, occupancy_grid.info.origin.position.z)) *
+			Eigen::Transform<float, 3, Eigen::Affine>(Eigen::Quaternionf(occupancy_grid.info.origin.orientation.w, occupancy_grid.info.origin.orientation.x, occupancy_grid.info.origin.orientation.y, occupancy_grid.info.origin.orientation.z));
+	Eigen::Transform<float, 3, Eigen::Affine> transform_inverse = transform.inverse();
+
+	size_t number_of_flipped_normals = 0;
+	#pragma omp parallel for schedule(static) reduction(+:number_of_flipped_normals) num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+	for (int i = 0; i < (int)pointcloud.size(); ++i) {
+		PointT& current_point = pointcloud[i];
+		Eigen::Vector3f point_in_grid = transform_inverse * Eigen::Vector3f(current_point.x, current_point.y, current_point.z);
+		int cell_x = (int)std::floor(point_in_grid.x() / map_resolution);
+		int cell_y = (int)std::floor(point_in_grid.y() / map_resolution);
+		if (cell_x < 0 || cell_y < 0 || cell_x >= map_width || cell_y >= map_height) { continue; }
+
+		float free_cell_direction_x = 0.0f;
+		float free_cell_direction_y = 0.0f;
+		size_t cell = (size_t)cell_y * map_width + cell_x;
+		if (occupancy_grid.data[cell] != 0) {
+			int nearest_free_cell = nearest_free_cells[cell];
+			if (nearest_free_cell >= 0) {
+				free_cell_direction_x = ((nearest_free_cell % map_width) + 0.5f) * map_resolution - point_in_grid.x();
+				free_cell_direction_y = ((nearest_free_cell / map_width) + 0.5f) * map_resolution - point_in_grid.y();
+			}
+		} else {
+			// the nearest free cell of a free cell is itself -> use the direction from the nearest occupied neighbor cell to its nearest free cell
+			int nearest_occupied_cell = -1;
+			float nearest_occupied_cell_squared_distance = std::numeric_limits<float>::max();
+			for (int y = std::max(0, cell_y - 1); y <= std::min(map_height - 1, cell_y + 1); ++y) {
+				for (int x = std::max(0, cell_x - 1); x <= std::min(map_width - 1, cell_x + 1); ++x) {
+					int neighbor_cell = y * map_width + x;
+					if (occupancy_grid.data[neighbor_cell] <= 0 || nearest_free_cells[neighbor_cell] < 0) { continue; }
+					float distance_x = (x + 0.5f) * map_resolution - point_in_grid.x();
+					float distance_y = (y + 0.5f) * map_resolution - point_in_grid.y();
+					float squared_distance = distance_x * distance_x + distance_y * distance_y;
+					if (squared_distance < nearest_occupied_cell_squared_distance) {
+						nearest_occupied_cell_squared_distance = squared_distance;
+						nearest_occupied_cell = neighbor_cell;
+					}
+				}
+			}
+
+			if (nearest_occupied_cell >= 0) {
+				int nearest_free_cell = nearest_free_cells[nearest_occupied_cell];
+				free_cell_direction_x = (float)((nearest_free_cell % map_width) - (nearest_occupied_cell % map_width)) * map_resolution;
+				free_cell_direction_y = (float)((nearest_free_cell / map_width) - (nearest_occupied_cell / map_width)) * map_resolution;
+			}
+		}
+
+		Eigen::Vector3f normal_in_grid = transform_inverse.linear() * Eigen::Vector3f(current_point.normal_x, current_point.normal_y, current_point.normal_z);
+		float normal_alignment_with_free_space = 0.0f;
+		if (free_cell_direction_x * free_cell_direction_x + free_cell_direction_y * free_cell_direction_y >= minimum_free_cell_direction_squared_norm) {
+			normal_alignment_with_free_space = normal_in_grid.x() * free_cell_direction_x + normal_in_grid.y() * free_cell_direction_y;
+		} else {
+			// direction too short to be reliable -> vote of the free cells in each side of the line perpendicular to the normal (same as flipPointCloudNormalsUsingOccpancyGrid)
+			int number_empty_cells_in_normal_side = 0;
+			int number_empty_cells_in_opposite_side = 0;
+			for (int y = std::max(0, cell_y - search_radius_in_cells); y <= std::min(map_height - 1, cell_y + search_radius_in_cells); ++y) {
+				for (int x = std::max(0, cell_x - search_radius_in_cells); x <= std::min(map_width - 1, cell_x + search_radius_in_cells); ++x) {
+					if (occupancy_grid.data[y * map_width + x] != 0) { continue; }
+					float cell_side = normal_in_grid.x() * ((x + 0.5f) * map_resolution - point_in_grid.x()) + normal_in_grid.y() * ((y + 0.5f) * map_resolution - point_in_grid.y());
+					if (cell_side > 0.0f) {
+						++number_empty_cells_in_normal_side;
+					} else if (cell_side < 0.0f) {
+						++number_empty_cells_in_opposite_side;
+					}
+				}
+			}
+			normal_alignment_with_free_space = (float)(number_empty_cells_in_normal_side - number_empty_cells_in_opposite_side);
+		}
+
+		if (normal_alignment_with_free_space < 0.0f) {
+			++number_of_flipped_normals;
+			current_point.normal_x *= -1.0;
+			current_point.normal_y *= -1.0;
+			current_point.normal_z *= -1.0;
+		}
+	}
+
+	return number_of_flipped_normals;
+}
+
+
 template<typename PointCloudT>
 bool fromFile(PointCloudT& pointcloud, const std::string& filename, const std::string& folder) {
 	if (filename.empty()) return false;
@@ -157,7 +552,9 @@ bool fromFile(PointCloudT& pointcloud, const std::string& filename, const std::s
 
 	ROS_INFO_STREAM("Loading point cloud with extension [" << extension << "] from file path [" << filepath << "]");
 
-	if (extension == "pcd") {
+	if (extension == BINARY_POINTCLOUD_FILE_EXTENSION) {
+		if (fromBinaryFile(pointcloud, filepath) && !pointcloud.empty()) return true;
+	} else if (extension == "pcd") {
 		if (pcl::io::loadPCDFile(filepath, pointcloud) == 0 && !pointcloud.empty()) return true;
 	} else if (extension == "ply") {
 		if (pcl::io::loadPLYFile(filepath, pointcloud) == 0 && !pointcloud.empty()) {
@@ -191,7 +588,9 @@ bool toFile(const std::string& filename, const PointCloudT& pointcloud, bool sav
 
 	ROS_INFO_STREAM("Saving point cloud with " << pointcloud.size() << " points and extension [" << extension << "] to file path [" << filepath << "]");
 
-	if (extension == "pcd") {
+	if (extension == BINARY_POINTCLOUD_FILE_EXTENSION) {
+		if (toBinaryFile(filepath, pointcloud)) return true;
+	} else if (extension == "pcd") {
 		if (pcl::io::savePCDFile(filepath, pointcloud, save_in_binary_format) == 0) return true;
 	} else if (extension == "ply") {
 		if (pcl::io::savePLYFile(filepath, pointcloud, save_in_binary_format) == 0) return true;
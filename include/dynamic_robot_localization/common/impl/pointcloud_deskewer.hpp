@@ -0,0 +1,117 @@
+/**\file pointcloud_deskewer.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/pointcloud_deskewer.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloudDeskewer-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+bool PointCloudDeskewer<PointT>::extractPointsTimes(const sensor_msgs::PointCloud2& pointcloud_msg, const std::string& time_field_name, std::vector<double>& points_times_out) {
+	points_times_out.clear();
+	if (pointcloud_msg.is_bigendian) { return false; }
+
+	int time_field_index = -1;
+	for (size_t i = 0; i < pointcloud_msg.fields.size(); ++i) {
+		if (pointcloud_msg.fields[i].name == time_field_name) { time_field_index = (int)i; break; }
+	}
+	if (time_field_index < 0) { return false; }
+
+	const sensor_msgs::PointField& time_field = pointcloud_msg.fields[time_field_index];
+	if (pointcloud_msg.data.size() < (size_t)pointcloud_msg.row_step * pointcloud_msg.height || time_field.offset + PointCloud2Builder::getDatatypeSize(time_field.datatype) > pointcloud_msg.point_step) { return false; }
+
+	points_times_out.resize((size_t)pointcloud_msg.width * (size_t)pointcloud_msg.height);
+	for (std::uint32_t row = 0; row < pointcloud_msg.height; ++row) {
+		const std::uint8_t* point_data = &pointcloud_msg.data[(size_t)row * pointcloud_msg.row_step + time_field.offset];
+		for (std::uint32_t column = 0; column < pointcloud_msg.width; ++column, point_data += pointcloud_msg.point_step) {
+			points_times_out[(size_t)row * pointcloud_msg.width + column] = PointCloud2Builder::readValue(point_data, time_field.datatype);
+		}
+	}
+
+	return true;
+}
+
+
+template<typename PointT>
+bool PointCloudDeskewer<PointT>::convertPointsTimesToSecondsRelativeToStamp(std::vector<double>& points_times, double msg_stamp_seconds, double& minimum_time_out, double& maximum_time_out) const {
+	minimum_time_out = std::numeric_limits<double>::max();
+	maximum_time_out = -std::numeric_limits<double>::max();
+	double time_offset = time_field_is_relative_to_msg_stamp_ ? 0.0 : -msg_stamp_seconds;
+	for (size_t i = 0; i < points_times.size(); ++i) {
+		double time = points_times[i] * time_field_scale_ + time_offset;
+		points_times[i] = time;
+		if (std::isfinite(time)) {
+			minimum_time_out = std::min(minimum_time_out, time);
+			maximum_time_out = std::max(maximum_time_out, time);
+		}
+	}
+	return minimum_time_out <= maximum_time_out;
+}
+
+
+template<typename PointT>
+void PointCloudDeskewer<PointT>::computeMotionSamplesTimes(double minimum_time, double maximum_time, std::vector<double>& motion_samples_times_out) const {
+	motion_samples_times_out.resize(number_of_motion_samples_);
+	double time_step = (maximum_time - minimum_time) / (double)(number_of_motion_samples_ - 1);
+	for (int i = 0; i < number_of_motion_samples_; ++i) {
+		motion_samples_times_out[i] = minimum_time + time_step * i;
+	}
+}
+
+
+template<typename PointT>
+void PointCloudDeskewer<PointT>::setMotionSamples(const std::vector<double>& motion_samples_times, const std::vector<MotionSample>& motion_samples) {
+	motion_samples_ = motion_samples;
+	motion_samples_start_time_ = motion_samples_times.empty() ? 0.0 : motion_samples_times.front();
+	motion_samples_time_step_ = motion_samples_times.size() < 2 ? 0.0 : (motion_samples_times.back() - motion_samples_times.front()) / (double)(motion_samples_times.size() - 1);
+}
+
+
+template<typename PointT>
+bool PointCloudDeskewer<PointT>::deskew(pcl::PointCloud<PointT>& pointcloud, const std::vector<double>& points_times) const {
+	if (motion_samples_.empty() || points_times.size() != pointcloud.size()) { return false; }
+
+	const int last_motion_sample_index = (int)motion_samples_.size() - 1;
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (size_t i = 0; i < pointcloud.size(); ++i) {
+		if (!std::isfinite(points_times[i])) { continue; }
+
+		int motion_sample_index = 0;
+		float interpolation_factor = 0.0f;
+		if (motion_samples_time_step_ > 0.0) {
+			double motion_sample_position = std::max(0.0, std::min((points_times[i] - motion_samples_start_time_) / motion_samples_time_step_, (double)last_motion_sample_index));
+			motion_sample_index = std::min((int)motion_sample_position, std::max(last_motion_sample_index - 1, 0));
+			interpolation_factor = (float)(motion_sample_position - motion_sample_index);
+		}
+
+		const MotionSample& motion_sample_start = motion_samples_[motion_sample_index];
+		const MotionSample& motion_sample_end = motion_samples_[std::min(motion_sample_index + 1, last_motion_sample_index)];
+		Eigen::Quaternionf rotation = motion_sample_start.rotation.slerp(interpolation_factor, motion_sample_end.rotation);
+		Eigen::Vector3f translation = motion_sample_start.translation + interpolation_factor * (motion_sample_end.translation - motion_sample_start.translation);
+
+		PointT& point = pointcloud.points[i];
+		Eigen::Vector3f point_deskewed = rotation * Eigen::Vector3f(point.x, point.y, point.z) + translation;
+		point.x = point_deskewed.x();
+		point.y = point_deskewed.y();
+		point.z = point_deskewed.z();
+	}
+
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloudDeskewer-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
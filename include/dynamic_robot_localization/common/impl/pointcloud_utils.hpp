@@ -14,11 +14,52 @@ namespace pointcloud_utils {
 
 
 template<typename PointT>
-void concatenatePointClouds(const std::vector< typename pcl::PointCloud<PointT>::Ptr >& pointclouds, typename pcl::PointCloud<PointT>::Ptr& pointcloud_out) {
-	if (pointcloud_out) {
-		for (size_t i = 0; i < pointclouds.size(); ++i) {
-			if (pointclouds[i] && !pointclouds[i]->empty()) {
-				*pointcloud_out += *(pointclouds[i]);
+void concatenatePointClouds(const std::vector< typename pcl::PointCloud<PointT>::Ptr >& pointclouds, typename pcl::PointCloud<PointT>::Ptr& pointcloud_out,
+		std::vector<size_t>* segments_offsets_out, int number_of_threads) {
+	if (!pointcloud_out) { return; }
+
+	std::vector<size_t> segments_offsets_local;
+	std::vector<size_t>& segments_offsets = segments_offsets_out ? *segments_offsets_out : segments_offsets_local;
+	segments_offsets.resize(pointclouds.size() + 1);
+
+	size_t number_of_points_in_output = pointcloud_out->size();
+	size_t number_of_non_empty_clouds = pointcloud_out->empty() ? 0 : 1;
+	int last_non_empty_cloud_index = -1;
+	bool is_dense = pointcloud_out->empty() ? true : pointcloud_out->is_dense;
+	for (size_t i = 0; i < pointclouds.size(); ++i) {
+		segments_offsets[i] = number_of_points_in_output;
+		if (pointclouds[i] && !pointclouds[i]->empty()) {
+			number_of_points_in_output += pointclouds[i]->size();
+			is_dense = is_dense && pointclouds[i]->is_dense;
+			++number_of_non_empty_clouds;
+			last_non_empty_cloud_index = (int)i;
+
+			if (pointcloud_out->header.frame_id.empty()) { pointcloud_out->header.frame_id = pointclouds[i]->header.frame_id; }
+			pointcloud_out->header.stamp = std::max(pointcloud_out->header.stamp, pointclouds[i]->header.stamp);
+		}
+	}
+	segments_offsets.back() = number_of_points_in_output;
+
+	if (last_non_empty_cloud_index < 0) { return; }
+
+	if (pointcloud_out->empty() && number_of_non_empty_clouds == 1) {
+		*pointcloud_out = *(pointclouds[last_non_empty_cloud_index]);
+		return;
+	}
+
+	pointcloud_out->points.resize(number_of_points_in_output);
+	pointcloud_out->width = number_of_points_in_output;
+	pointcloud_out->height = 1;
+	pointcloud_out->is_dense = is_dense;
+
+	#pragma omp parallel num_threads(number_of_threads > 0 ? number_of_threads : omp_get_max_threads())
+	for (size_t i = 0; i < pointclouds.size(); ++i) {
+		if (pointclouds[i] && !pointclouds[i]->empty()) {
+			const pcl::PointCloud<PointT>& pointcloud = *(pointclouds[i]);
+			size_t segment_offset = segments_offsets[i];
+			#pragma omp for schedule(static) nowait
+			for (size_t point_index = 0; point_index < pointcloud.size(); ++point_index) {
+				pointcloud_out->points[segment_offset + point_index] = pointcloud.points[point_index];
 			}
 		}
 	}
@@ -47,9 +88,7 @@ void colorizePointCloudWithCurvature(pcl::PointCloud<PointT>& pointcloud) {
 		hsv.v = 1.0;
 		pcl::PointXYZRGB rgb;
 		pcl::PointXYZHSVtoXYZRGB(hsv, rgb);
-		pointcloud[i].r = rgb.r;
-		pointcloud[i].g = rgb.g;
-		pointcloud[i].b = rgb.b;
+		setPointColor(pointcloud[i], rgb.r, rgb.g, rgb.b);
 	}
 }
 
@@ -60,9 +99,7 @@ void colorizePointCloudClusters(const pcl::PointCloud<PointT>& pointcloud, const
 		pcl::RGB cluster_color = pcl::GlasbeyLUT::at(cluster_index % pcl::GlasbeyLUT::size());
 		for (size_t point_index = 0; point_index < cluster_indices[cluster_index].indices.size(); ++point_index) {
 			PointT point = pointcloud[cluster_indices[cluster_index].indices[point_index]];
-			point.r = cluster_color.r;
-			point.g = cluster_color.g;
-			point.b = cluster_color.b;
+			setPointColor(point, cluster_color.r, cluster_color.g, cluster_color.b);
 			pointcloud_colored_out.push_back(point);
 		}
 	}
@@ -0,0 +1,138 @@
+/**\file voxel_covariance_map.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/voxel_covariance_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelCovarianceMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::updateReferenceCloud(const typename pcl::PointCloud<PointT>::ConstPtr& reference_cloud, const typename pcl::search::KdTree<PointT>::Ptr& search_method) {
+	reference_cloud_search_method_ = search_method;
+	VoxelHashMap<PointT, VoxelCovariance>::updateReferenceCloud(reference_cloud);
+	reference_cloud_search_method_.reset();
+}
+
+
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::computePointCovariances(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, const typename pcl::search::KdTree<PointT>::Ptr& search_method, bool use_normals,
+		Covariances& covariances_out, size_t first_point_index) const {
+	if (first_point_index >= pointcloud->size()) { covariances_out.clear(); return; }
+	const int number_of_points = (int)(pointcloud->size() - first_point_index);
+	if (covariances_out.size() != (size_t)number_of_points) { covariances_out.resize(number_of_points); }
+
+	// the k nearest neighbors must be searched in the full cloud (the given search method is only reused if it was built with the same cloud)
+	typename pcl::search::KdTree<PointT>::Ptr cloud_search_method = search_method;
+	if (!cloud_search_method || cloud_search_method->getInputCloud() != pointcloud) {
+		cloud_search_method.reset(new pcl::search::KdTree<PointT>());
+		cloud_search_method->setInputCloud(pointcloud);
+	}
+
+	#pragma omp parallel num_threads(VoxelHashMap<PointT, VoxelCovariance>::number_of_threads_ > 0 ? VoxelHashMap<PointT, VoxelCovariance>::number_of_threads_ : omp_get_max_threads())
+	{
+		pcl::Indices neighbors_indices;
+		std::vector<float> neighbors_squared_distances;
+
+		#pragma omp for schedule(static)
+		for (int i = 0; i < number_of_points; ++i) {
+			computePointCovariance(*pointcloud, *cloud_search_method, first_point_index + i, use_normals, neighbors_indices, neighbors_squared_distances, covariances_out[i]);
+		}
+	}
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelCovarianceMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::prepareNewPoints(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, size_t first_point_index) {
+	computePointCovariances(pointcloud, reference_cloud_search_method_, use_normals_for_reference_covariances_, new_points_covariances_, first_point_index);
+}
+
+
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::initializeVoxel(VoxelCovariance& voxel) const {
+	voxel.points_sum.setZero();
+	voxel.covariances_sum.setZero();
+	voxel.number_of_points = 0;
+	voxel.mean.setZero();
+	voxel.covariance.setIdentity();
+	voxel.valid = false;
+}
+
+
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::addPointToVoxel(const PointT& point, size_t new_point_index, VoxelCovariance& voxel) const {
+	voxel.points_sum += Eigen::Vector3d(point.x, point.y, point.z);
+	voxel.covariances_sum += new_points_covariances_[new_point_index];
+	++voxel.number_of_points;
+}
+
+
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::updateVoxel(VoxelCovariance& voxel) const {
+	const double number_of_points = (double)voxel.number_of_points;
+	voxel.mean = voxel.points_sum / number_of_points;
+	voxel.covariance = voxel.covariances_sum / number_of_points;
+	voxel.valid = voxel.number_of_points >= VoxelHashMap<PointT, VoxelCovariance>::minimum_number_of_points_per_voxel_;
+}
+
+
+template<typename PointT>
+void VoxelCovarianceMap<PointT>::computePointCovariance(const pcl::PointCloud<PointT>& pointcloud, const pcl::search::KdTree<PointT>& search_method, size_t point_index, bool use_normals,
+		pcl::Indices& neighbors_indices, std::vector<float>& neighbors_squared_distances, Eigen::Matrix3d& covariance_out) const {
+	covariance_out.setIdentity();
+	const PointT& point = pointcloud[point_index];
+	if (!pcl::isFinite(point)) { return; }
+
+	// plane covariance with the normal as the direction of smallest variance (same regularization as the generalized icp)
+	if (use_normals && std::isfinite(point.normal_x) && std::isfinite(point.normal_y) && std::isfinite(point.normal_z)) {
+		Eigen::Vector3d normal(point.normal_x, point.normal_y, point.normal_z);
+		double normal_norm = normal.norm();
+		if (normal_norm > 1e-6) {
+			normal /= normal_norm;
+			covariance_out -= (1.0 - covariance_epsilon_) * normal * normal.transpose();
+			return;
+		}
+	}
+
+	int number_of_neighbors = search_method.nearestKSearch(point, number_of_neighbors_for_covariance_estimation_, neighbors_indices, neighbors_squared_distances);
+	if (number_of_neighbors < 3) { return; }
+
+	Eigen::Vector3d neighbors_sum = Eigen::Vector3d::Zero();
+	Eigen::Matrix3d neighbors_outer_products_sum = Eigen::Matrix3d::Zero();
+	for (int i = 0; i < number_of_neighbors; ++i) {
+		const PointT& neighbor = pointcloud[neighbors_indices[i]];
+		Eigen::Vector3d neighbor_coordinates(neighbor.x, neighbor.y, neighbor.z);
+		neighbors_sum += neighbor_coordinates;
+		neighbors_outer_products_sum += neighbor_coordinates * neighbor_coordinates.transpose();
+	}
+
+	const Eigen::Vector3d neighbors_mean = neighbors_sum / (double)number_of_neighbors;
+	Eigen::Matrix3d neighbors_covariance = neighbors_outer_products_sum / (double)number_of_neighbors - neighbors_mean * neighbors_mean.transpose();
+	Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen_solver(neighbors_covariance);
+	if (eigen_solver.info() != Eigen::Success) { return; }
+
+	// the eigenvalues are sorted in increasing order (the first eigenvector is the surface normal)
+	const Eigen::Vector3d regularized_eigenvalues(covariance_epsilon_, 1.0, 1.0);
+	const Eigen::Matrix3d& eigenvectors = eigen_solver.eigenvectors();
+	covariance_out = eigenvectors * regularized_eigenvalues.asDiagonal() * eigenvectors.transpose();
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,65 @@
+/**\file voxel_gaussian_map.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/voxel_gaussian_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT>
+void VoxelGaussianMap<PointT>::initializeVoxel(VoxelNormalDistribution& voxel) const {
+	voxel.points_sum.setZero();
+	voxel.points_outer_products_sum.setZero();
+	voxel.number_of_points = 0;
+	voxel.mean.setZero();
+	voxel.inverse_covariance.setZero();
+	voxel.valid = false;
+}
+
+
+template<typename PointT>
+void VoxelGaussianMap<PointT>::addPointToVoxel(const PointT& point, size_t /*new_point_index*/, VoxelNormalDistribution& voxel) const {
+	Eigen::Vector3d point_coordinates(point.x, point.y, point.z);
+	voxel.points_sum += point_coordinates;
+	voxel.points_outer_products_sum += point_coordinates * point_coordinates.transpose();
+	++voxel.number_of_points;
+}
+
+
+template<typename PointT>
+void VoxelGaussianMap<PointT>::updateVoxel(VoxelNormalDistribution& voxel) const {
+	voxel.valid = false;
+	if (voxel.number_of_points < std::max(VoxelHashMap<PointT, VoxelNormalDistribution>::minimum_number_of_points_per_voxel_, 3)) { return; }
+
+	const double number_of_points = (double)voxel.number_of_points;
+	voxel.mean = voxel.points_sum / number_of_points;
+	Eigen::Matrix3d covariance = (voxel.points_outer_products_sum - voxel.points_sum * voxel.mean.transpose()) / (number_of_points - 1.0);
+
+	// inflation of the smallest eigenvalues for avoiding singular covariances (same approach as the pcl ndt)
+	Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen_solver(covariance);
+	Eigen::Vector3d eigenvalues = eigen_solver.eigenvalues();
+	if (eigenvalues(2) <= 0.0) { return; }
+	const double minimum_eigenvalue = minimum_covariance_eigenvalue_ratio_ * eigenvalues(2);
+	for (int i = 0; i < 2; ++i) {
+		eigenvalues(i) = std::max(eigenvalues(i), minimum_eigenvalue);
+	}
+
+	const Eigen::Matrix3d& eigenvectors = eigen_solver.eigenvectors();
+	voxel.inverse_covariance = eigenvectors * eigenvalues.cwiseInverse().asDiagonal() * eigenvectors.transpose();
+	voxel.valid = voxel.inverse_covariance.allFinite();
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
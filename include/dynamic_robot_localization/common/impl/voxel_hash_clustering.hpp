@@ -0,0 +1,206 @@
+/**\file voxel_hash_clustering.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/voxel_hash_clustering.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelHashClustering-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT>
+void VoxelHashClustering<PointT>::extract(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices, std::vector<pcl::PointIndices>& cluster_indices) {
+	cluster_indices.clear();
+	size_t number_of_points = indices ? indices->size() : pointcloud.size();
+	if (number_of_points == 0 || cluster_tolerance_ <= 0.0) { return; }
+
+	if (union_find_parents_capacity_ < number_of_points) {
+		union_find_parents_.reset(new std::atomic<int>[number_of_points]);
+		union_find_parents_capacity_ = number_of_points;
+	}
+
+	buildVoxelHashGrid(pointcloud, indices);
+
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)number_of_points; ++i) {
+		union_find_parents_[i].store(i, std::memory_order_relaxed);
+	}
+
+	connectNeighbors(pointcloud, indices);
+
+	std::vector<pcl::PointIndices> clusters;
+	roots_cluster_index_.assign(number_of_points, -1);
+	for (size_t i = 0; i < number_of_points; ++i) {
+		if (points_voxel_index_[i] == EMPTY_SLOT) { continue; }
+		int root = findUnionFindRoot((int)i);
+		if (roots_cluster_index_[root] < 0) {
+			roots_cluster_index_[root] = (int)clusters.size();
+			clusters.push_back(pcl::PointIndices());
+			clusters.back().header = pointcloud.header;
+		}
+		clusters[roots_cluster_index_[root]].indices.push_back(indices ? (*indices)[i] : (pcl::index_t)i);
+	}
+
+	for (size_t i = 0; i < clusters.size(); ++i) {
+		if (clusters[i].indices.size() >= (size_t)min_cluster_size_ && clusters[i].indices.size() <= (size_t)max_cluster_size_) {
+			cluster_indices.push_back(pcl::PointIndices());
+			cluster_indices.back().header = clusters[i].header;
+			cluster_indices.back().indices.swap(clusters[i].indices);
+		}
+	}
+
+	// same order as pcl::EuclideanClusterExtraction (largest clusters first)
+	std::stable_sort(cluster_indices.begin(), cluster_indices.end(), [](const pcl::PointIndices& a, const pcl::PointIndices& b) { return a.indices.size() > b.indices.size(); });
+}
+
+
+template<typename PointT>
+void VoxelHashClustering<PointT>::buildVoxelHashGrid(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices) {
+	size_t number_of_points = indices ? indices->size() : pointcloud.size();
+	points_voxel_coordinates_.resize(number_of_points);
+	points_voxel_index_.resize(number_of_points);
+	double inverse_cluster_tolerance = 1.0 / cluster_tolerance_;
+
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)number_of_points; ++i) {
+		const PointT& point = pointcloud[indices ? (*indices)[i] : i];
+		if (pcl::isFinite(point)) {
+			points_voxel_coordinates_[i].x = (std::int64_t)std::floor(point.x * inverse_cluster_tolerance);
+			points_voxel_coordinates_[i].y = (std::int64_t)std::floor(point.y * inverse_cluster_tolerance);
+			points_voxel_coordinates_[i].z = (std::int64_t)std::floor(point.z * inverse_cluster_tolerance);
+			points_voxel_index_[i] = 0;
+		} else {
+			points_voxel_index_[i] = EMPTY_SLOT;
+		}
+	}
+
+	size_t hash_table_size = 1024;
+	while (hash_table_size < number_of_points * 2) { hash_table_size *= 2; }
+	HashTableSlot empty_slot = { { 0, 0, 0 }, EMPTY_SLOT };
+	hash_table_.resize(hash_table_size);
+	std::fill(hash_table_.begin(), hash_table_.end(), empty_slot);
+
+	size_t slot_mask = hash_table_size - 1;
+	std::uint32_t number_of_voxels = 0;
+	for (size_t i = 0; i < number_of_points; ++i) {
+		if (points_voxel_index_[i] == EMPTY_SLOT) { continue; }
+		size_t slot_index = (size_t)computeVoxelCoordinatesHash(points_voxel_coordinates_[i]) & slot_mask;
+		while (hash_table_[slot_index].voxel_index != EMPTY_SLOT && !(hash_table_[slot_index].voxel_coordinates == points_voxel_coordinates_[i])) {
+			slot_index = (slot_index + 1) & slot_mask;
+		}
+		if (hash_table_[slot_index].voxel_index == EMPTY_SLOT) {
+			hash_table_[slot_index].voxel_coordinates = points_voxel_coordinates_[i];
+			hash_table_[slot_index].voxel_index = number_of_voxels++;
+		}
+		points_voxel_index_[i] = hash_table_[slot_index].voxel_index;
+	}
+
+	// points of each voxel stored contiguously (counting sort)
+	voxels_points_offsets_.assign(number_of_voxels + 1, 0);
+	for (size_t i = 0; i < number_of_points; ++i) {
+		if (points_voxel_index_[i] != EMPTY_SLOT) { ++voxels_points_offsets_[points_voxel_index_[i] + 1]; }
+	}
+	for (size_t i = 1; i < voxels_points_offsets_.size(); ++i) {
+		voxels_points_offsets_[i] += voxels_points_offsets_[i - 1];
+	}
+	voxels_points_.resize(voxels_points_offsets_.back());
+	std::vector<std::uint32_t> voxels_insert_position(voxels_points_offsets_.begin(), voxels_points_offsets_.end() - 1);
+	for (size_t i = 0; i < number_of_points; ++i) {
+		if (points_voxel_index_[i] != EMPTY_SLOT) { voxels_points_[voxels_insert_position[points_voxel_index_[i]]++] = (std::uint32_t)i; }
+	}
+}
+
+
+template<typename PointT>
+void VoxelHashClustering<PointT>::connectNeighbors(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices) {
+	size_t number_of_points = indices ? indices->size() : pointcloud.size();
+	float cluster_tolerance_squared = (float)(cluster_tolerance_ * cluster_tolerance_);
+
+	#pragma omp parallel for schedule(dynamic, 256) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)number_of_points; ++i) {
+		if (points_voxel_index_[i] == EMPTY_SLOT) { continue; }
+		const PointT& point = pointcloud[indices ? (*indices)[i] : i];
+		const VoxelCoordinates& point_voxel_coordinates = points_voxel_coordinates_[i];
+
+		for (std::int64_t dx = -1; dx <= 1; ++dx) {
+			for (std::int64_t dy = -1; dy <= 1; ++dy) {
+				for (std::int64_t dz = -1; dz <= 1; ++dz) {
+					VoxelCoordinates neighbor_voxel_coordinates = { point_voxel_coordinates.x + dx, point_voxel_coordinates.y + dy, point_voxel_coordinates.z + dz };
+					std::uint32_t neighbor_voxel_index = findVoxel(neighbor_voxel_coordinates);
+					if (neighbor_voxel_index == EMPTY_SLOT) { continue; }
+
+					for (std::uint32_t k = voxels_points_offsets_[neighbor_voxel_index]; k < voxels_points_offsets_[neighbor_voxel_index + 1]; ++k) {
+						int j = (int)voxels_points_[k];
+						if (j <= i || findUnionFindRoot(i) == findUnionFindRoot(j)) { continue; } // each pair is tested once
+
+						const PointT& neighbor_point = pointcloud[indices ? (*indices)[j] : j];
+						float dx_points = point.x - neighbor_point.x;
+						float dy_points = point.y - neighbor_point.y;
+						float dz_points = point.z - neighbor_point.z;
+						if (dx_points * dx_points + dy_points * dy_points + dz_points * dz_points > cluster_tolerance_squared) { continue; }
+						if (point_pair_test_ && !point_pair_test_(point, neighbor_point)) { continue; }
+
+						mergeUnionFindSets(i, j);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+template<typename PointT>
+std::uint32_t VoxelHashClustering<PointT>::findVoxel(const VoxelCoordinates& voxel_coordinates) const {
+	size_t slot_mask = hash_table_.size() - 1;
+	size_t slot_index = (size_t)computeVoxelCoordinatesHash(voxel_coordinates) & slot_mask;
+	while (hash_table_[slot_index].voxel_index != EMPTY_SLOT) {
+		if (hash_table_[slot_index].voxel_coordinates == voxel_coordinates) { return hash_table_[slot_index].voxel_index; }
+		slot_index = (slot_index + 1) & slot_mask;
+	}
+	return EMPTY_SLOT;
+}
+
+
+template<typename PointT>
+int VoxelHashClustering<PointT>::findUnionFindRoot(int element) {
+	while (true) {
+		int parent = union_find_parents_[element].load(std::memory_order_relaxed);
+		if (parent == element) { return element; }
+		int grandparent = union_find_parents_[parent].load(std::memory_order_relaxed);
+		if (parent != grandparent) { union_find_parents_[element].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed); } // path halving
+		element = grandparent;
+	}
+}
+
+
+template<typename PointT>
+void VoxelHashClustering<PointT>::mergeUnionFindSets(int first_element, int second_element) {
+	while (true) {
+		int first_root = findUnionFindRoot(first_element);
+		int second_root = findUnionFindRoot(second_element);
+		if (first_root == second_root) { return; }
+		if (first_root < second_root) { std::swap(first_root, second_root); }
+
+		// the root with the higher index is linked to the lower one, which can only fail if another thread changed it in the meantime
+		int expected_parent = first_root;
+		if (union_find_parents_[first_root].compare_exchange_strong(expected_parent, second_root, std::memory_order_acq_rel)) { return; }
+	}
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelHashClustering-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,162 @@
+/**\file voxel_hash_map.hpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/common/voxel_hash_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelHashMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+template<typename PointT, typename VoxelT>
+void VoxelHashMap<PointT, VoxelT>::updateReferenceCloud(const typename pcl::PointCloud<PointT>::ConstPtr& reference_cloud) {
+	if (!reference_cloud) { clear(); return; }
+
+	// the previously integrated points must be unchanged at the start of the reference cloud (edited or reorganized clouds, such as filtered ones, force a rebuild)
+	bool appended_points = !voxels_.empty() && number_of_integrated_points_ > 0 && reference_cloud->size() >= number_of_integrated_points_ &&
+			computePointsChecksum(*reference_cloud, 0, number_of_integrated_points_) == integrated_points_checksum_;
+
+	if (appended_points) {
+		if (reference_cloud->size() > number_of_integrated_points_) {
+			size_t first_new_point_index = number_of_integrated_points_;
+			addPoints(reference_cloud, first_new_point_index);
+			integrated_points_checksum_ += computePointsChecksum(*reference_cloud, first_new_point_index, reference_cloud->size());
+			ROS_DEBUG_STREAM("Integrated " << (reference_cloud->size() - first_new_point_index) << " new points into the voxel map (" << voxels_.size() << " voxels)");
+		}
+	} else {
+		clear();
+		addPoints(reference_cloud);
+		integrated_points_checksum_ = computePointsChecksum(*reference_cloud, 0, reference_cloud->size());
+		ROS_DEBUG_STREAM("Built voxel map with " << voxels_.size() << " voxels of " << resolution_ << " m from a reference cloud with " << reference_cloud->size() << " points");
+	}
+}
+
+
+template<typename PointT, typename VoxelT>
+void VoxelHashMap<PointT, VoxelT>::addPoints(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, size_t first_point_index) {
+	if (first_point_index >= pointcloud->size()) { return; }
+	const int number_of_new_points = (int)(pointcloud->size() - first_point_index);
+
+	prepareNewPoints(pointcloud, first_point_index);
+
+	std::vector<VoxelCoordinates> points_voxel_coordinates(number_of_new_points);
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < number_of_new_points; ++i) {
+		const PointT& point = (*pointcloud)[first_point_index + i];
+		if (pcl::isFinite(point)) {
+			points_voxel_coordinates[i] = computeVoxelCoordinates(point.x, point.y, point.z);
+		}
+	}
+
+	// the hash map insertions are serial, but only the voxels that received points need their statistics updated
+	std::vector<size_t> updated_voxels;
+	std::vector<bool> voxel_updated(voxels_.size(), false);
+	for (int i = 0; i < number_of_new_points; ++i) {
+		const PointT& point = (*pointcloud)[first_point_index + i];
+		if (!pcl::isFinite(point)) { continue; }
+
+		size_t voxel_index;
+		typename std::unordered_map<VoxelCoordinates, size_t, VoxelCoordinatesHash>::iterator voxel_it = voxels_indices_.find(points_voxel_coordinates[i]);
+		if (voxel_it == voxels_indices_.end()) {
+			voxel_index = voxels_.size();
+			voxels_indices_[points_voxel_coordinates[i]] = voxel_index;
+			VoxelT voxel;
+			initializeVoxel(voxel);
+			voxels_.push_back(voxel);
+			voxel_updated.push_back(false);
+		} else {
+			voxel_index = voxel_it->second;
+		}
+
+		addPointToVoxel(point, (size_t)i, voxels_[voxel_index]);
+
+		if (!voxel_updated[voxel_index]) {
+			voxel_updated[voxel_index] = true;
+			updated_voxels.push_back(voxel_index);
+		}
+	}
+
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = 0; i < (int)updated_voxels.size(); ++i) {
+		updateVoxel(voxels_[updated_voxels[i]]);
+	}
+
+	number_of_integrated_points_ = pointcloud->size();
+}
+
+
+template<typename PointT, typename VoxelT>
+void VoxelHashMap<PointT, VoxelT>::clear() {
+	voxels_.clear();
+	voxels_indices_.clear();
+	number_of_integrated_points_ = 0;
+	integrated_points_checksum_ = 0;
+}
+
+
+template<typename PointT, typename VoxelT>
+int VoxelHashMap<PointT, VoxelT>::findNeighborVoxels(const Eigen::Vector3d& point, NeighborSearchMethod neighbor_search_method, const VoxelT* neighbors_out[]) const {
+	static const int direct7_offsets[7][3] = { {0, 0, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1} };
+
+	int number_of_neighbors = 0;
+	VoxelCoordinates point_voxel = computeVoxelCoordinates(point.x(), point.y(), point.z());
+	int number_of_offsets = (neighbor_search_method == DIRECT1 ? 1 : (neighbor_search_method == DIRECT7 ? 7 : 27));
+	for (int i = 0; i < number_of_offsets; ++i) {
+		VoxelCoordinates neighbor_voxel = point_voxel;
+		if (neighbor_search_method == DIRECT27) {
+			neighbor_voxel.x += i % 3 - 1;
+			neighbor_voxel.y += (i / 3) % 3 - 1;
+			neighbor_voxel.z += i / 9 - 1;
+		} else {
+			neighbor_voxel.x += direct7_offsets[i][0];
+			neighbor_voxel.y += direct7_offsets[i][1];
+			neighbor_voxel.z += direct7_offsets[i][2];
+		}
+
+		typename std::unordered_map<VoxelCoordinates, size_t, VoxelCoordinatesHash>::const_iterator voxel_it = voxels_indices_.find(neighbor_voxel);
+		if (voxel_it != voxels_indices_.end() && voxels_[voxel_it->second].valid) {
+			neighbors_out[number_of_neighbors++] = &voxels_[voxel_it->second];
+		}
+	}
+
+	return number_of_neighbors;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelHashMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+template<typename PointT, typename VoxelT>
+std::uint64_t VoxelHashMap<PointT, VoxelT>::computePointsChecksum(const pcl::PointCloud<PointT>& pointcloud, size_t first_point_index, size_t last_point_index) const {
+	std::uint64_t checksum = 0;
+	#pragma omp parallel for schedule(static) reduction(+:checksum) num_threads(number_of_threads_ > 0 ? number_of_threads_ : omp_get_max_threads())
+	for (int i = (int)first_point_index; i < (int)last_point_index; ++i) {
+		const PointT& point = pointcloud[i];
+		std::uint64_t point_hash = mixChecksum((std::uint64_t)i + 0x9E3779B97F4A7C15ULL);
+		if (pcl::isFinite(point)) {
+			const float coordinates[3] = { point.x, point.y, point.z };
+			std::uint32_t coordinates_bits[3];
+			std::memcpy(coordinates_bits, coordinates, sizeof(coordinates));
+			point_hash = mixChecksum(point_hash ^ (((std::uint64_t)coordinates_bits[0] << 32) | coordinates_bits[1]));
+			point_hash = mixChecksum(point_hash ^ coordinates_bits[2]);
+		}
+		checksum += point_hash;
+	}
+	return checksum;
+}
+// =============================================================================   </protected-section>  =======================================================================
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+} /* namespace dynamic_robot_localization */
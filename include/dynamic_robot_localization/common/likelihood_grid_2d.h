@@ -0,0 +1,128 @@
+#pragma once
+
+/**\file likelihood_grid_2d.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROS includes
+#include <ros/ros.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+
+// external libs includes
+#include <Eigen/Core>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/common/configurable_object.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ###########################################################################   likelihood_grid_2d   ##########################################################################
+/**
+ * \brief 2D grid (in the xy plane) with the likelihood of each cell being occupied by a point of a reference cloud (each point is spread with a gaussian).
+ * Besides the full resolution grid (level 0), it can precompute lower resolution levels, in which each cell has the maximum likelihood of the 2^level x 2^level
+ * level 0 cells starting on it (upper bounds of the scan matching scores, used by branch and bound searches).
+ * The likelihoods are quantized to 8 bits for keeping the memory usage of large maps manageable.
+ */
+template <typename PointT>
+class LikelihoodGrid2D : public ConfigurableObject {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< LikelihoodGrid2D<PointT> >;
+		using ConstPtr = std::shared_ptr< const LikelihoodGrid2D<PointT> >;
+		using CellCoordinates = Eigen::Array2i;
+		using ScanCells = std::vector<CellCoordinates, Eigen::aligned_allocator<CellCoordinates> >;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		LikelihoodGrid2D() : cell_resolution_(0.05), likelihood_field_sigma_(0.05), maximum_number_of_cells_(200000000), number_of_threads_(0),
+				origin_x_(0.0f), origin_y_(0.0f), size_x_(0), size_y_(0) {}
+		virtual ~LikelihoodGrid2D() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <LikelihoodGrid2D-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		virtual void setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace = "");
+		/// Builds the full resolution grid from the xy coordinates of the reference cloud (discards the lower resolution levels)
+		bool setupReferenceCloud(const pcl::PointCloud<PointT>& reference_cloud);
+		/// Computes the levels [1, number_of_levels[ from the full resolution grid
+		void computeMultiResolutionLevels(int number_of_levels);
+		void reset() { levels_.clear(); size_x_ = 0; size_y_ = 0; }
+
+		inline CellCoordinates computeCellCoordinates(float x, float y) const {
+			return CellCoordinates((int)std::floor((x - origin_x_) / cell_resolution_), (int)std::floor((y - origin_y_) / cell_resolution_));
+		}
+
+		/// Likelihood in [0, 255] of the cell (0 outside the grid)
+		inline std::uint8_t getCellLikelihood(int x, int y, int level = 0) const {
+			const int padding = (1 << level) - 1;
+			const int padded_x = x + padding;
+			const int padded_y = y + padding;
+			const int padded_size_x = size_x_ + padding;
+			if (padded_x < 0 || padded_y < 0 || padded_x >= padded_size_x || padded_y >= size_y_ + padding) { return 0; }
+			return levels_[level][(size_t)padded_y * (size_t)padded_size_x + (size_t)padded_x];
+		}
+
+		/// Mean likelihood in [0, 1] of the scan cells shifted by the given offset (in cells)
+		float computeScore(const ScanCells& scan_cells, int offset_x, int offset_y, int level = 0) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </LikelihoodGrid2D-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		bool isValid() const { return !levels_.empty(); }
+		double getCellResolution() const { return cell_resolution_; }
+		int getSizeX() const { return size_x_; }
+		int getSizeY() const { return size_y_; }
+		float getOriginX() const { return origin_x_; }
+		float getOriginY() const { return origin_y_; }
+		int getNumberOfLevels() const { return (int)levels_.size(); }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		void setCellResolution(double cell_resolution) { cell_resolution_ = cell_resolution; }
+		/// <= 0 -> only the cells with reference points have likelihood
+		void setLikelihoodFieldSigma(double likelihood_field_sigma) { likelihood_field_sigma_ = likelihood_field_sigma; }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		double cell_resolution_;
+		double likelihood_field_sigma_;
+		int maximum_number_of_cells_;
+		int number_of_threads_;
+		float origin_x_;
+		float origin_y_;
+		int size_x_;
+		int size_y_;
+		/// levels_[l] has (size_x_ + 2^l - 1) * (size_y_ + 2^l - 1) cells (padded in the lower side, for the offsets in which the 2^l window starts outside the grid)
+		std::vector< std::vector<std::uint8_t> > levels_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/likelihood_grid_2d.hpp>
+#endif
@@ -25,6 +25,8 @@
 
 // external libs includes
 #include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <Eigen/Geometry>
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 namespace dynamic_robot_localization {
@@ -71,6 +73,15 @@ bool sortFunctionForPairSecondValueDescendingOrder(const std::pair<PairFirst, Pa
 void getRollPitchYawFromMatrix(const Eigen::Matrix4f& matrix, double& roll_out, double& pitch_out, double& yaw_out);
 void getRollPitchYawFromMatrixUsigTF2(const Eigen::Matrix4f& matrix, double& roll_out, double& pitch_out, double& yaw_out);
 
+/**
+ * Solves the Gauss-Newton system hessian * delta = -gradient of a pose update [translation, rotation vector] and applies it on the left of the transformation.
+ * The norm of the update is clamped to maximum_step_length (if > 0) and estimate_2d_pose only updates x, y and yaw.
+ * converged_out is true when the update is below the pcl::Registration epsilons (transformation_rotation_epsilon > 0 is compared with the cosine of the rotation angle).
+ * Returns false (without changing the transformation) if the Hessian is singular.
+ */
+bool applyGaussNewtonPoseUpdate(const Eigen::Matrix<double, 6, 6>& hessian, const Eigen::Matrix<double, 6, 1>& gradient, double maximum_step_length, bool estimate_2d_pose,
+		double transformation_epsilon, double transformation_rotation_epsilon, Eigen::Matrix4d& transformation, bool& converged_out);
+
 
 } /* namespace math_utils */
 } /* namespace dynamic_robot_localization */
@@ -9,24 +9,49 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <vector>
 
 // ROS includes
 #include <ros/ros.h>
 #include <sensor_msgs/PointCloud2.h>
+#include <sensor_msgs/PointField.h>
 
-// PCL includes// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/PCLPointField.h>
+#include <pcl/common/io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
 namespace dynamic_robot_localization {
 // ##########################################################################   point_cloud2_builder   #########################################################################
 /**
- * \brief Description...
+ * \brief Builds sensor_msgs::PointCloud2 messages with an arbitrary typed fields layout (xyz followed by the fields added with addField).
+ * Points can be appended one at a time, in bulk (with a single resize of the msg data) or copied from pcl clouds.
+ * When the fields layout was created from the point type of a pcl cloud, its points are copied with a single memcpy.
  */
 class PointCloud2Builder {
 	// ========================================================================   <public-section>   ===========================================================================
 	public:
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		struct FieldCopy {
+			std::uint32_t source_offset;
+			std::uint32_t destination_offset;
+			std::uint8_t source_datatype;
+			std::uint8_t destination_datatype;
+			std::uint32_t count;
+		};
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -35,12 +60,47 @@ class PointCloud2Builder {
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloud2Builder-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Creates a new msg with only the xyz FLOAT32 fields (more fields can be appended with addField before adding points)
 		void createNewCloud(std::string frame_id, size_t number_reserved_points = 32);
+		/// Creates a new msg with the fields layout of PointT (including its padding), allowing addPoints to copy pcl clouds of PointT with a single memcpy
+		template <typename PointT>
+		void createNewCloudWithPointTypeLayout(std::string frame_id, size_t number_reserved_points = 32);
+
+		/// Appends a field to the end of the point layout (only allowed while the msg has no points)
+		/// @return The index of the field or -1 if the msg already has points
+		int addField(const std::string& name, std::uint8_t datatype, std::uint32_t count = 1);
+		void addNormalFields();
+		void addRGBField();
+		void addIntensityField();
+		void addCurvatureField();
+		int getFieldIndex(const std::string& name) const;
+
 		void addNewPoint(float x, float y, float z);
+		/// Resizes the msg data once for number_of_points new points (zero initialized) and returns the address of the first new point
+		std::uint8_t* addPoints(size_t number_of_points);
+		/// Appends the points of pointcloud, converting the fields with the same name (fields missing in PointT are zero initialized)
+		template <typename PointT>
+		void addPoints(const pcl::PointCloud<PointT>& pointcloud, int number_of_threads = 0);
+		template <typename PointT>
+		bool isFieldsLayoutEqualToPointType() const;
+
+		/// Writes value (converted to the field datatype) into the element of the field of the point starting at point_data
+		template <typename T>
+		void setFieldValue(std::uint8_t* point_data, size_t field_index, T value, size_t element = 0) const {
+			const sensor_msgs::PointField& field = pointcloud_msg_->fields[field_index];
+			writeValue(point_data + field.offset + element * getDatatypeSize(field.datatype), field.datatype, (double)value);
+		}
+
+		std::uint8_t* getPointData(size_t point_index) { return &pointcloud_msg_->data[point_index * pointcloud_msg_->point_step]; }
+
+		static size_t getDatatypeSize(std::uint8_t datatype);
+		static double readValue(const std::uint8_t* data, std::uint8_t datatype);
+		static void writeValue(std::uint8_t* data, std::uint8_t datatype, double value);
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloud2Builder-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		sensor_msgs::PointCloud2Ptr getPointcloudMsg();
+		size_t getNumberOfPoints() const { return number_points_in_pointcloud_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -49,10 +109,18 @@ class PointCloud2Builder {
 
 	// ========================================================================   <protected-section>   ========================================================================
 	protected:
+		void resetPointcloudMsg(const std::string& frame_id);
+
 	private:
 		sensor_msgs::PointCloud2Ptr pointcloud_msg_;
 		size_t number_points_in_pointcloud_;
+		size_t number_reserved_points_;
 	// ========================================================================   </protected-section>  ========================================================================
 };
 
 } /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/pointcloud2_builder.hpp>
+#endif
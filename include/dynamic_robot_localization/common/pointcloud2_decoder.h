@@ -0,0 +1,136 @@
+#pragma once
+
+/**\file pointcloud2_decoder.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ROS includes
+#include <sensor_msgs/PointCloud2.h>
+#include <sensor_msgs/PointField.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/PCLPointField.h>
+#include <pcl/common/io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+// project includes
+#include <dynamic_robot_localization/common/pointcloud2_builder.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ##########################################################################   PointCloud2Decoder   ###########################################################################
+/**
+ * \brief Converts sensor_msgs::PointCloud2 messages to pcl::PointCloud<PointT> in a single pass, without the intermediate pcl::PCLPointCloud2 copy of pcl::fromROSMsg.
+ * The mapping between the message fields and the point fields is computed once per message layout and cached.
+ * Points with NaN coordinates and points outside the crop box / range limits are discarded while decoding.
+ * The output cloud is reused between calls when nobody else is holding it.
+ */
+template <typename PointT>
+class PointCloud2Decoder {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< PointCloud2Decoder<PointT> >;
+		using ConstPtr = std::shared_ptr< const PointCloud2Decoder<PointT> >;
+
+		struct FieldCopy {
+			std::uint32_t source_offset;
+			std::uint32_t destination_offset;
+			std::uint8_t source_datatype;
+			std::uint8_t destination_datatype;
+			std::uint32_t count;
+		};
+
+		struct FieldsLayout {
+			std::uint32_t x_offset, y_offset, z_offset;
+			std::uint8_t xyz_datatype;
+			std::vector<FieldCopy> fields_copies;
+		};
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		PointCloud2Decoder() :
+			box_min_x_(-std::numeric_limits<float>::max()), box_min_y_(-std::numeric_limits<float>::max()), box_min_z_(-std::numeric_limits<float>::max()),
+			box_max_x_(std::numeric_limits<float>::max()), box_max_y_(std::numeric_limits<float>::max()), box_max_z_(std::numeric_limits<float>::max()),
+			minimum_range_(0.0f), maximum_range_(0.0f), maximum_number_of_cached_layouts_(16),
+			number_of_discarded_nans_(0), number_of_discarded_points_outside_limits_(0), last_fields_layout_(nullptr) {}
+		virtual ~PointCloud2Decoder() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloud2Decoder-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/**
+		 * Decodes pointcloud_msg into pointcloud (which will point to the reusable output cloud)
+		 * @return false if the message layout is not supported (big endian data or missing xyz fields), in which case pcl::fromROSMsg should be used
+		 */
+		bool decode(const sensor_msgs::PointCloud2& pointcloud_msg, typename pcl::PointCloud<PointT>::Ptr& pointcloud);
+		const FieldsLayout* retrieveFieldsLayout(const sensor_msgs::PointCloud2& pointcloud_msg);
+		bool computeFieldsLayout(const sensor_msgs::PointCloud2& pointcloud_msg, FieldsLayout& fields_layout);
+		static std::string computeFieldsLayoutKey(const sensor_msgs::PointCloud2& pointcloud_msg);
+		static bool fieldNamesMatch(const std::string& source_field_name, const std::string& destination_field_name);
+		static size_t getDatatypeSize(std::uint8_t datatype);
+		static double readValue(const std::uint8_t* data, std::uint8_t datatype);
+		static void writeValue(std::uint8_t* data, std::uint8_t datatype, double value);
+		inline bool isPointInsideLimits(float x, float y, float z) const;
+		bool hasLimits() const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloud2Decoder-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		size_t getNumberOfDiscardedNaNs() const { return number_of_discarded_nans_; }
+		size_t getNumberOfDiscardedPointsOutsideLimits() const { return number_of_discarded_points_outside_limits_; }
+		/// Raw values of the time field of the decoded points (empty if the time field name is not set or the message does not have it)
+		std::vector<double>& getPointsTimes() { return points_times_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		void setBoxMin(float x, float y, float z) { box_min_x_ = x; box_min_y_ = y; box_min_z_ = z; }
+		void setBoxMax(float x, float y, float z) { box_max_x_ = x; box_max_y_ = y; box_max_z_ = z; }
+		/// Range limits in relation to the origin of the message frame (disabled when <= 0)
+		void setMinimumRange(float minimum_range) { minimum_range_ = minimum_range; }
+		void setMaximumRange(float maximum_range) { maximum_range_ = maximum_range; }
+		/// Name of the per point time field to extract while decoding (empty -> disabled)
+		void setTimeFieldName(const std::string& time_field_name) { time_field_name_ = time_field_name; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		float box_min_x_, box_min_y_, box_min_z_;
+		float box_max_x_, box_max_y_, box_max_z_;
+		float minimum_range_;
+		float maximum_range_;
+		size_t maximum_number_of_cached_layouts_;
+		size_t number_of_discarded_nans_;
+		size_t number_of_discarded_points_outside_limits_;
+		std::map<std::string, FieldsLayout> fields_layouts_;
+		std::string last_fields_layout_key_;
+		const FieldsLayout* last_fields_layout_;
+		typename pcl::PointCloud<PointT>::Ptr reusable_pointcloud_;
+		std::string time_field_name_;
+		std::vector<double> points_times_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/pointcloud2_decoder.hpp>
+#endif
@@ -9,8 +9,17 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // ROS includes
 #include <ros/console.h>
@@ -20,6 +29,7 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 #include <pcl/point_representation.h>
+#include <pcl/common/io.h>
 #include <pcl/common/transforms.h>
 #include <pcl/search/kdtree.h>
 #include <pcl/PCLPointCloud2.h>
@@ -33,6 +43,10 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
 // project includes
 #include <dynamic_robot_localization/common/math_utils.h>
 #include <dynamic_robot_localization/common/pointcloud_utils.h>
@@ -47,14 +61,116 @@ namespace pointcloud_conversions {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 using OccupancyGridValues = std::vector<signed char>;
 using OccupancyGridValuesPtr = std::shared_ptr< OccupancyGridValues >;
+
+/**
+ * Header of the native binary point cloud files (.drlc).
+ * The header is followed by the raw memory of pcl::PointCloud<PointT>::points, stored in little endian.
+ * Files can only be loaded into the same point type (and memory layout) with which they were saved.
+ */
+struct BinaryPointCloudFileHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t endianness_marker;
+	std::uint32_t header_size;
+	std::uint32_t point_size;
+	std::uint64_t point_type_signature;
+	std::uint64_t number_of_points;
+	std::uint32_t width;
+	std::uint32_t height;
+	std::uint32_t is_dense;
+	float sensor_origin[4];
+	float sensor_orientation[4];
+};
+
+extern const char BINARY_POINTCLOUD_FILE_MAGIC[8];
+static const std::uint32_t BINARY_POINTCLOUD_FILE_VERSION = 1;
+static const std::uint32_t BINARY_POINTCLOUD_FILE_ENDIANNESS_MARKER = 0x01020304;
+extern const std::string BINARY_POINTCLOUD_FILE_EXTENSION;
+
+
+/**
+ * Header of the keypoint descriptors cache files (.drld).
+ * The header is followed by the raw memory of pcl::PointCloud<FeatureT>::points, stored in little endian.
+ * The descriptors are only loaded if they were computed with the same descriptor type, keypoints, surface size and descriptor configuration.
+ */
+struct DescriptorsCacheSignature {
+	std::uint64_t number_of_keypoints;
+	std::uint64_t keypoints_signature;
+	std::uint64_t number_of_surface_points;
+	std::uint64_t configuration_signature;
+};
+
+struct DescriptorsCacheFileHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t endianness_marker;
+	std::uint32_t header_size;
+	std::uint32_t descriptor_size;
+	std::uint64_t descriptor_type_signature;
+	std::uint64_t number_of_descriptors;
+	DescriptorsCacheSignature signature;
+	std::uint32_t is_dense;
+	std::uint32_t reserved;
+};
+
+extern const char DESCRIPTORS_CACHE_FILE_MAGIC[8];
+static const std::uint32_t DESCRIPTORS_CACHE_FILE_VERSION = 1;
+extern const std::string DESCRIPTORS_CACHE_FILE_EXTENSION;
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+/**
+ * Converts the cells with values above threshold_for_map_cell_as_obstacle to points (in two parallel passes, that count and then fill the selected cells of each row)
+ * @param extract_only_boundary_cells If true, only occupied cells with a free 4 neighbor are converted
+ * @param compute_normals_from_occupancy_gradient If true, the normals point to the free 8 neighbors of each cell (NaN for cells without free neighbors)
+ */
 template <typename PointT>
-bool fromROSMsg(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<PointT>& pointcloud, OccupancyGridValuesPtr occupancy_grid_values = OccupancyGridValuesPtr(), int threshold_for_map_cell_as_obstacle = 95);
+bool fromROSMsg(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<PointT>& pointcloud, OccupancyGridValuesPtr occupancy_grid_values = OccupancyGridValuesPtr(), int threshold_for_map_cell_as_obstacle = 95,
+		bool extract_only_boundary_cells = false, bool compute_normals_from_occupancy_gradient = false, int number_of_threads = 0);
 
 template <typename PointT>
 size_t flipPointCloudNormalsUsingOccpancyGrid(const nav_msgs::OccupancyGrid& occupancy_grid, pcl::PointCloud<PointT>& pointcloud, int search_k, float search_radius, bool show_occupancy_grid_pointcloud = false);
 
+/**
+ * Computes the index of the nearest free cell (value 0) of each occupancy grid cell (-1 if the map has no free cells) using a linear time euclidean distance transform
+ * (one parallel pass over the columns followed by one parallel pass over the rows with the lower envelope of parabolas)
+ */
+void computeOccupancyGridNearestFreeCells(const nav_msgs::OccupancyGrid& occupancy_grid, std::vector<int>& nearest_free_cells, int number_of_threads = 0);
+
+/**
+ * Flips the normals that are not pointing to the nearest free cell of the occupancy grid cell in which each point is located.
+ * Points inside free cells use the direction from the nearest occupied neighbor cell to its nearest free cell, and when no reliable direction is found (shorter than half a cell),
+ * the free cells within search_radius (at least one cell) vote on which side of the line perpendicular to the normal the free space is.
+ */
+template <typename PointT>
+size_t flipPointCloudNormalsUsingOccpancyGridNearestFreeCells(const nav_msgs::OccupancyGrid& occupancy_grid, const std::vector<int>& nearest_free_cells, pcl::PointCloud<PointT>& pointcloud, float search_radius = 0.0f, int number_of_threads = 0);
+
+/// FNV-1a hash of a block of memory (can be chained by giving the previous hash)
+std::uint64_t computeHash(const void* data, size_t number_of_bytes, std::uint64_t hash = 14695981039346656037ull);
+
+/// Signature of the fields (names, offsets, types and counts) and size of PointT, used for validating binary point cloud files
+template <typename PointT>
+std::uint64_t computePointTypeSignature();
+
+template <typename PointT>
+bool fromBinaryFile(pcl::PointCloud<PointT>& pointcloud, const std::string& filepath);
+
+/// Hash of the positions and normals of the points, used for checking if cached data (such as keypoint descriptors) was computed from the same point cloud
+template <typename PointT>
+std::uint64_t computePointCloudSignature(const pcl::PointCloud<PointT>& pointcloud);
+
+/**
+ * Loads keypoint descriptors from a memory mapped cache file
+ * @return false if the file does not exist or if it was saved with a different descriptor type or signature (in which case the descriptors must be recomputed)
+ */
+template <typename FeatureT>
+bool fromDescriptorsCacheFile(pcl::PointCloud<FeatureT>& descriptors, const std::string& filepath, const DescriptorsCacheSignature& expected_signature);
+
+template <typename FeatureT>
+bool toDescriptorsCacheFile(const std::string& filepath, const pcl::PointCloud<FeatureT>& descriptors, const DescriptorsCacheSignature& signature);
+
+template <typename PointT>
+bool toBinaryFile(const std::string& filepath, const pcl::PointCloud<PointT>& pointcloud);
+
 template <typename PointCloudT>
 bool fromFile(PointCloudT& pointcloud, const std::string& filename, const std::string& folder = std::string(""));
 
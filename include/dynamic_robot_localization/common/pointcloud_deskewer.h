@@ -0,0 +1,119 @@
+#pragma once
+
+/**\file pointcloud_deskewer.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROS includes
+#include <sensor_msgs/PointCloud2.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// project includes
+#include <dynamic_robot_localization/common/pointcloud2_builder.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ###########################################################################   PointCloudDeskewer   ##########################################################################
+/**
+ * \brief Removes the motion distortion of scans whose points were captured at different times (such as the ones from rotating lidars).
+ * Each point is moved from the sensor pose at its capture time to the sensor pose at the reference time (the msg stamp),
+ * using the rigid motion of the sensor sampled at uniformly spaced times over the scan duration (interpolated for each point).
+ */
+template <typename PointT>
+class PointCloudDeskewer {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< PointCloudDeskewer<PointT> >;
+		using ConstPtr = std::shared_ptr< const PointCloudDeskewer<PointT> >;
+
+		/// Transform from the sensor frame at the sample time to the sensor frame at the reference time
+		struct MotionSample {
+			Eigen::Quaternionf rotation;
+			Eigen::Vector3f translation;
+		};
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		PointCloudDeskewer() : time_field_scale_(1.0), time_field_is_relative_to_msg_stamp_(true), number_of_motion_samples_(10), number_of_threads_(0),
+			motion_samples_start_time_(0.0), motion_samples_time_step_(0.0) {}
+		virtual ~PointCloudDeskewer() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloudDeskewer-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Reads the time field of all the points of the msg (in the same order as pcl::fromROSMsg)
+		static bool extractPointsTimes(const sensor_msgs::PointCloud2& pointcloud_msg, const std::string& time_field_name, std::vector<double>& points_times_out);
+
+		/**
+		 * Converts the raw time field values to seconds relative to the msg stamp (in place)
+		 * @return false if there are no finite times
+		 */
+		bool convertPointsTimesToSecondsRelativeToStamp(std::vector<double>& points_times, double msg_stamp_seconds, double& minimum_time_out, double& maximum_time_out) const;
+
+		/// Times (relative to the msg stamp) in which the motion of the sensor must be sampled (uniformly spaced between minimum_time and maximum_time)
+		void computeMotionSamplesTimes(double minimum_time, double maximum_time, std::vector<double>& motion_samples_times_out) const;
+
+		/// Motion samples computed at the times given by computeMotionSamplesTimes
+		void setMotionSamples(const std::vector<double>& motion_samples_times, const std::vector<MotionSample>& motion_samples);
+
+		/// Moves each point to the sensor frame at the reference time (points_times in seconds relative to the msg stamp)
+		bool deskew(pcl::PointCloud<PointT>& pointcloud, const std::vector<double>& points_times) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </PointCloudDeskewer-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		const std::string& getTimeFieldName() const { return time_field_name_; }
+		int getNumberOfMotionSamples() const { return number_of_motion_samples_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		void setTimeFieldName(const std::string& time_field_name) { time_field_name_ = time_field_name; }
+		/// Scale that converts the time field values to seconds (ex: 1e-9 for nanoseconds)
+		void setTimeFieldScale(double time_field_scale) { time_field_scale_ = time_field_scale; }
+		void setTimeFieldIsRelativeToMsgStamp(bool time_field_is_relative_to_msg_stamp) { time_field_is_relative_to_msg_stamp_ = time_field_is_relative_to_msg_stamp; }
+		void setNumberOfMotionSamples(int number_of_motion_samples) { number_of_motion_samples_ = std::max(number_of_motion_samples, 2); }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		std::string time_field_name_;
+		double time_field_scale_;
+		bool time_field_is_relative_to_msg_stamp_;
+		int number_of_motion_samples_;
+		int number_of_threads_;
+		double motion_samples_start_time_;
+		double motion_samples_time_step_;
+		std::vector<MotionSample> motion_samples_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/pointcloud_deskewer.hpp>
+#endif
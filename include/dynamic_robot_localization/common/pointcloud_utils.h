@@ -9,7 +9,11 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 // PCL includes
@@ -18,6 +22,13 @@
 #include <pcl/point_types_conversion.h>
 #include <pcl/PointIndices.h>
 #include <pcl/common/colors.h>
+
+// external libs includes
+#include <Eigen/Core>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 namespace dynamic_robot_localization {
@@ -25,8 +36,48 @@ namespace dynamic_robot_localization {
 
 namespace pointcloud_utils {
 
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_color<PointT>::value>::type setPointColor(PointT& point, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+	point.r = r; point.g = g; point.b = b;
+}
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_color<PointT>::value>::type setPointColor(PointT&, std::uint8_t, std::uint8_t, std::uint8_t) {}
+
+/// @return false if PointT does not have color
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_color<PointT>::value, bool>::type getPointColor(const PointT& point, std::uint8_t& r, std::uint8_t& g, std::uint8_t& b) {
+	r = point.r; g = point.g; b = point.b;
+	return true;
+}
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_color<PointT>::value, bool>::type getPointColor(const PointT&, std::uint8_t&, std::uint8_t&, std::uint8_t&) { return false; }
+
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_normal<PointT>::value>::type setPointNormal(PointT& point, const Eigen::Vector3f& normal) {
+	point.normal_x = normal(0); point.normal_y = normal(1); point.normal_z = normal(2);
+}
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_normal<PointT>::value>::type setPointNormal(PointT&, const Eigen::Vector3f&) {}
+
+/// @return false if PointT does not have normals or if the normal is not finite
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_normal<PointT>::value, bool>::type getPointNormal(const PointT& point, Eigen::Vector3f& normal) {
+	normal = Eigen::Vector3f(point.normal_x, point.normal_y, point.normal_z);
+	return normal.allFinite();
+}
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_normal<PointT>::value, bool>::type getPointNormal(const PointT&, Eigen::Vector3f&) { return false; }
+
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_curvature<PointT>::value>::type setPointCurvature(PointT& point, float curvature) { point.curvature = curvature; }
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_curvature<PointT>::value>::type setPointCurvature(PointT&, float) {}
+
+/// @return false if PointT does not have curvature or if the curvature is not finite
+template <typename PointT> inline typename std::enable_if<pcl::traits::has_curvature<PointT>::value, bool>::type getPointCurvature(const PointT& point, float& curvature) {
+	curvature = point.curvature;
+	return std::isfinite(curvature);
+}
+template <typename PointT> inline typename std::enable_if<!pcl::traits::has_curvature<PointT>::value, bool>::type getPointCurvature(const PointT&, float&) { return false; }
+
+/**
+ * Appends pointclouds to pointcloud_out, resizing it only once and copying the clouds in parallel.
+ * The output is organized only when it receives the points of a single organized cloud, and it is dense only when all the merged clouds are dense.
+ * @param segments_offsets_out If not null, receives the index in pointcloud_out of the first point of each cloud (plus the final size of pointcloud_out at the end)
+ */
 template <typename PointT>
-void concatenatePointClouds(const std::vector< typename pcl::PointCloud<PointT>::Ptr >& pointclouds, typename pcl::PointCloud<PointT>::Ptr& pointcloud_out);
+void concatenatePointClouds(const std::vector< typename pcl::PointCloud<PointT>::Ptr >& pointclouds, typename pcl::PointCloud<PointT>::Ptr& pointcloud_out,
+		std::vector<size_t>* segments_offsets_out = nullptr, int number_of_threads = 0);
 
 template <typename PointT>
 void colorizePointCloudWithCurvature(pcl::PointCloud<PointT>& pointcloud);
@@ -37,6 +88,8 @@ void colorizePointCloudClusters(const pcl::PointCloud<PointT>& pointcloud, const
 template <typename PointT>
 void extractPointCloudClusters(const pcl::PointCloud<PointT>& pointcloud, const std::vector<pcl::PointIndices>& cluster_indices, const std::vector<size_t>& selected_clusters, pcl::PointCloud<PointT>& pointcloud_out);
 
+void extractPointCloudClustersIndices(const std::vector<pcl::PointIndices>& cluster_indices, const std::vector<size_t>& selected_clusters, pcl::Indices& indices_out);
+
 template <typename PointT>
 float distanceSquaredToOrigin(const PointT& point);
 
@@ -0,0 +1,40 @@
+#pragma once
+
+/**\file voxel_coordinates.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cstddef>
+#include <cstdint>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ############################################################################   voxel_coordinates   ###########################################################################
+/// Integer coordinates of a voxel in a sparse grid (64 bit, so there are no limits on the cloud extent / voxel size ratio)
+struct VoxelCoordinates {
+	std::int64_t x, y, z;
+	inline bool operator==(const VoxelCoordinates& other) const { return x == other.x && y == other.y && z == other.z; }
+	inline bool operator!=(const VoxelCoordinates& other) const { return !(*this == other); }
+};
+
+
+inline std::uint64_t computeVoxelCoordinatesHash(const VoxelCoordinates& voxel_coordinates) {
+	std::uint64_t hash = (std::uint64_t)voxel_coordinates.x * 0x9E3779B97F4A7C15ULL;
+	hash ^= (std::uint64_t)voxel_coordinates.y * 0xC2B2AE3D27D4EB4FULL + (hash << 6) + (hash >> 2);
+	hash ^= (std::uint64_t)voxel_coordinates.z * 0x165667B19E3779F9ULL + (hash << 6) + (hash >> 2);
+	hash ^= hash >> 31;
+	return hash;
+}
+
+
+/// Hash functor for using VoxelCoordinates as key of std::unordered_map / std::unordered_set
+struct VoxelCoordinatesHash {
+	inline size_t operator()(const VoxelCoordinates& voxel_coordinates) const { return (size_t)computeVoxelCoordinatesHash(voxel_coordinates); }
+};
+
+} /* namespace dynamic_robot_localization */
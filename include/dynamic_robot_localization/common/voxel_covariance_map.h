@@ -0,0 +1,114 @@
+#pragma once
+
+/**\file voxel_covariance_map.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+#include <pcl/search/kdtree.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <Eigen/StdVector>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/common/voxel_hash_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+/// Sums of the points and of their covariances inside a voxel, with the mean point and mean covariance computed from them
+struct VoxelCovariance {
+	Eigen::Vector3d points_sum;
+	Eigen::Matrix3d covariances_sum;
+	int number_of_points;
+	Eigen::Vector3d mean;
+	Eigen::Matrix3d covariance;
+	bool valid;
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+// ##########################################################################   VoxelCovarianceMap   ##########################################################################
+/**
+ * \brief Voxel grid with the mean of the points and the mean of the point covariances (generalized icp plane model) inside each voxel (used by the voxelized generalized icp).
+ * The point covariances are computed from the k nearest neighbors or from the point normals and the voxels keep their sums, which allows to add points to the map
+ * without recomputing the covariances of the points already integrated (the covariances of the old points near the new ones are not recomputed).
+ */
+template <typename PointT>
+class VoxelCovarianceMap : public VoxelHashMap<PointT, VoxelCovariance> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< VoxelCovarianceMap<PointT> >;
+		using ConstPtr = std::shared_ptr< const VoxelCovarianceMap<PointT> >;
+		using Covariances = std::vector< Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> >;
+		using VoxelHashMap<PointT, VoxelCovariance>::updateReferenceCloud;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		VoxelCovarianceMap() : VoxelHashMap<PointT, VoxelCovariance>(1), number_of_neighbors_for_covariance_estimation_(20), covariance_epsilon_(0.001), use_normals_for_reference_covariances_(true) {}
+		virtual ~VoxelCovarianceMap() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelCovarianceMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Same as VoxelHashMap::updateReferenceCloud, with search_method used for the k nearest neighbors of the point covariances if it was built with reference_cloud
+		void updateReferenceCloud(const typename pcl::PointCloud<PointT>::ConstPtr& reference_cloud, const typename pcl::search::KdTree<PointT>::Ptr& search_method);
+
+		/// Computes in parallel the covariances of the points [first_point_index, pointcloud.size()[ (covariances_out is only resized if needed, for reusing its memory across scans)
+		void computePointCovariances(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, const typename pcl::search::KdTree<PointT>::Ptr& search_method, bool use_normals,
+				Covariances& covariances_out, size_t first_point_index = 0) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelCovarianceMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		int getNumberOfNeighborsForCovarianceEstimation() const { return number_of_neighbors_for_covariance_estimation_; }
+		double getCovarianceEpsilon() const { return covariance_epsilon_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// The map is cleared if any of the parameters that change the point covariances is modified
+		void setNumberOfNeighborsForCovarianceEstimation(int number_of_neighbors) { if (number_of_neighbors != number_of_neighbors_for_covariance_estimation_) { number_of_neighbors_for_covariance_estimation_ = number_of_neighbors; VoxelHashMap<PointT, VoxelCovariance>::clear(); } }
+		/// Variance along the surface normal of the point covariances (the variance along the surface is 1)
+		void setCovarianceEpsilon(double covariance_epsilon) { if (covariance_epsilon != covariance_epsilon_) { covariance_epsilon_ = covariance_epsilon; VoxelHashMap<PointT, VoxelCovariance>::clear(); } }
+		void setUseNormalsForReferenceCovariances(bool use_normals) { if (use_normals != use_normals_for_reference_covariances_) { use_normals_for_reference_covariances_ = use_normals; VoxelHashMap<PointT, VoxelCovariance>::clear(); } }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		/// Computes the covariances of the new reference points
+		virtual void prepareNewPoints(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, size_t first_point_index);
+		virtual void initializeVoxel(VoxelCovariance& voxel) const;
+		virtual void addPointToVoxel(const PointT& point, size_t new_point_index, VoxelCovariance& voxel) const;
+		virtual void updateVoxel(VoxelCovariance& voxel) const;
+
+		/// Covariance with variance covariance_epsilon_ along the surface normal (from the point normal or from the smallest eigenvector of the k nearest neighbors covariance) and 1 along the surface
+		void computePointCovariance(const pcl::PointCloud<PointT>& pointcloud, const pcl::search::KdTree<PointT>& search_method, size_t point_index, bool use_normals,
+				pcl::Indices& neighbors_indices, std::vector<float>& neighbors_squared_distances, Eigen::Matrix3d& covariance_out) const;
+
+		int number_of_neighbors_for_covariance_estimation_;
+		double covariance_epsilon_;
+		bool use_normals_for_reference_covariances_;
+		typename pcl::search::KdTree<PointT>::Ptr reference_cloud_search_method_;
+		Covariances new_points_covariances_;
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/voxel_covariance_map.hpp>
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+
+/**\file voxel_gaussian_map.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <memory>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+
+// project includes
+#include <dynamic_robot_localization/common/voxel_hash_map.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+/// Sums of the points and of their outer products inside a voxel, with the normal distribution computed from them
+struct VoxelNormalDistribution {
+	Eigen::Vector3d points_sum;
+	Eigen::Matrix3d points_outer_products_sum;
+	int number_of_points;
+	Eigen::Vector3d mean;
+	Eigen::Matrix3d inverse_covariance;
+	bool valid;
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+// ###########################################################################   VoxelGaussianMap   ###########################################################################
+/**
+ * \brief Voxel grid with the normal distribution (mean and inverse covariance) of the points inside each voxel (used by the normal distributions transform).
+ * The voxels keep the sums of the points and of their outer products, which allows to add points to the map without recomputing the statistics of the untouched voxels.
+ */
+template <typename PointT>
+class VoxelGaussianMap : public VoxelHashMap<PointT, VoxelNormalDistribution> {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< VoxelGaussianMap<PointT> >;
+		using ConstPtr = std::shared_ptr< const VoxelGaussianMap<PointT> >;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		VoxelGaussianMap() : VoxelHashMap<PointT, VoxelNormalDistribution>(6), minimum_covariance_eigenvalue_ratio_(0.01) {}
+		virtual ~VoxelGaussianMap() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Minimum ratio between the smallest and the largest eigenvalues of the voxels covariances (avoids singular covariances on planar and linear surfaces)
+		void setMinimumCovarianceEigenvalueRatio(double minimum_covariance_eigenvalue_ratio) { if (minimum_covariance_eigenvalue_ratio != minimum_covariance_eigenvalue_ratio_) { minimum_covariance_eigenvalue_ratio_ = minimum_covariance_eigenvalue_ratio; VoxelHashMap<PointT, VoxelNormalDistribution>::clear(); } }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		virtual void initializeVoxel(VoxelNormalDistribution& voxel) const;
+		virtual void addPointToVoxel(const PointT& point, size_t new_point_index, VoxelNormalDistribution& voxel) const;
+		/// Computes the mean and the inverse of the covariance (with its smallest eigenvalues inflated)
+		virtual void updateVoxel(VoxelNormalDistribution& voxel) const;
+
+		double minimum_covariance_eigenvalue_ratio_;
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/voxel_gaussian_map.hpp>
+#endif
@@ -0,0 +1,117 @@
+#pragma once
+
+/**\file voxel_hash_clustering.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/PointIndices.h>
+#include <pcl/common/point_tests.h>
+
+// project includes
+#include <dynamic_robot_localization/common/voxel_coordinates.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// ##########################################################################   VoxelHashClustering   ##########################################################################
+/**
+ * \brief Parallel extraction of the connected components of the graph linking points closer than the cluster tolerance (and that pass an optional point pair test).
+ * Neighbors are searched in a hash grid with voxels of cluster tolerance size and the components are merged with a lock free union find.
+ * The voxel grid and union find buffers are kept between calls, and the clusters are returned as indices into the input cloud.
+ */
+template <typename PointT>
+class VoxelHashClustering {
+	// ========================================================================   <public-section>   ===========================================================================
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< VoxelHashClustering<PointT> >;
+		using ConstPtr = std::shared_ptr< const VoxelHashClustering<PointT> >;
+		using PointPairTest = std::function<bool(const PointT&, const PointT&)>;
+
+		struct HashTableSlot {
+			VoxelCoordinates voxel_coordinates;
+			std::uint32_t voxel_index;
+		};
+
+		static constexpr std::uint32_t EMPTY_SLOT = std::numeric_limits<std::uint32_t>::max();
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		VoxelHashClustering() : cluster_tolerance_(0.02), min_cluster_size_(1), max_cluster_size_(std::numeric_limits<int>::max()), number_of_threads_(0), union_find_parents_capacity_(0) {}
+		virtual ~VoxelHashClustering() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelHashClustering-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/**
+		 * Computes the clusters of the points of pointcloud selected by indices (null -> all points)
+		 * @param cluster_indices Clusters (with indices into pointcloud) sorted by decreasing size
+		 */
+		void extract(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices, std::vector<pcl::PointIndices>& cluster_indices);
+		void buildVoxelHashGrid(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices);
+		void connectNeighbors(const pcl::PointCloud<PointT>& pointcloud, const pcl::IndicesPtr& indices);
+		std::uint32_t findVoxel(const VoxelCoordinates& voxel_coordinates) const;
+		int findUnionFindRoot(int element);
+		void mergeUnionFindSets(int first_element, int second_element);
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelHashClustering-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		double getClusterTolerance() const { return cluster_tolerance_; }
+		int getMinClusterSize() const { return min_cluster_size_; }
+		int getMaxClusterSize() const { return max_cluster_size_; }
+		int getNumberOfThreads() const { return number_of_threads_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		void setClusterTolerance(double cluster_tolerance) { cluster_tolerance_ = cluster_tolerance; }
+		void setMinClusterSize(int min_cluster_size) { min_cluster_size_ = min_cluster_size; }
+		void setMaxClusterSize(int max_cluster_size) { max_cluster_size_ = max_cluster_size; }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		/// Extra test that two points closer than the cluster tolerance must pass for being in the same cluster (such as the angle between their normals)
+		void setPointPairTest(const PointPairTest& point_pair_test) { point_pair_test_ = point_pair_test; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+	// ========================================================================   </public-section>  ===========================================================================
+
+	// ========================================================================   <protected-section>   ========================================================================
+	protected:
+		double cluster_tolerance_;
+		int min_cluster_size_;
+		int max_cluster_size_;
+		int number_of_threads_;
+		PointPairTest point_pair_test_;
+		std::vector<VoxelCoordinates> points_voxel_coordinates_;
+		std::vector<std::uint32_t> points_voxel_index_;
+		std::vector<HashTableSlot> hash_table_;
+		std::vector<std::uint32_t> voxels_points_offsets_;
+		std::vector<std::uint32_t> voxels_points_;
+		std::unique_ptr< std::atomic<int>[] > union_find_parents_;
+		size_t union_find_parents_capacity_;
+		std::vector<int> roots_cluster_index_;
+	// ========================================================================   </protected-section>  ========================================================================
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/voxel_hash_clustering.hpp>
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+/**\file voxel_hash_map.h
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// std includes
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ROS includes
+#include <ros/ros.h>
+
+// PCL includes
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+
+// external libs includes
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+// project includes
+#include <dynamic_robot_localization/common/voxel_coordinates.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+// #############################################################################   VoxelHashMap   #############################################################################
+/**
+ * \brief Sparse voxel grid (hash map of the voxel coordinates) with a VoxelT payload computed from the points inside each voxel.
+ * The subclasses define how the points are accumulated in the payload and how its statistics are updated (VoxelT must have a bool valid member).
+ * When the reference cloud given to updateReferenceCloud starts with the same points that were integrated in the previous call (same count and checksum),
+ * only the new points are integrated (incremental map update). Otherwise the map is rebuilt.
+ */
+template <typename PointT, typename VoxelT>
+class VoxelHashMap {
+	public:
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		using Ptr = std::shared_ptr< VoxelHashMap<PointT, VoxelT> >;
+		using ConstPtr = std::shared_ptr< const VoxelHashMap<PointT, VoxelT> >;
+		using Voxel = VoxelT;
+
+		enum NeighborSearchMethod { DIRECT1, DIRECT7, DIRECT27 };
+
+		static constexpr int MAXIMUM_NUMBER_OF_NEIGHBORS = 27;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		explicit VoxelHashMap(int minimum_number_of_points_per_voxel = 1) : resolution_(1.0), minimum_number_of_points_per_voxel_(minimum_number_of_points_per_voxel), number_of_threads_(0),
+				number_of_integrated_points_(0), integrated_points_checksum_(0) {}
+		virtual ~VoxelHashMap() {}
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <VoxelHashMap-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// Integrates only the new points if reference_cloud starts with the previously integrated points (same count and checksum), otherwise rebuilds the map
+		void updateReferenceCloud(const typename pcl::PointCloud<PointT>::ConstPtr& reference_cloud);
+		/// Adds the points [first_point_index, pointcloud.size()[ to the voxels and updates the voxels that received points
+		void addPoints(const typename pcl::PointCloud<PointT>::ConstPtr& pointcloud, size_t first_point_index = 0);
+		void clear();
+
+		inline VoxelCoordinates computeVoxelCoordinates(double x, double y, double z) const {
+			VoxelCoordinates voxel_coordinates;
+			voxel_coordinates.x = (std::int64_t)std::floor(x / resolution_);
+			voxel_coordinates.y = (std::int64_t)std::floor(y / resolution_);
+			voxel_coordinates.z = (std::int64_t)std::floor(z / resolution_);
+			return voxel_coordinates;
+		}
+
+		/// Finds the valid voxels around the point (neighbors_out must have space for MAXIMUM_NUMBER_OF_NEIGHBORS voxels), returning the number of voxels found
+		int findNeighborVoxels(const Eigen::Vector3d& point, NeighborSearchMethod neighbor_search_method, const VoxelT* neighbors_out[]) const;
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </VoxelHashMap-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		bool empty() const { return voxels_.empty(); }
+		size_t getNumberOfVoxels() const { return voxels_.size(); }
+		size_t getNumberOfIntegratedPoints() const { return number_of_integrated_points_; }
+		double getResolution() const { return resolution_; }
+		int getMinimumNumberOfPointsPerVoxel() const { return minimum_number_of_points_per_voxel_; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <sets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+		/// The map is cleared if any of the parameters that change the voxels is modified
+		void setResolution(double resolution) { if (resolution != resolution_) { resolution_ = resolution; clear(); } }
+		void setMinimumNumberOfPointsPerVoxel(int minimum_number_of_points_per_voxel) { if (minimum_number_of_points_per_voxel != minimum_number_of_points_per_voxel_) { minimum_number_of_points_per_voxel_ = minimum_number_of_points_per_voxel; clear(); } }
+		void setNumberOfThreads(int number_of_threads) { number_of_threads_ = number_of_threads; }
+		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </sets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+	protected:
+		/// Called before integrating the points [first_point_index, pointcloud.size()[ (allows to precompute in parallel the data of the new points)
+		virtual void prepareNewPoints(const typename pcl::PointCloud<PointT>::ConstPtr& /*pointcloud*/, size_t /*first_point_index*/) {}
+		virtual void initializeVoxel(VoxelT& voxel) const = 0;
+		/// Accumulates the point in the voxel (new_point_index is relative to the first_point_index given to prepareNewPoints)
+		virtual void addPointToVoxel(const PointT& point, size_t new_point_index, VoxelT& voxel) const = 0;
+		/// Recomputes the statistics and the valid flag of a voxel that received points (called in parallel)
+		virtual void updateVoxel(VoxelT& voxel) const = 0;
+
+		/// Order dependent checksum of the positions of the points [first_point_index, last_point_index[ (all non finite points have the same contribution, because NaN != NaN)
+		std::uint64_t computePointsChecksum(const pcl::PointCloud<PointT>& pointcloud, size_t first_point_index, size_t last_point_index) const;
+		static inline std::uint64_t mixChecksum(std::uint64_t hash) {
+			hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+			return hash ^ (hash >> 31);
+		}
+
+		double resolution_;
+		int minimum_number_of_points_per_voxel_;
+		int number_of_threads_;
+		std::vector< VoxelT, Eigen::aligned_allocator<VoxelT> > voxels_;
+		std::unordered_map<VoxelCoordinates, size_t, VoxelCoordinatesHash> voxels_indices_;
+		size_t number_of_integrated_points_;
+		std::uint64_t integrated_points_checksum_;
+};
+
+} /* namespace dynamic_robot_localization */
+
+
+#ifdef DRL_NO_PRECOMPILE
+#include <dynamic_robot_localization/common/impl/voxel_hash_map.hpp>
+#endif
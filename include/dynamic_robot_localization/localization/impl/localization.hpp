@@ -18,13 +18,21 @@ namespace dynamic_robot_localization {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 template<typename PointT>
 Localization<PointT>::Localization() :
+	chain_filters_using_point_indices_(true),
 	reference_pointcloud_normalize_normals_(true),
 	flip_normals_using_occupancy_grid_analysis_(true),
 	map_update_mode_(NoIntegration),
 	use_incremental_map_update_(false),
 	override_pointcloud_timestamp_to_current_time_(false),
+	use_ambient_pointcloud_decoder_(true),
+	ambient_pointcloud_nans_removed_while_decoding_(false),
+	use_ambient_pointcloud_deskewing_(false),
 	minimum_number_of_points_in_ambient_pointcloud_(10),
 	minimum_number_of_points_in_reference_pointcloud_(10),
+	occupancy_grid_threshold_for_map_cell_as_obstacle_(95),
+	occupancy_grid_extract_only_boundary_cells_(false),
+	occupancy_grid_compute_normals_from_occupancy_gradient_(false),
+	occupancy_grid_conversion_number_of_threads_(0),
 	localization_detailed_use_millimeters_in_root_mean_square_error_inliers_(false),
 	localization_detailed_use_millimeters_in_root_mean_square_error_of_last_registration_correspondences_(false),
 	localization_detailed_use_millimeters_in_translation_corrections_(false),
@@ -43,6 +51,8 @@ Localization<PointT>::Localization() :
 	compute_keypoints_when_tracking_pose_(false),
 	compute_keypoints_when_recovering_pose_tracking_(false),
 	compute_keypoints_when_estimating_initial_pose_(true),
+	run_reference_cloud_keypoint_detectors_concurrently_(false),
+	run_ambient_cloud_keypoint_detectors_concurrently_(false),
 	compute_inliers_angular_distribution_(true),
 	compute_outliers_angular_distribution_(true),
 	inliers_angular_distribution_(-1.0),
@@ -133,6 +143,7 @@ void Localization<PointT>::setupConfigurationFromParameterServer(ros::NodeHandle
 	setupTransformationValidatorsForInitialAlignment(configuration_namespace);
 	setupTransformationValidatorsForTracking(configuration_namespace);
 	setupTransformationValidatorsForTrackingRecovery(configuration_namespace);
+	setupMotionPredictorConfigurations(configuration_namespace);
 	setupRegistrationCovarianceEstimatorsConfigurations(configuration_namespace);
 	setupTFPublisher(configuration_namespace);
 	updateNormalsEstimationFlags();
@@ -225,6 +236,9 @@ bool Localization<PointT>::reloadConfigurationFromParameterServer(const dynamic_
 	if (parseConfigurationNamespace(localization_configuration.transformation_validators_for_tracking_recovery, parsed_string))
 		setupTransformationValidatorsForTrackingRecovery(parsed_string);
 
+	if (parseConfigurationNamespace(localization_configuration.motion_predictor, parsed_string))
+		setupMotionPredictorConfigurations(parsed_string);
+
 	if (parseConfigurationNamespace(localization_configuration.registration_covariance_estimators, parsed_string))
 		setupRegistrationCovarianceEstimatorsConfigurations(parsed_string);
 
@@ -412,6 +426,10 @@ void Localization<PointT>::setupInitialPose(const std::string& configuration_nam
 	if (update_last_accepted_pose_time) {
 		last_accepted_pose_time_ = time;
 	}
+
+	if (motion_predictor_) {
+		motion_predictor_->reset();
+	}
 }
 
 
@@ -439,6 +457,38 @@ void Localization<PointT>::setupMessageManagement(const std::string& configurati
 
 	private_node_handle_->param(configuration_namespace + "message_management/override_pointcloud_timestamp_to_current_time", override_pointcloud_timestamp_to_current_time_, false);
 
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/use_decoder", use_ambient_pointcloud_decoder_, true);
+	double decoder_box_min_x, decoder_box_min_y, decoder_box_min_z, decoder_box_max_x, decoder_box_max_y, decoder_box_max_z, decoder_minimum_range, decoder_maximum_range;
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_min_x", decoder_box_min_x, -std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_min_y", decoder_box_min_y, -std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_min_z", decoder_box_min_z, -std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_max_x", decoder_box_max_x, std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_max_y", decoder_box_max_y, std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/box_max_z", decoder_box_max_z, std::numeric_limits<double>::max());
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/minimum_range", decoder_minimum_range, 0.0);
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_decoder/maximum_range", decoder_maximum_range, 0.0);
+	ambient_pointcloud_decoder_.setBoxMin((float)std::max(decoder_box_min_x, -(double)std::numeric_limits<float>::max()), (float)std::max(decoder_box_min_y, -(double)std::numeric_limits<float>::max()), (float)std::max(decoder_box_min_z, -(double)std::numeric_limits<float>::max()));
+	ambient_pointcloud_decoder_.setBoxMax((float)std::min(decoder_box_max_x, (double)std::numeric_limits<float>::max()), (float)std::min(decoder_box_max_y, (double)std::numeric_limits<float>::max()), (float)std::min(decoder_box_max_z, (double)std::numeric_limits<float>::max()));
+	ambient_pointcloud_decoder_.setMinimumRange((float)decoder_minimum_range);
+	ambient_pointcloud_decoder_.setMaximumRange((float)decoder_maximum_range);
+
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/use_deskewing", use_ambient_pointcloud_deskewing_, false);
+	std::string deskewing_time_field_name;
+	double deskewing_time_field_scale;
+	bool deskewing_time_field_is_relative_to_msg_stamp;
+	int deskewing_number_of_tf_samples, deskewing_number_of_threads;
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/time_field_name", deskewing_time_field_name, std::string("time"));
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/time_field_scale", deskewing_time_field_scale, 1.0);
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/time_field_is_relative_to_msg_stamp", deskewing_time_field_is_relative_to_msg_stamp, true);
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/number_of_tf_samples", deskewing_number_of_tf_samples, 10);
+	private_node_handle_->param(configuration_namespace + "message_management/ambient_pointcloud_deskewing/number_of_threads", deskewing_number_of_threads, 0);
+	ambient_pointcloud_deskewer_.setTimeFieldName(deskewing_time_field_name);
+	ambient_pointcloud_deskewer_.setTimeFieldScale(deskewing_time_field_scale);
+	ambient_pointcloud_deskewer_.setTimeFieldIsRelativeToMsgStamp(deskewing_time_field_is_relative_to_msg_stamp);
+	ambient_pointcloud_deskewer_.setNumberOfMotionSamples(deskewing_number_of_tf_samples);
+	ambient_pointcloud_deskewer_.setNumberOfThreads(deskewing_number_of_threads);
+	ambient_pointcloud_decoder_.setTimeFieldName(use_ambient_pointcloud_deskewing_ ? deskewing_time_field_name : std::string(""));
+
 	double max_seconds_ambient_pointcloud_age;
 	private_node_handle_->param(configuration_namespace + "message_management/max_seconds_ambient_pointcloud_age", max_seconds_ambient_pointcloud_age, 3.0);
 	max_seconds_ambient_pointcloud_age_.fromSec(max_seconds_ambient_pointcloud_age);
@@ -459,6 +509,12 @@ void Localization<PointT>::setupMessageManagement(const std::string& configurati
 
 	private_node_handle_->param(configuration_namespace + "message_management/circular_buffer_require_reception_of_pointcloud_msgs_from_all_topics_before_doing_registration", circular_buffer_require_reception_of_pointcloud_msgs_from_all_topics_before_doing_registration_, false);
 	private_node_handle_->param(configuration_namespace + "message_management/circular_buffer_clear_inserted_points_if_registration_fails", circular_buffer_clear_inserted_points_if_registration_fails_, false);
+	double circular_buffer_fusion_time_window;
+	private_node_handle_->param(configuration_namespace + "message_management/circular_buffer_fusion_time_window", circular_buffer_fusion_time_window, 0.0);
+	circular_buffer_fusion_time_window_.fromSec(circular_buffer_fusion_time_window);
+	private_node_handle_->param(configuration_namespace + "message_management/circular_buffer_fusion_minimum_percentage_of_topics", circular_buffer_fusion_minimum_percentage_of_topics_, 1.0);
+	msg_frame_ids_with_data_in_circular_buffer_.clear();
+	circular_buffer_msgs_points_.clear();
 	private_node_handle_->param(configuration_namespace + "message_management/minimum_number_points_ambient_pointcloud_circular_buffer", minimum_number_points_ambient_pointcloud_circular_buffer_, 0);
 	int maximum_number_points_ambient_pointcloud_circular_buffer;
 	private_node_handle_->param(configuration_namespace + "message_management/maximum_number_points_ambient_pointcloud_circular_buffer", maximum_number_points_ambient_pointcloud_circular_buffer, 0);
@@ -494,6 +550,10 @@ void Localization<PointT>::setupReferencePointCloud(const std::string& configura
 	private_node_handle_->param(configuration_namespace + "reference_pointclouds/save_reference_pointclouds_in_binary_format", save_reference_pointclouds_in_binary_format_, true);
 	private_node_handle_->param(configuration_namespace + "reference_pointclouds/republish_reference_pointcloud_after_successful_registration", republish_reference_pointcloud_after_successful_registration_, false);
 	private_node_handle_->param(configuration_namespace + "reference_pointclouds/minimum_number_of_points_in_reference_pointcloud", minimum_number_of_points_in_reference_pointcloud_, 10);
+	private_node_handle_->param(configuration_namespace + "reference_pointclouds/occupancy_grid_threshold_for_map_cell_as_obstacle", occupancy_grid_threshold_for_map_cell_as_obstacle_, 95);
+	private_node_handle_->param(configuration_namespace + "reference_pointclouds/occupancy_grid_extract_only_boundary_cells", occupancy_grid_extract_only_boundary_cells_, false);
+	private_node_handle_->param(configuration_namespace + "reference_pointclouds/occupancy_grid_compute_normals_from_occupancy_gradient", occupancy_grid_compute_normals_from_occupancy_gradient_, false);
+	private_node_handle_->param(configuration_namespace + "reference_pointclouds/occupancy_grid_conversion_number_of_threads", occupancy_grid_conversion_number_of_threads_, 0);
 
 	std::string reference_pointcloud_type;
 	private_node_handle_->param(configuration_namespace + "reference_pointclouds/reference_pointcloud_type", reference_pointcloud_type, std::string("3D"));
@@ -544,6 +604,7 @@ void Localization<PointT>::setupFiltersConfigurations(const std::string& configu
 	private_node_handle_->param(configuration_namespace + "filters/filtered_pointcloud_save_frame_id", filtered_pointcloud_save_frame_id_, std::string(""));
 	private_node_handle_->param(configuration_namespace + "filters/filtered_pointcloud_save_frame_id_with_cloud_time", filtered_pointcloud_save_frame_id_with_cloud_time_, false);
 	private_node_handle_->param(configuration_namespace + "filters/stop_processing_after_saving_filtered_pointcloud", stop_processing_after_saving_filtered_pointcloud_, true);
+	private_node_handle_->param(configuration_namespace + "filters/chain_filters_using_point_indices", chain_filters_using_point_indices_, true);
 
 	loadFiltersFromParameterServer(reference_cloud_filters_, configuration_namespace + "filters/reference_pointcloud/");
 	loadFiltersFromParameterServer(ambient_pointcloud_integration_filters_, configuration_namespace + "filters/ambient_pointcloud_integration_filters/");
@@ -565,7 +626,9 @@ void Localization<PointT>::loadFiltersFromParameterServer(std::vector< typename
 		for (XmlRpc::XmlRpcValue::iterator it = filters.begin(); it != filters.end(); ++it) {
 			std::string filter_name = it->first;
 			typename CloudFilter<PointT>::Ptr cloud_filter;
-			if (filter_name.find("approximate_voxel_grid") != std::string::npos) {
+			if (filter_name.find("hashed_voxel_grid") != std::string::npos) {
+				cloud_filter.reset(new HashedVoxelGrid<PointT>());
+			} else if (filter_name.find("approximate_voxel_grid") != std::string::npos) {
 				cloud_filter.reset(new ApproximateVoxelGrid<PointT>());
 			} else if (filter_name.find("voxel_grid") != std::string::npos) {
 				cloud_filter.reset(new VoxelGrid<PointT>());
@@ -709,9 +772,25 @@ void Localization<PointT>::setupKeypointDetectors(const std::string& configurati
 	private_node_handle_->param(configuration_namespace + "keypoint_detectors/ambient_pointcloud/compute_keypoints_when_tracking_pose", compute_keypoints_when_tracking_pose_, false);
 	private_node_handle_->param(configuration_namespace + "keypoint_detectors/ambient_pointcloud/compute_keypoints_when_recovering_pose_tracking", compute_keypoints_when_recovering_pose_tracking_, false);
 	private_node_handle_->param(configuration_namespace + "keypoint_detectors/ambient_pointcloud/compute_keypoints_when_estimating_initial_pose", compute_keypoints_when_estimating_initial_pose_, true);
+	private_node_handle_->param(configuration_namespace + "keypoint_detectors/reference_pointcloud/run_detectors_concurrently", run_reference_cloud_keypoint_detectors_concurrently_, false);
+	private_node_handle_->param(configuration_namespace + "keypoint_detectors/ambient_pointcloud/run_detectors_concurrently", run_ambient_cloud_keypoint_detectors_concurrently_, false);
 
 	loadKeypointDetectorsFromParameterServer(reference_cloud_keypoint_detectors_, configuration_namespace + "keypoint_detectors/reference_pointcloud/");
 	loadKeypointDetectorsFromParameterServer(ambient_cloud_keypoint_detectors_, configuration_namespace + "keypoint_detectors/ambient_pointcloud/");
+
+	reference_cloud_keypoints_changed_regions_detector_.reset(new ChangedRegionsDetector<PointT>());
+	reference_cloud_keypoints_changed_regions_detector_->setupConfigurationFromParameterServer(node_handle_, private_node_handle_, configuration_namespace + "keypoint_detectors/reference_pointcloud/changed_regions/");
+	if (reference_cloud_keypoints_changed_regions_detector_->getVoxelSize() > 0.0 && !reference_cloud_keypoint_detectors_.empty()) {
+		double keypoints_support_radius = 0.0;
+		for (size_t i = 0; i < reference_cloud_keypoint_detectors_.size(); ++i) {
+			keypoints_support_radius = std::max(keypoints_support_radius, reference_cloud_keypoint_detectors_[i]->getKeypointSupportRadius());
+		}
+		double extra_support_radius;
+		private_node_handle_->param(configuration_namespace + "keypoint_detectors/reference_pointcloud/changed_regions/extra_support_radius", extra_support_radius, 0.0);
+		reference_cloud_keypoints_changed_regions_detector_->setSupportRadius(keypoints_support_radius + extra_support_radius);
+	} else {
+		reference_cloud_keypoints_changed_regions_detector_.reset();
+	}
 }
 
 
@@ -805,7 +884,9 @@ void Localization<PointT>::setupPointCloudMatchersConfigurations(std::vector< ty
 		for (XmlRpc::XmlRpcValue::iterator it = matchers.begin(); it != matchers.end(); ++it) {
 			std::string matcher_name = it->first;
 			typename CloudMatcher<PointT>::Ptr cloud_matcher;
-			if (matcher_name.find("iterative_closest_point_generalized") != std::string::npos) {
+			if (matcher_name.find("iterative_closest_point_generalized_voxelized") != std::string::npos) {
+				cloud_matcher.reset(new IterativeClosestPointGeneralizedVoxelized<PointT>());
+			} else if (matcher_name.find("iterative_closest_point_generalized") != std::string::npos) {
 				cloud_matcher.reset(new IterativeClosestPointGeneralized<PointT>());
 			} else if (matcher_name.find("iterative_closest_point_with_normals") != std::string::npos) {
 				cloud_matcher.reset(new IterativeClosestPointWithNormals<PointT>());
@@ -815,12 +896,18 @@ void Localization<PointT>::setupPointCloudMatchersConfigurations(std::vector< ty
 				cloud_matcher.reset(new IterativeClosestPoint2D<PointT>());
 			} else if (matcher_name.find("iterative_closest_point") != std::string::npos) {
 				cloud_matcher.reset(new IterativeClosestPoint<PointT>());
+			} else if (matcher_name.find("normal_distributions_transform_voxel_map") != std::string::npos) {
+				cloud_matcher.reset(new NormalDistributionsTransformVoxelMap<PointT>());
 			} else if (matcher_name.find("normal_distributions_transform_2d") != std::string::npos) {
 				cloud_matcher.reset(new NormalDistributionsTransform2D<PointT>());
 			} else if (matcher_name.find("normal_distributions_transform_3d") != std::string::npos) {
 				cloud_matcher.reset(new NormalDistributionsTransform3D<PointT>());
 			} else if (matcher_name.find("principal_component_analysis") != std::string::npos) {
 				cloud_matcher.reset(new PrincipalComponentAnalysis<PointT>());
+			} else if (matcher_name.find("branch_and_bound_2d") != std::string::npos) {
+				cloud_matcher.reset(new BranchAndBound2D<PointT>());
+			} else if (matcher_name.find("correlative_scan_matcher_2d") != std::string::npos) {
+				cloud_matcher.reset(new CorrelativeScanMatcher2D<PointT>());
 			}
 
 			if (cloud_matcher) {
@@ -942,6 +1029,32 @@ void Localization<PointT>::setupTransformationValidatorsForTrackingRecovery(cons
 }
 
 
+template<typename PointT>
+void Localization<PointT>::setupMotionPredictorConfigurations(const std::string& configuration_namespace) {
+	ROS_DEBUG_STREAM("Loading [motion_predictor] configurations from parameter server namespace [" << (configuration_namespace.empty() ? "~" : configuration_namespace) << "]");
+	motion_predictor_.reset();
+	std::string configuration_namespace_motion_predictor = configuration_namespace + "motion_predictor/";
+	XmlRpc::XmlRpcValue motion_predictors;
+	if (private_node_handle_->getParam(configuration_namespace_motion_predictor, motion_predictors) && motion_predictors.getType() == XmlRpc::XmlRpcValue::TypeStruct) {
+		for (XmlRpc::XmlRpcValue::iterator it = motion_predictors.begin(); it != motion_predictors.end(); ++it) {
+			std::string predictor_name = it->first;
+			if (predictor_name.find("constant_velocity_motion_predictor") != std::string::npos) {
+				motion_predictor_.reset(new ConstantVelocityMotionPredictor());
+			} else if (predictor_name.find("constant_acceleration_motion_predictor") != std::string::npos) {
+				motion_predictor_.reset(new ConstantAccelerationMotionPredictor());
+			} else if (predictor_name.find("imu_motion_predictor") != std::string::npos) {
+				motion_predictor_.reset(new ImuMotionPredictor());
+			}
+
+			if (motion_predictor_) {
+				motion_predictor_->setupConfigurationFromParameterServer(node_handle_, private_node_handle_, configuration_namespace_motion_predictor + predictor_name + "/");
+				break;
+			}
+		}
+	}
+}
+
+
 template<typename PointT>
 void Localization<PointT>::setupOutlierDetectorsConfigurations(const std::string& configuration_namespace) {
 	setupOutlierDetectorsConfigurations(outlier_detectors_, configuration_namespace + "outlier_detectors/", "aligned_");
@@ -1120,7 +1233,8 @@ void Localization<PointT>::loadReferencePointCloudFromROSOccupancyGrid(const nav
 	size_t number_points_in_occupancy_grid = occupancy_grid_msg->info.width * occupancy_grid_msg->info.height;
 	if (number_points_in_occupancy_grid > (size_t)minimum_number_of_points_in_reference_pointcloud_ && (!reference_pointcloud_loaded_ || (ros::Time::now() - last_map_received_time_) > min_seconds_between_reference_pointcloud_update_)) {
 		typename pcl::PointCloud<PointT>::Ptr reference_pointcloud_from_occupancy_grid(new pcl::PointCloud<PointT>());
-		if (pointcloud_conversions::fromROSMsg(*occupancy_grid_msg, *reference_pointcloud_from_occupancy_grid)) {
+		if (pointcloud_conversions::fromROSMsg(*occupancy_grid_msg, *reference_pointcloud_from_occupancy_grid, pointcloud_conversions::OccupancyGridValuesPtr(), occupancy_grid_threshold_for_map_cell_as_obstacle_,
+				occupancy_grid_extract_only_boundary_cells_, occupancy_grid_compute_normals_from_occupancy_gradient_, occupancy_grid_conversion_number_of_threads_)) {
 			if (reference_pointcloud_from_occupancy_grid->size() > (size_t)minimum_number_of_points_in_reference_pointcloud_) {
 				reference_pointcloud_2d_ = true;
 				if (occupancy_grid_msg->header.frame_id != map_frame_id_ && !transformCloudToTFFrame(reference_pointcloud_from_occupancy_grid, occupancy_grid_msg->header.stamp, map_frame_id_for_transforming_pointclouds_)) { return; }
@@ -1208,13 +1322,17 @@ bool Localization<PointT>::updateLocalizationPipelineWithNewReferenceCloud(const
 
 			if (!reference_cloud_keypoint_detectors_.empty()) {
 				if (reference_pointcloud_keypoints_filename_.empty() || !pointcloud_conversions::fromFile(*reference_pointcloud_keypoints_, reference_pointcloud_keypoints_filename_, reference_pointclouds_database_folder_path_)) {
-					applyKeypointDetection(reference_cloud_keypoint_detectors_, reference_pointcloud_, reference_pointcloud_search_method_, reference_pointcloud_keypoints_);
+					applyKeypointDetectionInChangedRegions(reference_cloud_keypoint_detectors_, reference_pointcloud_, reference_pointcloud_search_method_, reference_pointcloud_keypoints_, run_reference_cloud_keypoint_detectors_concurrently_);
 
 					if (!reference_pointcloud_keypoints_save_filename_.empty()) {
 						ROS_INFO_STREAM("Saving reference pointcloud keypoints with " << reference_pointcloud_keypoints_->size() << " points to file " << reference_pointcloud_keypoints_save_filename_);
 						pcl::io::savePCDFile<PointT>(reference_pointcloud_keypoints_save_filename_, *reference_pointcloud_keypoints_, save_reference_pointclouds_in_binary_format_);
 					}
 				} else {
+					if (reference_cloud_keypoints_changed_regions_detector_) {
+						reference_cloud_keypoints_changed_regions_detector_->detectChangedRegions(*reference_pointcloud_);
+						reference_cloud_keypoints_changed_regions_detector_->commitChangedRegions();
+					}
 					ROS_INFO_STREAM("Loaded " << reference_pointcloud_keypoints_->size() << " keypoints from file " << reference_pointcloud_keypoints_filename_);
 				}
 			}
@@ -1305,6 +1423,9 @@ void Localization<PointT>::setInitialPose(const geometry_msgs::Pose& pose, const
 			last_accepted_pose_valid_ = true;
 			pose_tracking_number_of_failed_registrations_since_last_valid_pose_ = 0;
 			received_external_initial_pose_estimation_ = true;
+			if (motion_predictor_) {
+				motion_predictor_->reset();
+			}
 			ROS_INFO_STREAM("Received initial pose at time [" << pose_time_updated << "]: " \
 					<< "\n\tTranslation -> [ x: " << transform_base_link_to_map.getOrigin().getX() << " | y: " << transform_base_link_to_map.getOrigin().getY() << " | z: " << transform_base_link_to_map.getOrigin().getZ() << " ]" \
 					<< "\n\tRotation -> [ qx: " << transform_base_link_to_map.getRotation().getX() << " | qy: " << transform_base_link_to_map.getRotation().getY() << " | qz: " << transform_base_link_to_map.getRotation().getZ() << " | qw: " << transform_base_link_to_map.getRotation().getW() << " ]");
@@ -1664,13 +1785,73 @@ void Localization<PointT>::processAmbientPointCloud(const sensor_msgs::PointClou
 
 	if (checkIfAmbientPointCloudShouldBeProcessed(ambient_cloud_time, number_points_ambient_pointcloud, true, true))
 	{
-		typename pcl::PointCloud<PointT>::Ptr ambient_pointcloud(new pcl::PointCloud<PointT>());
-		pcl::fromROSMsg(*ambient_cloud_msg, *ambient_pointcloud);
+		typename pcl::PointCloud<PointT>::Ptr ambient_pointcloud;
+		bool ambient_pointcloud_decoded = false;
+		if (use_ambient_pointcloud_decoder_ && ambient_pointcloud_decoder_.decode(*ambient_cloud_msg, ambient_pointcloud)) {
+			ambient_pointcloud_decoded = true;
+			if (ambient_pointcloud_decoder_.getNumberOfDiscardedNaNs() > 0 || ambient_pointcloud_decoder_.getNumberOfDiscardedPointsOutsideLimits() > 0) {
+				ROS_DEBUG_STREAM("Discarded " << ambient_pointcloud_decoder_.getNumberOfDiscardedNaNs() << " NaNs and " << ambient_pointcloud_decoder_.getNumberOfDiscardedPointsOutsideLimits() << " points outside the decoder limits from ambient cloud with " << number_points_ambient_pointcloud << " points");
+			}
+			ambient_pointcloud_nans_removed_while_decoding_ = true;
+		} else {
+			ambient_pointcloud.reset(new pcl::PointCloud<PointT>());
+			pcl::fromROSMsg(*ambient_cloud_msg, *ambient_pointcloud);
+		}
 		ambient_pointcloud->header.frame_id = ambient_cloud_msg->header.frame_id;
+		if (use_ambient_pointcloud_deskewing_) {
+			deskewAmbientPointCloud(*ambient_cloud_msg, ambient_cloud_time, ambient_pointcloud_decoded, *ambient_pointcloud);
+		}
 		processAmbientPointCloud(ambient_pointcloud, false, false);
+		ambient_pointcloud_nans_removed_while_decoding_ = false;
 	}
 }
 
+template<typename PointT>
+bool Localization<PointT>::deskewAmbientPointCloud(const sensor_msgs::PointCloud2& ambient_cloud_msg, const ros::Time& ambient_cloud_time, bool points_times_extracted_by_decoder, pcl::PointCloud<PointT>& ambient_pointcloud) {
+	if (ambient_cloud_msg.header.frame_id == odom_frame_id_) { return false; }
+
+	if (points_times_extracted_by_decoder) {
+		ambient_pointcloud_points_times_.swap(ambient_pointcloud_decoder_.getPointsTimes());
+	} else {
+		PointCloudDeskewer<PointT>::extractPointsTimes(ambient_cloud_msg, ambient_pointcloud_deskewer_.getTimeFieldName(), ambient_pointcloud_points_times_);
+	}
+
+	if (ambient_pointcloud_points_times_.size() != ambient_pointcloud.size()) {
+		ROS_WARN_STREAM("Skipping deskewing of ambient cloud with frame " << ambient_cloud_msg.header.frame_id << " because it does not have the time field [" << ambient_pointcloud_deskewer_.getTimeFieldName() << "] for all its points");
+		return false;
+	}
+
+	double minimum_point_time, maximum_point_time;
+	if (!ambient_pointcloud_deskewer_.convertPointsTimesToSecondsRelativeToStamp(ambient_pointcloud_points_times_, ambient_cloud_msg.header.stamp.toSec(), minimum_point_time, maximum_point_time)) { return false; }
+
+	// the reference time is the msg stamp (the pose of the sensor at that time is the one used for the cloud registration)
+	tf2::Transform transform_sensor_to_odom_at_reference_time;
+	if (!pose_to_tf_publisher_->getTfCollector().lookForTransform(transform_sensor_to_odom_at_reference_time, odom_frame_id_, ambient_cloud_msg.header.frame_id, ambient_cloud_msg.header.stamp, tf_timeout_)) {
+		ROS_DEBUG_STREAM("Skipping deskewing of ambient cloud because the transform from " << ambient_cloud_msg.header.frame_id << " to " << odom_frame_id_ << " is not available at the msg stamp");
+		return false;
+	}
+	Eigen::Transform<double, 3, Eigen::Affine> transform_odom_to_sensor_at_reference_time = laserscan_to_pointcloud::tf_rosmsg_eigen_conversions::transformTF2ToTransform<double>(transform_sensor_to_odom_at_reference_time).inverse();
+
+	std::vector<double> motion_samples_times;
+	ambient_pointcloud_deskewer_.computeMotionSamplesTimes(minimum_point_time, maximum_point_time, motion_samples_times);
+	std::vector<typename PointCloudDeskewer<PointT>::MotionSample> motion_samples(motion_samples_times.size());
+	for (size_t i = 0; i < motion_samples_times.size(); ++i) {
+		tf2::Transform transform_sensor_to_odom_at_sample_time;
+		if (!pose_to_tf_publisher_->getTfCollector().lookForTransform(transform_sensor_to_odom_at_sample_time, odom_frame_id_, ambient_cloud_msg.header.frame_id, ambient_cloud_msg.header.stamp + ros::Duration(motion_samples_times[i]), tf_timeout_)) {
+			ROS_DEBUG_STREAM("Skipping deskewing of ambient cloud because the transform from " << ambient_cloud_msg.header.frame_id << " to " << odom_frame_id_ << " is not available " << motion_samples_times[i] << " seconds after the msg stamp");
+			return false;
+		}
+		Eigen::Transform<double, 3, Eigen::Affine> motion_sample = transform_odom_to_sensor_at_reference_time * laserscan_to_pointcloud::tf_rosmsg_eigen_conversions::transformTF2ToTransform<double>(transform_sensor_to_odom_at_sample_time);
+		motion_samples[i].rotation = Eigen::Quaternionf(motion_sample.rotation().cast<float>()).normalized();
+		motion_samples[i].translation = motion_sample.translation().cast<float>();
+	}
+
+	ambient_pointcloud_deskewer_.setMotionSamples(motion_samples_times, motion_samples);
+	bool deskewed = ambient_pointcloud_deskewer_.deskew(ambient_pointcloud, ambient_pointcloud_points_times_);
+	ROS_DEBUG_STREAM("Deskewed ambient cloud with " << ambient_pointcloud.size() << " points captured over " << (maximum_point_time - minimum_point_time) << " seconds (msg time: " << ambient_cloud_time << ")");
+	return deskewed;
+}
+
 template<typename PointT>
 bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud, bool check_if_pointcloud_should_be_processed, bool check_if_pointcloud_subscribers_are_active) {
 	try {
@@ -1709,6 +1890,9 @@ bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<Poi
 
 		if (checkIfTrackingIsLost()) {
 			last_accepted_pose_valid_ = false;
+			if (motion_predictor_) {
+				motion_predictor_->reset();
+			}
 			if (reset_initial_pose_when_tracking_is_lost_) {
 				ROS_DEBUG("Resetting initial pose");
 				setupInitialPose(configuration_namespace_, ambient_cloud_time);
@@ -1735,14 +1919,24 @@ bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<Poi
 		}
 
 		tf2::Transform pose_tf_initial_guess = last_accepted_pose_odom_to_map_ * transform_base_link_to_odom;
+		if (motion_predictor_ && last_accepted_pose_valid_) {
+			tf2::Transform predicted_pose;
+			MotionPredictor::PoseCovariance predicted_pose_covariance;
+			if (motion_predictor_->predictPose(ambient_cloud_time, predicted_pose, predicted_pose_covariance) && math_utils::isTransformValid(predicted_pose)) {
+				ROS_DEBUG_STREAM("Using motion prediction as initial pose (position variance: " << predicted_pose_covariance.block<3, 3>(0, 0).trace() << " | orientation variance: " << predicted_pose_covariance.block<3, 3>(3, 3).trace() << ")");
+				pose_tf_initial_guess = predicted_pose;
+			}
+		}
 		size_t ambient_pointcloud_size = ambient_pointcloud->size();
-		std::vector<int> indexes;
-		ambient_pointcloud->is_dense = false;
-		pcl::removeNaNFromPointCloud(*ambient_pointcloud, *ambient_pointcloud, indexes);
-		indexes.clear();
-		size_t number_of_nans_in_ambient_pointcloud = ambient_pointcloud_size - ambient_pointcloud->size();
-		if (number_of_nans_in_ambient_pointcloud > 0) {
-			ROS_DEBUG_STREAM("Removed " << number_of_nans_in_ambient_pointcloud << " NaNs from ambient cloud with " << ambient_pointcloud_size << " points");
+		if (!ambient_pointcloud_nans_removed_while_decoding_) {
+			std::vector<int> indexes;
+			ambient_pointcloud->is_dense = false;
+			pcl::removeNaNFromPointCloud(*ambient_pointcloud, *ambient_pointcloud, indexes);
+			indexes.clear();
+			size_t number_of_nans_in_ambient_pointcloud = ambient_pointcloud_size - ambient_pointcloud->size();
+			if (number_of_nans_in_ambient_pointcloud > 0) {
+				ROS_DEBUG_STREAM("Removed " << number_of_nans_in_ambient_pointcloud << " NaNs from ambient cloud with " << ambient_pointcloud_size << " points");
+			}
 		}
 
 		tf2::Quaternion pose_tf_initial_guess_q = pose_tf_initial_guess.getRotation().normalize();
@@ -1757,6 +1951,9 @@ bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<Poi
 		ambient_pointcloud_keypoints->header = ambient_pointcloud->header;
 
 		bool localizationUpdateSuccess = updateLocalizationWithAmbientPointCloud(ambient_pointcloud, ambient_cloud_time, pose_tf_initial_guess, pose_tf2_transform_corrected_, pose_corrections, ambient_pointcloud_keypoints) || (!reference_pointcloud_available_ && !reference_pointcloud_loaded_ && map_update_mode_ != NoIntegration);
+		if (localizationUpdateSuccess && motion_predictor_) {
+			motion_predictor_->addPose(pose_tf2_transform_corrected_, ambient_cloud_time);
+		}
 
 		ros::Time pose_time;
 		if (add_odometry_displacement_) {
@@ -1962,7 +2159,7 @@ bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<Poi
 			localization_times_msg_.map_update_time = performance_timer.getElapsedTimeInMilliSec();
 		} else {
 			if (ambient_pointcloud_with_circular_buffer_ && circular_buffer_clear_inserted_points_if_registration_fails_) {
-				ambient_pointcloud_with_circular_buffer_->eraseNewest(last_number_points_inserted_in_circular_buffer_);
+				eraseNewestCircularBufferMsgPoints();
 			}
 			++pose_tracking_number_of_failed_registrations_since_last_valid_pose_;
 			ROS_WARN_STREAM("Discarded cloud because localization couldn't be calculated");
@@ -1988,6 +2185,74 @@ bool Localization<PointT>::processAmbientPointCloud(typename pcl::PointCloud<Poi
 }
 
 
+template<typename PointT>
+void Localization<PointT>::recordCircularBufferMsgPoints(const std::string& msg_frame_id, const ros::Time& msg_time, size_t number_of_points) {
+	CircularBufferMsgPoints msg_points;
+	msg_points.frame_id = msg_frame_id;
+	msg_points.time = msg_time;
+	msg_points.number_of_points = std::min(number_of_points, ambient_pointcloud_with_circular_buffer_->getMaxBufferSize());
+	circular_buffer_msgs_points_.push_back(msg_points);
+
+	size_t number_of_recorded_points = 0;
+	for (size_t i = 0; i < circular_buffer_msgs_points_.size(); ++i) {
+		number_of_recorded_points += circular_buffer_msgs_points_[i].number_of_points;
+	}
+
+	size_t number_of_points_in_buffer = ambient_pointcloud_with_circular_buffer_->size();
+	while (number_of_recorded_points > number_of_points_in_buffer && !circular_buffer_msgs_points_.empty()) {
+		CircularBufferMsgPoints& oldest_msg_points = circular_buffer_msgs_points_.front();
+		size_t number_of_overwritten_points = std::min(oldest_msg_points.number_of_points, number_of_recorded_points - number_of_points_in_buffer);
+		oldest_msg_points.number_of_points -= number_of_overwritten_points;
+		number_of_recorded_points -= number_of_overwritten_points;
+		if (oldest_msg_points.number_of_points == 0) { circular_buffer_msgs_points_.pop_front(); }
+	}
+}
+
+
+template<typename PointT>
+void Localization<PointT>::eraseNewestCircularBufferMsgPoints() {
+	if (last_number_points_inserted_in_circular_buffer_ == 0 || circular_buffer_msgs_points_.empty()) { return; }
+	ambient_pointcloud_with_circular_buffer_->eraseNewest(circular_buffer_msgs_points_.back().number_of_points);
+	circular_buffer_msgs_points_.pop_back();
+	last_number_points_inserted_in_circular_buffer_ = 0;
+}
+
+
+template<typename PointT>
+void Localization<PointT>::eraseCircularBufferMsgsOutsideFusionTimeWindow(const ros::Time& msg_time) {
+	size_t number_of_points_to_erase = 0;
+	while (!circular_buffer_msgs_points_.empty() && (msg_time - circular_buffer_msgs_points_.front().time) > circular_buffer_fusion_time_window_) {
+		number_of_points_to_erase += circular_buffer_msgs_points_.front().number_of_points;
+		circular_buffer_msgs_points_.pop_front();
+	}
+
+	if (number_of_points_to_erase > 0) {
+		ambient_pointcloud_with_circular_buffer_->eraseOldest(number_of_points_to_erase);
+		ROS_DEBUG_STREAM("Erased " << number_of_points_to_erase << " points older than " << circular_buffer_fusion_time_window_.toSec() << " seconds from the circular buffer");
+	}
+}
+
+
+template<typename PointT>
+bool Localization<PointT>::checkCircularBufferFusionCoverage(const ros::Time& msg_time) {
+	std::set<std::string> msg_frame_ids_within_time_window;
+	for (size_t i = 0; i < circular_buffer_msgs_points_.size(); ++i) {
+		if (std::abs((msg_time - circular_buffer_msgs_points_[i].time).toSec()) <= circular_buffer_fusion_time_window_.toSec()) {
+			msg_frame_ids_within_time_window.insert(circular_buffer_msgs_points_[i].frame_id);
+		}
+	}
+
+	size_t number_of_topics_within_time_window = msg_frame_ids_within_time_window.size();
+	size_t minimum_number_of_topics = std::max((size_t)1, (size_t)std::ceil(circular_buffer_fusion_minimum_percentage_of_topics_ * ambient_pointcloud_subscribers_.size()));
+	if (number_of_topics_within_time_window < minimum_number_of_topics) {
+		ROS_DEBUG_STREAM("Waiting for more sensor data in the circular buffer (" << number_of_topics_within_time_window << " of the required " << minimum_number_of_topics << " topics sent msgs in the last " << circular_buffer_fusion_time_window_.toSec() << " seconds)");
+		return false;
+	}
+
+	return true;
+}
+
+
 template<typename PointT>
 void Localization<PointT>::resetPointCloudHeight(pcl::PointCloud<PointT>& pointcloud, float height) {
 	for (size_t i = 0; i < pointcloud.size(); ++i) {
@@ -2003,15 +2268,36 @@ bool Localization<PointT>::applyFilters(std::vector< typename CloudFilter<PointT
 	PerformanceTimer performance_timer;
 	performance_timer.start();
 
+	// filters that only remove points are chained using indices into pointcloud, which is only copied before filters that create new points and at the end
+	pcl::IndicesPtr pointcloud_indices;
 	for (size_t i = 0; i < cloud_filters.size(); ++i) {
-		typename pcl::PointCloud<PointT>::Ptr filtered_ambient_pointcloud(new pcl::PointCloud<PointT>());
-		filtered_ambient_pointcloud->header = pointcloud->header;
-		cloud_filters[i]->filter(pointcloud, filtered_ambient_pointcloud);
-		pointcloud = filtered_ambient_pointcloud; // switch pointers
-		if (pointcloud->size() <= (size_t)minimum_number_of_points_in_ambient_pointcloud_)
+		pcl::IndicesPtr filtered_indices;
+		if (chain_filters_using_point_indices_ && cloud_filters[i]->filterIndices(pointcloud, pointcloud_indices, filtered_indices)) {
+			pointcloud_indices = filtered_indices;
+		} else {
+			if (pointcloud_indices) {
+				typename pcl::PointCloud<PointT>::Ptr selected_pointcloud(new pcl::PointCloud<PointT>());
+				pcl::copyPointCloud(*pointcloud, *pointcloud_indices, *selected_pointcloud);
+				pointcloud = selected_pointcloud;
+				pointcloud_indices.reset();
+			}
+
+			typename pcl::PointCloud<PointT>::Ptr filtered_ambient_pointcloud(new pcl::PointCloud<PointT>());
+			filtered_ambient_pointcloud->header = pointcloud->header;
+			cloud_filters[i]->filter(pointcloud, filtered_ambient_pointcloud);
+			pointcloud = filtered_ambient_pointcloud; // switch pointers
+		}
+
+		if ((pointcloud_indices ? pointcloud_indices->size() : pointcloud->size()) <= (size_t)minimum_number_of_points_in_ambient_pointcloud_)
 			break;
 	}
 
+	if (pointcloud_indices) {
+		typename pcl::PointCloud<PointT>::Ptr filtered_ambient_pointcloud(new pcl::PointCloud<PointT>());
+		pcl::copyPointCloud(*pointcloud, *pointcloud_indices, *filtered_ambient_pointcloud);
+		pointcloud = filtered_ambient_pointcloud;
+	}
+
 	localization_times_msg_.filtering_time += performance_timer.getElapsedTimeInMilliSec();
 
 	return pointcloud->size() > (size_t)minimum_number_of_points_in_ambient_pointcloud_;
@@ -2070,19 +2356,31 @@ bool Localization<PointT>::applyNormalEstimation(typename NormalEstimator<PointT
 
 
 template<typename PointT>
-bool Localization<PointT>::applyKeypointDetection(std::vector< typename KeypointDetector<PointT>::Ptr >& keypoint_detectors, typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::search::KdTree<PointT>::Ptr& surface_search_method, typename pcl::PointCloud<PointT>::Ptr& keypoints) {
+bool Localization<PointT>::applyKeypointDetection(std::vector< typename KeypointDetector<PointT>::Ptr >& keypoint_detectors, typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::search::KdTree<PointT>::Ptr& surface_search_method, typename pcl::PointCloud<PointT>::Ptr& keypoints,
+		bool run_detectors_concurrently) {
 	PerformanceTimer performance_timer;
 	performance_timer.start();
 
 	keypoints->clear();
-	for (size_t i = 0; i < keypoint_detectors.size(); ++i) {
-		if (i == 0) {
-			keypoint_detectors[i]->findKeypoints(pointcloud, keypoints, pointcloud, surface_search_method);
+	if (keypoint_detectors.size() == 1) {
+		keypoint_detectors[0]->findKeypoints(pointcloud, keypoints, pointcloud, surface_search_method);
+	} else if (keypoint_detectors.size() > 1) {
+		std::vector< typename pcl::PointCloud<PointT>::Ptr > detectors_keypoints(keypoint_detectors.size());
+		if (run_detectors_concurrently) {
+			#pragma omp parallel for schedule(dynamic, 1) num_threads((int)keypoint_detectors.size())
+			for (int i = 0; i < (int)keypoint_detectors.size(); ++i) {
+				detectors_keypoints[i] = typename pcl::PointCloud<PointT>::Ptr(new pcl::PointCloud<PointT>());
+				// pcl keypoint detectors reset the input cloud of the search method, so each thread needs its own
+				typename pcl::search::KdTree<PointT>::Ptr detector_search_method(new pcl::search::KdTree<PointT>());
+				keypoint_detectors[i]->findKeypoints(pointcloud, detectors_keypoints[i], pointcloud, detector_search_method);
+			}
 		} else {
-			typename pcl::PointCloud<PointT>::Ptr keypoints_temp(new pcl::PointCloud<PointT>());
-			keypoint_detectors[i]->findKeypoints(pointcloud, keypoints_temp, pointcloud, surface_search_method);
-			*keypoints += *keypoints_temp;
+			for (size_t i = 0; i < keypoint_detectors.size(); ++i) {
+				detectors_keypoints[i] = typename pcl::PointCloud<PointT>::Ptr(new pcl::PointCloud<PointT>());
+				keypoint_detectors[i]->findKeypoints(pointcloud, detectors_keypoints[i], pointcloud, surface_search_method);
+			}
 		}
+		pointcloud_utils::concatenatePointClouds<PointT>(detectors_keypoints, keypoints);
 	}
 
 	localization_diagnostics_msg_.number_keypoints_ambient_pointcloud = keypoints->size();
@@ -2092,6 +2390,49 @@ bool Localization<PointT>::applyKeypointDetection(std::vector< typename Keypoint
 }
 
 
+template<typename PointT>
+bool Localization<PointT>::applyKeypointDetectionInChangedRegions(std::vector< typename KeypointDetector<PointT>::Ptr >& keypoint_detectors, typename pcl::PointCloud<PointT>::Ptr& pointcloud, typename pcl::search::KdTree<PointT>::Ptr& surface_search_method, typename pcl::PointCloud<PointT>::Ptr& keypoints,
+		bool run_detectors_concurrently) {
+	bool changed_regions_detected = reference_cloud_keypoints_changed_regions_detector_ && reference_cloud_keypoints_changed_regions_detector_->detectChangedRegions(*pointcloud);
+	if (!changed_regions_detected || keypoints->empty()) {
+		bool keypoints_detected = applyKeypointDetection(keypoint_detectors, pointcloud, surface_search_method, keypoints, run_detectors_concurrently);
+		if (reference_cloud_keypoints_changed_regions_detector_) {
+			if (keypoints_detected) {
+				reference_cloud_keypoints_changed_regions_detector_->commitChangedRegions();
+			} else {
+				reference_cloud_keypoints_changed_regions_detector_->reset();
+			}
+		}
+		return keypoints_detected;
+	}
+
+	PerformanceTimer performance_timer;
+	performance_timer.start();
+
+	typename pcl::PointCloud<PointT>::Ptr computation_region_pointcloud(new pcl::PointCloud<PointT>());
+	typename pcl::PointCloud<PointT>::Ptr computation_region_keypoints(new pcl::PointCloud<PointT>());
+	reference_cloud_keypoints_changed_regions_detector_->extractComputationRegion(*pointcloud, *computation_region_pointcloud);
+	if (!computation_region_pointcloud->empty()) {
+		typename pcl::search::KdTree<PointT>::Ptr computation_region_search_method(new pcl::search::KdTree<PointT>());
+		computation_region_search_method->setInputCloud(computation_region_pointcloud);
+		applyKeypointDetection(keypoint_detectors, computation_region_pointcloud, computation_region_search_method, computation_region_keypoints, run_detectors_concurrently);
+	}
+
+	size_t number_of_previous_keypoints = keypoints->size();
+	reference_cloud_keypoints_changed_regions_detector_->mergeResults(*keypoints, *computation_region_keypoints, *keypoints);
+	keypoints->header = pointcloud->header;
+	if (keypoints->size() > 3) {
+		reference_cloud_keypoints_changed_regions_detector_->commitChangedRegions();
+	} else {
+		reference_cloud_keypoints_changed_regions_detector_->reset();
+	}
+
+	ROS_INFO_STREAM("Recomputed the keypoints of " << reference_cloud_keypoints_changed_regions_detector_->getNumberOfAffectedVoxels() << " changed voxels (out of " << reference_cloud_keypoints_changed_regions_detector_->getNumberOfVoxels()
+			<< ") using " << computation_region_pointcloud->size() << " points, updating the " << number_of_previous_keypoints << " previous keypoints to " << keypoints->size() << " in " << performance_timer.getElapsedTimeFormated());
+	return keypoints->size() > 3;
+}
+
+
 template<typename PointT>
 bool Localization<PointT>::applyCloudRegistration(std::vector< typename CloudMatcher<PointT>::Ptr >& matchers, typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud,
 		typename pcl::search::KdTree<PointT>::Ptr& surface_search_method,
@@ -2501,12 +2842,19 @@ bool Localization<PointT>::updateLocalizationWithAmbientPointCloud(typename pcl:
 		ambient_pointcloud_with_circular_buffer_->getPointCloud().sensor_origin_ = ambient_pointcloud->sensor_origin_;
 		ambient_pointcloud_with_circular_buffer_->getPointCloud().sensor_orientation_ = ambient_pointcloud->sensor_orientation_;
 		last_number_points_inserted_in_circular_buffer_ = ambient_pointcloud->size();
+		recordCircularBufferMsgPoints(ambient_point_cloud_original_frame_id, pointcloud_time, ambient_pointcloud->size());
 		ambient_pointcloud = ambient_pointcloud_with_circular_buffer_->getPointCloudPtr();
 		ROS_DEBUG_STREAM("Ambient pointcloud with circular buffer has " << ambient_pointcloud->size() << " points");
 	}
 
 	// ==============================================================  check point cloud size
-	if (ambient_pointcloud_with_circular_buffer_ && circular_buffer_require_reception_of_pointcloud_msgs_from_all_topics_before_doing_registration_) {
+	if (ambient_pointcloud_with_circular_buffer_ && circular_buffer_fusion_time_window_.toSec() > 0.0) {
+		eraseCircularBufferMsgsOutsideFusionTimeWindow(pointcloud_time);
+		if (!checkCircularBufferFusionCoverage(pointcloud_time)) {
+			sensor_data_processing_status_ = FillingCircularBufferWithMsgsFromAllTopics;
+			return false;
+		}
+	} else if (ambient_pointcloud_with_circular_buffer_ && circular_buffer_require_reception_of_pointcloud_msgs_from_all_topics_before_doing_registration_) {
 		msg_frame_ids_with_data_in_circular_buffer_.insert(ambient_point_cloud_original_frame_id);
 		if (msg_frame_ids_with_data_in_circular_buffer_.size() < ambient_pointcloud_subscribers_.size()) {
 			ROS_DEBUG_STREAM("Added frame_id " << ambient_point_cloud_original_frame_id << " to the set containing the received frame_ids with data in the circular buffer");
@@ -2583,7 +2931,7 @@ bool Localization<PointT>::updateLocalizationWithAmbientPointCloud(typename pcl:
 	localization_times_msg_.keypoint_selection_time = 0.0;
 	bool computed_keypoints = false;
 	if (compute_keypoints_when_tracking_pose_ && !ambient_cloud_keypoint_detectors_.empty()) {
-		applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out);
+		applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out, run_ambient_cloud_keypoint_detectors_concurrently_);
 		computed_keypoints = true;
 	}
 
@@ -2619,7 +2967,7 @@ bool Localization<PointT>::updateLocalizationWithAmbientPointCloud(typename pcl:
 				}
 
 				if (!computed_keypoints && compute_keypoints_when_estimating_initial_pose_ && !ambient_cloud_keypoint_detectors_.empty()) {
-					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out);
+					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out, run_ambient_cloud_keypoint_detectors_concurrently_);
 					computed_keypoints = true;
 				}
 
@@ -2659,7 +3007,7 @@ bool Localization<PointT>::updateLocalizationWithAmbientPointCloud(typename pcl:
 				}
 
 				if (!computed_keypoints && compute_keypoints_when_recovering_pose_tracking_ && !ambient_cloud_keypoint_detectors_.empty()) {
-					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out);
+					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out, run_ambient_cloud_keypoint_detectors_concurrently_);
 					computed_keypoints = true;
 				}
 
@@ -2725,7 +3073,7 @@ bool Localization<PointT>::updateLocalizationWithAmbientPointCloud(typename pcl:
 				}
 
 				if (!computed_keypoints && compute_keypoints_when_recovering_pose_tracking_ && !ambient_cloud_keypoint_detectors_.empty()) {
-					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out);
+					applyKeypointDetection(ambient_cloud_keypoint_detectors_, ambient_pointcloud, ambient_search_method, ambient_pointcloud_keypoints_out, run_ambient_cloud_keypoint_detectors_concurrently_);
 					computed_keypoints = true;
 				}
 
@@ -11,7 +11,9 @@
 // std includes
 #include <algorithm>
 #include <cmath>
+#include <deque>
 #include <limits>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -37,6 +39,7 @@
 #include <pcl/pcl_macros.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
+#include <pcl/common/io.h>
 #include <pcl/common/transforms.h>
 #include <pcl/filters/filter.h>
 #include <pcl/io/pcd_io.h>
@@ -48,9 +51,12 @@
 #include <Eigen/Core>
 
 // project includes
+#include <dynamic_robot_localization/common/changed_regions_detector.h>
 #include <dynamic_robot_localization/common/configurable_object.h>
 #include <dynamic_robot_localization/common/impl/math_utils.hpp>
 #include <dynamic_robot_localization/common/pointcloud_conversions.h>
+#include <dynamic_robot_localization/common/pointcloud2_decoder.h>
+#include <dynamic_robot_localization/common/pointcloud_deskewer.h>
 #include <dynamic_robot_localization/common/pointcloud_utils.h>
 #include <dynamic_robot_localization/common/transformation_aligner.h>
 #include <pose_to_tf_publisher/pose_to_tf_publisher.h>
@@ -59,6 +65,7 @@
 
 #include <dynamic_robot_localization/cloud_filters/cloud_filter.h>
 #include <dynamic_robot_localization/cloud_filters/voxel_grid.h>
+#include <dynamic_robot_localization/cloud_filters/hashed_voxel_grid.h>
 #include <dynamic_robot_localization/cloud_filters/approximate_voxel_grid.h>
 #include <dynamic_robot_localization/cloud_filters/pass_through.h>
 #include <dynamic_robot_localization/cloud_filters/radius_outlier_removal.h>
@@ -92,19 +99,27 @@
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/keypoint_descriptors/esf.h>
 
 #include <dynamic_robot_localization/cloud_matchers/cloud_matcher.h>
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/branch_and_bound_2d.h>
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/correlative_scan_matcher_2d.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_2d.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_non_linear.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_with_normals.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_generalized.h>
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/iterative_closest_point_generalized_voxelized.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/normal_distributions_transform_2d.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/normal_distributions_transform_3d.h>
+#include <dynamic_robot_localization/cloud_matchers/point_matchers/normal_distributions_transform_voxel_map.h>
 #include <dynamic_robot_localization/cloud_matchers/point_matchers/principal_component_analysis.h>
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/sample_consensus_initial_alignment.h>
 #include <dynamic_robot_localization/cloud_matchers/feature_matchers/sample_consensus_initial_alignment_prerejective.h>
 
 #include <dynamic_robot_localization/transformation_validators/transformation_validator.h>
 #include <dynamic_robot_localization/transformation_validators/euclidean_transformation_validator.h>
+#include <dynamic_robot_localization/motion_predictors/motion_predictor.h>
+#include <dynamic_robot_localization/motion_predictors/constant_velocity_motion_predictor.h>
+#include <dynamic_robot_localization/motion_predictors/constant_acceleration_motion_predictor.h>
+#include <dynamic_robot_localization/motion_predictors/imu_motion_predictor.h>
 
 #include <dynamic_robot_localization/outlier_detectors/outlier_detector.h>
 #include <dynamic_robot_localization/outlier_detectors/euclidean_outlier_detector.h>
@@ -141,6 +156,13 @@ class Localization : public ConfigurableObject {
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <usings>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		using Ptr = std::shared_ptr< Localization<PointT> >;
 		using ConstPtr = std::shared_ptr< const Localization<PointT> >;
+
+		/// Number of points that each msg still has in the ambient circular buffer (in insertion order)
+		struct CircularBufferMsgPoints {
+			std::string frame_id;
+			ros::Time time;
+			size_t number_of_points;
+		};
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </usings>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <enums>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -248,6 +270,7 @@ class Localization : public ConfigurableObject {
 		virtual void setupTransformationValidatorsForTracking(const std::string& configuration_namespace);
 		virtual void setupTransformationValidatorsForTrackingRecovery(const std::string& configuration_namespace);
 		virtual void setupTransformationValidatorsConfigurations(std::vector< TransformationValidator::Ptr >& validators, const std::string& configuration_namespace);
+		virtual void setupMotionPredictorConfigurations(const std::string& configuration_namespace);
 		virtual void setupOutlierDetectorsConfigurations(const std::string& configuration_namespace);
 		virtual void setupOutlierDetectorsConfigurationsReferencePointCloud(const std::string& configuration_namespace);
 		virtual void setupOutlierDetectorsConfigurations(std::vector< typename OutlierDetector<PointT>::Ptr >& outlier_detectors, const std::string& configuration_namespace_detectors, const std::string& topics_configuration_prefix);
@@ -281,7 +304,17 @@ class Localization : public ConfigurableObject {
 		bool transformCloudToTFFrame(typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud, const ros::Time& timestamp, const std::string& target_frame_id);
 		bool checkIfAmbientPointCloudShouldBeProcessed(const ros::Time& ambient_cloud_time, size_t number_of_points, bool check_if_pointcloud_subscribers_are_active = true, bool use_ros_console = true);
 		bool checkIfTrackingIsLost();
+		/// Records the points of a msg inserted in the circular buffer, discarding the records of the oldest msgs whose points were overwritten
+		void recordCircularBufferMsgPoints(const std::string& msg_frame_id, const ros::Time& msg_time, size_t number_of_points);
+		/// Erases the points of the last processed msg from the circular buffer (and its record)
+		void eraseNewestCircularBufferMsgPoints();
+		/// Erases from the circular buffer the oldest msgs with stamps before msg_time minus the fusion time window
+		void eraseCircularBufferMsgsOutsideFusionTimeWindow(const ros::Time& msg_time);
+		/// Checks if enough topics have msgs in the circular buffer within the fusion time window of msg_time
+		bool checkCircularBufferFusionCoverage(const ros::Time& msg_time);
 		void processAmbientPointCloud(const sensor_msgs::PointCloud2ConstPtr& ambient_cloud_msg);
+		/// Moves the points of the decoded ambient_pointcloud to the sensor pose at the msg stamp (using the odom tf interpolated at the time of each point)
+		bool deskewAmbientPointCloud(const sensor_msgs::PointCloud2& ambient_cloud_msg, const ros::Time& ambient_cloud_time, bool points_times_extracted_by_decoder, pcl::PointCloud<PointT>& ambient_pointcloud);
 		bool processAmbientPointCloud(typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud, bool check_if_pointcloud_should_be_processed = true, bool check_if_pointcloud_subscribers_are_active = true);
 		void resetPointCloudHeight(pcl::PointCloud<PointT>& pointcloud, float height = 0.0f);
 
@@ -295,7 +328,12 @@ class Localization : public ConfigurableObject {
 
 		virtual bool applyKeypointDetection(std::vector< typename KeypointDetector<PointT>::Ptr >& keypoint_detectors, typename pcl::PointCloud<PointT>::Ptr& pointcloud,
 				typename pcl::search::KdTree<PointT>::Ptr& surface_search_method,
-				typename pcl::PointCloud<PointT>::Ptr& keypoints);
+				typename pcl::PointCloud<PointT>::Ptr& keypoints, bool run_detectors_concurrently = false);
+
+		/// Recomputes the keypoints only in the regions of the reference cloud that changed since the last update (falls back to applyKeypointDetection when the changes are too large)
+		virtual bool applyKeypointDetectionInChangedRegions(std::vector< typename KeypointDetector<PointT>::Ptr >& keypoint_detectors, typename pcl::PointCloud<PointT>::Ptr& pointcloud,
+				typename pcl::search::KdTree<PointT>::Ptr& surface_search_method,
+				typename pcl::PointCloud<PointT>::Ptr& keypoints, bool run_detectors_concurrently = false);
 
 		virtual bool applyCloudRegistration(std::vector< typename CloudMatcher<PointT>::Ptr >& matchers, typename pcl::PointCloud<PointT>::Ptr& ambient_pointcloud,
 				typename pcl::search::KdTree<PointT>::Ptr& surface_search_method,
@@ -385,6 +423,7 @@ class Localization : public ConfigurableObject {
 		std::string filtered_pointcloud_save_frame_id_;
 		bool filtered_pointcloud_save_frame_id_with_cloud_time_;
 		bool stop_processing_after_saving_filtered_pointcloud_;
+		bool chain_filters_using_point_indices_;
 		bool reference_pointcloud_normalize_normals_;
 		bool flip_normals_using_occupancy_grid_analysis_;
 		MapUpdateMode map_update_mode_;
@@ -396,6 +435,12 @@ class Localization : public ConfigurableObject {
 		std::string base_link_frame_id_;
 		std::string sensor_frame_id_;
 		bool override_pointcloud_timestamp_to_current_time_;
+		bool use_ambient_pointcloud_decoder_;
+		bool ambient_pointcloud_nans_removed_while_decoding_;
+		PointCloud2Decoder<PointT> ambient_pointcloud_decoder_;
+		bool use_ambient_pointcloud_deskewing_;
+		PointCloudDeskewer<PointT> ambient_pointcloud_deskewer_;
+		std::vector<double> ambient_pointcloud_points_times_;
 		ros::Duration max_seconds_ambient_pointcloud_age_;
 		ros::Duration max_seconds_ambient_pointcloud_offset_to_last_estimated_pose_;
 		ros::Duration min_seconds_between_scan_registration_;
@@ -406,6 +451,10 @@ class Localization : public ConfigurableObject {
 		ros::Duration initial_pose_estimation_timeout_;
 		int minimum_number_of_points_in_ambient_pointcloud_;
 		int minimum_number_of_points_in_reference_pointcloud_;
+		int occupancy_grid_threshold_for_map_cell_as_obstacle_;
+		bool occupancy_grid_extract_only_boundary_cells_;
+		bool occupancy_grid_compute_normals_from_occupancy_gradient_;
+		int occupancy_grid_conversion_number_of_threads_;
 		bool localization_detailed_use_millimeters_in_root_mean_square_error_inliers_;
 		bool localization_detailed_use_millimeters_in_root_mean_square_error_of_last_registration_correspondences_;
 		bool localization_detailed_use_millimeters_in_translation_corrections_;
@@ -424,6 +473,8 @@ class Localization : public ConfigurableObject {
 		bool compute_keypoints_when_tracking_pose_;
 		bool compute_keypoints_when_recovering_pose_tracking_;
 		bool compute_keypoints_when_estimating_initial_pose_;
+		bool run_reference_cloud_keypoint_detectors_concurrently_;
+		bool run_ambient_cloud_keypoint_detectors_concurrently_;
 		bool compute_inliers_angular_distribution_;
 		bool compute_outliers_angular_distribution_;
 		double inliers_angular_distribution_;
@@ -504,6 +555,9 @@ class Localization : public ConfigurableObject {
 		int minimum_number_points_ambient_pointcloud_circular_buffer_;
 		size_t last_number_points_inserted_in_circular_buffer_;
 		std::set<std::string> msg_frame_ids_with_data_in_circular_buffer_;
+		ros::Duration circular_buffer_fusion_time_window_;
+		double circular_buffer_fusion_minimum_percentage_of_topics_;
+		std::deque<CircularBufferMsgPoints> circular_buffer_msgs_points_;
 		typename pcl::search::KdTree<PointT>::Ptr reference_pointcloud_search_method_;
 		std::vector< typename CloudFilter<PointT>::Ptr > reference_cloud_filters_;
 		std::vector< typename CloudFilter<PointT>::Ptr > ambient_pointcloud_integration_filters_;
@@ -521,6 +575,7 @@ class Localization : public ConfigurableObject {
 		typename CurvatureEstimator<PointT>::Ptr ambient_cloud_curvature_estimator_;
 		std::vector< typename KeypointDetector<PointT>::Ptr > reference_cloud_keypoint_detectors_;
 		std::vector< typename KeypointDetector<PointT>::Ptr > ambient_cloud_keypoint_detectors_;
+		typename ChangedRegionsDetector<PointT>::Ptr reference_cloud_keypoints_changed_regions_detector_;
 		std::vector< typename CloudMatcher<PointT>::Ptr > initial_pose_estimators_feature_matchers_;
 		std::vector< typename CloudMatcher<PointT>::Ptr > initial_pose_estimators_point_matchers_;
 		std::vector< typename CloudMatcher<PointT>::Ptr > tracking_matchers_;
@@ -536,6 +591,7 @@ class Localization : public ConfigurableObject {
 		std::vector< TransformationValidator::Ptr > transformation_validators_initial_alignment_;
 		std::vector< TransformationValidator::Ptr > transformation_validators_;
 		std::vector< TransformationValidator::Ptr > transformation_validators_tracking_recovery_;
+		MotionPredictor::Ptr motion_predictor_;
 		std::vector< typename OutlierDetector<PointT>::Ptr > outlier_detectors_;
 		std::vector< typename OutlierDetector<PointT>::Ptr > outlier_detectors_reference_pointcloud_;
 		typename CloudAnalyzer<PointT>::Ptr cloud_analyzer_;
@@ -25,6 +25,7 @@ NormalEstimator<PointT>::NormalEstimator() :
 	occupancy_grid_analysis_k_(0),
 	occupancy_grid_analysis_radius_(-1.0),
 	occupancy_grid_analysis_radius_resolution_percentage_(4.0),
+	occupancy_grid_analysis_use_distance_transform_(false),
 	flip_normals_towards_custom_viewpoint_(false),
 	normals_viewpoint_px_(0.0f),
 	normals_viewpoint_py_(0.0f),
@@ -65,6 +66,10 @@ void NormalEstimator<PointT>::setupConfigurationFromParameterServer(ros::NodeHan
 		private_node_handle->param(final_param_name, occupancy_grid_analysis_radius_resolution_percentage_, 4.0);
 	}
 
+	if (ros::param::search(private_node_handle->getNamespace() + "/" + configuration_namespace, "occupancy_grid_analysis_use_distance_transform", final_param_name)) {
+		private_node_handle->param(final_param_name, occupancy_grid_analysis_use_distance_transform_, false);
+	}
+
 	if (ros::param::search(private_node_handle->getNamespace() + "/" + configuration_namespace, "flip_normals_towards_custom_viewpoint", final_param_name)) {
 		private_node_handle->param(final_param_name, flip_normals_towards_custom_viewpoint_, false);
 	}
@@ -114,6 +119,19 @@ void NormalEstimator<PointT>::estimateNormals(typename pcl::PointCloud<PointT>::
 }
 
 
+template<typename PointT>
+const std::vector<int>& NormalEstimator<PointT>::getOccupancyGridNearestFreeCells() {
+	if (!occupancy_grid_msg_) {
+		occupancy_grid_nearest_free_cells_.clear();
+		occupancy_grid_nearest_free_cells_msg_.reset();
+	} else if (occupancy_grid_msg_ != occupancy_grid_nearest_free_cells_msg_) {
+		pointcloud_conversions::computeOccupancyGridNearestFreeCells(*occupancy_grid_msg_, occupancy_grid_nearest_free_cells_);
+		occupancy_grid_nearest_free_cells_msg_ = occupancy_grid_msg_;
+	}
+	return occupancy_grid_nearest_free_cells_;
+}
+
+
 template<typename PointT>
 void NormalEstimator<PointT>::displayNormals(typename pcl::PointCloud<PointT>::Ptr& pointcloud_with_normals) {
 	cloud_viewer_.showPointCloud(pointcloud_with_normals, "Point cloud normals");
@@ -176,7 +176,10 @@ void NormalEstimatorSAC<PointT>::estimateNormals(typename pcl::PointCloud<PointT
 			search_radius = NormalEstimator<PointT>::getOccupancyGridAnalysisRadius();
 		}
 
-		if (search_k > 0 || search_radius > 0) {
+		if (NormalEstimator<PointT>::getOccupancyGridAnalysisUseDistanceTransform()) {
+			size_t number_normals_flipped = pointcloud_conversions::flipPointCloudNormalsUsingOccpancyGridNearestFreeCells(*(NormalEstimator<PointT>::getOccupancyGridMsg()), NormalEstimator<PointT>::getOccupancyGridNearestFreeCells(), *pointcloud_with_normals_out, (float)search_radius);
+			ROS_DEBUG_STREAM("NormalEstimatorSAC: Flipped " << number_normals_flipped << " normals using the nearest free cells of the OccupancyGrid");
+		} else if (search_k > 0 || search_radius > 0) {
 			size_t number_normals_flipped = pointcloud_conversions::flipPointCloudNormalsUsingOccpancyGrid(*(NormalEstimator<PointT>::getOccupancyGridMsg()), *pointcloud_with_normals_out, search_k, search_radius, NormalEstimator<PointT>::getDisplayOccupancyGridPointcloud());
 			ROS_DEBUG_STREAM("NormalEstimatorSAC: Flipped " << number_normals_flipped << " normals using OccupancyGrid analysis [ search_k: " << search_k << " | search_radius: " << search_radius << " ]");
 		}
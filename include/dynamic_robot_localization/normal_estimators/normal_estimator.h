@@ -11,6 +11,7 @@
 // std includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // ROS includes
 #include <ros/ros.h>
@@ -26,6 +27,7 @@
 // project includes
 #include <dynamic_robot_localization/common/configurable_object.h>
 #include <dynamic_robot_localization/common/cloud_viewer.h>
+#include <dynamic_robot_localization/common/pointcloud_conversions.h>
 #include <dynamic_robot_localization/common/pointcloud_utils.h>
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -57,6 +59,9 @@ class NormalEstimator : public ConfigurableObject {
 				typename pcl::PointCloud<PointT>::Ptr& pointcloud_with_normals_out);
 
 		void displayNormals(typename pcl::PointCloud<PointT>::Ptr& pointcloud_with_normals);
+
+		/// Nearest free cell of each cell of the occupancy grid msg (computed only when the occupancy grid msg changes)
+		const std::vector<int>& getOccupancyGridNearestFreeCells();
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </NormalEstimator-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <gets>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -65,6 +70,7 @@ class NormalEstimator : public ConfigurableObject {
 		int getOccupancyGridAnalysisK() const { return occupancy_grid_analysis_k_; }
 		double getOccupancyGridAnalysisRadius() const { return occupancy_grid_analysis_radius_; }
 		double getOccupancyGridAnalysisRadiusResolutionPercentage() const { return occupancy_grid_analysis_radius_resolution_percentage_; }
+		bool getOccupancyGridAnalysisUseDistanceTransform() const { return occupancy_grid_analysis_use_distance_transform_; }
 		nav_msgs::OccupancyGridConstPtr getOccupancyGridMsg() { return occupancy_grid_msg_; }
 		// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </gets>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -82,7 +88,10 @@ class NormalEstimator : public ConfigurableObject {
 		int occupancy_grid_analysis_k_;
 		double occupancy_grid_analysis_radius_;
 		double occupancy_grid_analysis_radius_resolution_percentage_;
+		bool occupancy_grid_analysis_use_distance_transform_;
 		nav_msgs::OccupancyGridConstPtr occupancy_grid_msg_;
+		nav_msgs::OccupancyGridConstPtr occupancy_grid_nearest_free_cells_msg_;
+		std::vector<int> occupancy_grid_nearest_free_cells_;
 		bool flip_normals_towards_custom_viewpoint_;
 		float normals_viewpoint_px_;
 		float normals_viewpoint_py_;
@@ -21,6 +21,15 @@ PCL_INSTANTIATE(DRLSIFT3D, DRL_POINT_TYPES)
 
 
 namespace pcl {
+template<>
+struct SIFTKeypointFieldSelector<PointNormal> {
+	inline float
+	operator() (const PointNormal & p) const {
+		return p.curvature;
+	}
+};
+
+
 template<>
 struct SIFTKeypointFieldSelector<PointXYZINormal> {
 	inline float
@@ -88,6 +88,48 @@ void getRollPitchYawFromMatrixUsigTF2(const Eigen::Matrix4f& matrix, double& rol
 	transform.setFromOpenGLMatrix(doubleMatrix.data());
 	transform.getBasis().getRPY(roll_out, pitch_out, yaw_out);
 }
+
+
+bool applyGaussNewtonPoseUpdate(const Eigen::Matrix<double, 6, 6>& hessian, const Eigen::Matrix<double, 6, 1>& gradient, double maximum_step_length, bool estimate_2d_pose,
+		double transformation_epsilon, double transformation_rotation_epsilon, Eigen::Matrix4d& transformation, bool& converged_out) {
+	converged_out = false;
+	Eigen::Matrix<double, 6, 1> delta = Eigen::Matrix<double, 6, 1>::Zero();
+	if (estimate_2d_pose) {
+		const int pose_2d_indices[3] = { 0, 1, 5 };
+		Eigen::Matrix3d hessian_2d;
+		Eigen::Vector3d gradient_2d;
+		for (int row = 0; row < 3; ++row) {
+			gradient_2d(row) = gradient(pose_2d_indices[row]);
+			for (int col = 0; col < 3; ++col) {
+				hessian_2d(row, col) = hessian(pose_2d_indices[row], pose_2d_indices[col]);
+			}
+		}
+		Eigen::Vector3d delta_2d = -hessian_2d.ldlt().solve(gradient_2d);
+		for (int i = 0; i < 3; ++i) { delta(pose_2d_indices[i]) = delta_2d(i); }
+	} else {
+		delta = -hessian.ldlt().solve(gradient);
+	}
+
+	if (!delta.allFinite()) { return false; }
+
+	double delta_norm = delta.norm();
+	if (maximum_step_length > 0.0 && delta_norm > maximum_step_length) {
+		delta *= maximum_step_length / delta_norm;
+	}
+
+	Eigen::Vector3d rotation_delta = delta.tail<3>();
+	double rotation_delta_angle = rotation_delta.norm();
+	Eigen::Matrix3d rotation_update = (rotation_delta_angle > 0.0 ? Eigen::AngleAxisd(rotation_delta_angle, rotation_delta / rotation_delta_angle).toRotationMatrix() : Eigen::Matrix3d::Identity());
+	transformation.block<3, 3>(0, 0) = rotation_update * transformation.block<3, 3>(0, 0);
+	transformation.block<3, 1>(0, 3) = rotation_update * transformation.block<3, 1>(0, 3) + delta.head<3>();
+
+	bool translation_converged = delta.head<3>().squaredNorm() < transformation_epsilon;
+	bool rotation_converged = (transformation_rotation_epsilon > 0.0 ?
+			std::cos(rotation_delta_angle) >= transformation_rotation_epsilon :
+			rotation_delta_angle * rotation_delta_angle < transformation_epsilon);
+	converged_out = translation_converged && rotation_converged;
+	return true;
+}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </math_utils-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
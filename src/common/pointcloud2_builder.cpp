@@ -6,9 +6,26 @@
  */
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-#include <dynamic_robot_localization/common/pointcloud2_builder.h>
+#include <dynamic_robot_localization/common/common.h>
+#include <dynamic_robot_localization/common/impl/pointcloud2_builder.hpp>
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#ifndef DRL_NO_PRECOMPILE
+#include <pcl/impl/instantiate.hpp>
+#include <pcl/point_types.h>
+#define PCL_INSTANTIATE_DRLPointCloud2BuilderCreateNewCloudWithPointTypeLayout(T) template void dynamic_robot_localization::PointCloud2Builder::createNewCloudWithPointTypeLayout<T>(std::string, size_t);
+PCL_INSTANTIATE(DRLPointCloud2BuilderCreateNewCloudWithPointTypeLayout, DRL_POINT_TYPES)
+
+#define PCL_INSTANTIATE_DRLPointCloud2BuilderAddPoints(T) template void dynamic_robot_localization::PointCloud2Builder::addPoints<T>(const pcl::PointCloud<T>&, int);
+PCL_INSTANTIATE(DRLPointCloud2BuilderAddPoints, DRL_POINT_TYPES)
+
+#define PCL_INSTANTIATE_DRLPointCloud2BuilderIsFieldsLayoutEqualToPointType(T) template bool dynamic_robot_localization::PointCloud2Builder::isFieldsLayoutEqualToPointType<T>() const;
+PCL_INSTANTIATE(DRLPointCloud2BuilderIsFieldsLayoutEqualToPointType, DRL_POINT_TYPES)
+#endif
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
 namespace dynamic_robot_localization {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -16,7 +33,7 @@ namespace dynamic_robot_localization {
 
 // =============================================================================  <public-section>  ============================================================================
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-PointCloud2Builder::PointCloud2Builder() : number_points_in_pointcloud_(0) {
+PointCloud2Builder::PointCloud2Builder() : number_points_in_pointcloud_(0), number_reserved_points_(32) {
 	createNewCloud("");
 }
 
@@ -25,39 +42,117 @@ PointCloud2Builder::~PointCloud2Builder() {}
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <PointCloud2Builder-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 void PointCloud2Builder::createNewCloud(std::string frame_id, size_t number_reserved_points) {
-	pointcloud_msg_ = sensor_msgs::PointCloud2Ptr(new sensor_msgs::PointCloud2());
-	pointcloud_msg_->header.frame_id = frame_id;
-	pointcloud_msg_->height = 1;
-	pointcloud_msg_->width = 0;
-	pointcloud_msg_->fields.clear();
-	pointcloud_msg_->fields.resize(3);
-	pointcloud_msg_->fields[0].name = "x";
-	pointcloud_msg_->fields[0].offset = 0;
-	pointcloud_msg_->fields[0].datatype = sensor_msgs::PointField::FLOAT32;
-	pointcloud_msg_->fields[0].count = 1;
-	pointcloud_msg_->fields[1].name = "y";
-	pointcloud_msg_->fields[1].offset = 4;
-	pointcloud_msg_->fields[1].datatype = sensor_msgs::PointField::FLOAT32;
-	pointcloud_msg_->fields[1].count = 1;
-	pointcloud_msg_->fields[2].name = "z";
-	pointcloud_msg_->fields[2].offset = 8;
-	pointcloud_msg_->fields[2].datatype = sensor_msgs::PointField::FLOAT32;
-	pointcloud_msg_->fields[2].count = 1;
-	pointcloud_msg_->point_step = 12;
-	pointcloud_msg_->data.reserve(number_reserved_points * pointcloud_msg_->point_step); // reserve memory to avoid reallocations
-	number_points_in_pointcloud_ = 0;
+	number_reserved_points_ = number_reserved_points;
+	resetPointcloudMsg(frame_id);
+	addField("x", sensor_msgs::PointField::FLOAT32);
+	addField("y", sensor_msgs::PointField::FLOAT32);
+	addField("z", sensor_msgs::PointField::FLOAT32);
+}
+
+
+int PointCloud2Builder::addField(const std::string& name, std::uint8_t datatype, std::uint32_t count) {
+	if (number_points_in_pointcloud_ > 0 || getDatatypeSize(datatype) == 0) { return -1; }
+
+	sensor_msgs::PointField field;
+	field.name = name;
+	field.offset = pointcloud_msg_->point_step;
+	field.datatype = datatype;
+	field.count = count;
+	pointcloud_msg_->fields.push_back(field);
+	pointcloud_msg_->point_step += getDatatypeSize(datatype) * count;
+	pointcloud_msg_->data.reserve(number_reserved_points_ * pointcloud_msg_->point_step); // reserve memory to avoid reallocations
+	return (int)pointcloud_msg_->fields.size() - 1;
+}
+
+
+void PointCloud2Builder::addNormalFields() {
+	addField("normal_x", sensor_msgs::PointField::FLOAT32);
+	addField("normal_y", sensor_msgs::PointField::FLOAT32);
+	addField("normal_z", sensor_msgs::PointField::FLOAT32);
+}
+
+
+void PointCloud2Builder::addRGBField() {
+	addField("rgb", sensor_msgs::PointField::FLOAT32);
+}
+
+
+void PointCloud2Builder::addIntensityField() {
+	addField("intensity", sensor_msgs::PointField::FLOAT32);
+}
+
+
+void PointCloud2Builder::addCurvatureField() {
+	addField("curvature", sensor_msgs::PointField::FLOAT32);
+}
+
+
+int PointCloud2Builder::getFieldIndex(const std::string& name) const {
+	for (size_t i = 0; i < pointcloud_msg_->fields.size(); ++i) {
+		if (pointcloud_msg_->fields[i].name == name) { return (int)i; }
+	}
+	return -1;
 }
 
 
 void PointCloud2Builder::addNewPoint(float x, float y, float z) {
-	float point_data[3];
-	point_data[0] = x;
-	point_data[1] = y;
-	point_data[2] = z;
-	unsigned char* point_data_bytes = (unsigned char*)(&point_data[0]);
-	pointcloud_msg_->data.insert(pointcloud_msg_->data.end(), &point_data_bytes[0], &point_data_bytes[3 * sizeof(float)]);
-
-	++number_points_in_pointcloud_;
+	std::uint8_t* point_data = addPoints(1);
+	std::memcpy(point_data + pointcloud_msg_->fields[0].offset, &x, sizeof(float));
+	std::memcpy(point_data + pointcloud_msg_->fields[1].offset, &y, sizeof(float));
+	std::memcpy(point_data + pointcloud_msg_->fields[2].offset, &z, sizeof(float));
+}
+
+
+std::uint8_t* PointCloud2Builder::addPoints(size_t number_of_points) {
+	size_t first_new_point_byte = number_points_in_pointcloud_ * pointcloud_msg_->point_step;
+	number_points_in_pointcloud_ += number_of_points;
+	pointcloud_msg_->data.resize(number_points_in_pointcloud_ * pointcloud_msg_->point_step, 0);
+	return pointcloud_msg_->data.data() + first_new_point_byte;
+}
+
+
+size_t PointCloud2Builder::getDatatypeSize(std::uint8_t datatype) {
+	switch (datatype) {
+		case sensor_msgs::PointField::INT8:
+		case sensor_msgs::PointField::UINT8: return 1;
+		case sensor_msgs::PointField::INT16:
+		case sensor_msgs::PointField::UINT16: return 2;
+		case sensor_msgs::PointField::INT32:
+		case sensor_msgs::PointField::UINT32:
+		case sensor_msgs::PointField::FLOAT32: return 4;
+		case sensor_msgs::PointField::FLOAT64: return 8;
+		default: return 0;
+	}
+}
+
+
+double PointCloud2Builder::readValue(const std::uint8_t* data, std::uint8_t datatype) {
+	switch (datatype) {
+		case sensor_msgs::PointField::INT8: { std::int8_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::UINT8: { std::uint8_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::INT16: { std::int16_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::UINT16: { std::uint16_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::INT32: { std::int32_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::UINT32: { std::uint32_t value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::FLOAT32: { float value; std::memcpy(&value, data, sizeof(value)); return value; }
+		case sensor_msgs::PointField::FLOAT64: { double value; std::memcpy(&value, data, sizeof(value)); return value; }
+		default: return std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+
+void PointCloud2Builder::writeValue(std::uint8_t* data, std::uint8_t datatype, double value) {
+	switch (datatype) {
+		case sensor_msgs::PointField::INT8: { std::int8_t converted_value = (std::int8_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::UINT8: { std::uint8_t converted_value = (std::uint8_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::INT16: { std::int16_t converted_value = (std::int16_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::UINT16: { std::uint16_t converted_value = (std::uint16_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::INT32: { std::int32_t converted_value = (std::int32_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::UINT32: { std::uint32_t converted_value = (std::uint32_t)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::FLOAT32: { float converted_value = (float)value; std::memcpy(data, &converted_value, sizeof(converted_value)); break; }
+		case sensor_msgs::PointField::FLOAT64: { std::memcpy(data, &value, sizeof(value)); break; }
+		default: break;
+	}
 }
 
 
@@ -73,13 +168,20 @@ sensor_msgs::PointCloud2Ptr PointCloud2Builder::getPointcloudMsg() {
 // =============================================================================  </public-section>  ===========================================================================
 
 // =============================================================================   <protected-section>   =======================================================================
+void PointCloud2Builder::resetPointcloudMsg(const std::string& frame_id) {
+	pointcloud_msg_ = sensor_msgs::PointCloud2Ptr(new sensor_msgs::PointCloud2());
+	pointcloud_msg_->header.frame_id = frame_id;
+	pointcloud_msg_->height = 1;
+	pointcloud_msg_->width = 0;
+	pointcloud_msg_->is_bigendian = false;
+	pointcloud_msg_->is_dense = true;
+	pointcloud_msg_->point_step = 0;
+	number_points_in_pointcloud_ = 0;
+}
 // =============================================================================   </protected-section>  =======================================================================
 
 // =============================================================================   <private-section>   =========================================================================
 // =============================================================================   </private-section>  =========================================================================
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <template instantiations>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-
 } /* namespace dynamic_robot_localization */
 
@@ -16,24 +16,42 @@
 #include <pcl/impl/instantiate.hpp>
 #include <pcl/point_types.h>
 
-#define PCL_INSTANTIATE_DRLPointcloudConversionsFromROSMsg(T) template bool dynamic_robot_localization::pointcloud_conversions::fromROSMsg<T>(const nav_msgs::OccupancyGrid&, pcl::PointCloud<T>&, dynamic_robot_localization::pointcloud_conversions::OccupancyGridValuesPtr, int);
+#define PCL_INSTANTIATE_DRLPointcloudConversionsFromROSMsg(T) template bool dynamic_robot_localization::pointcloud_conversions::fromROSMsg<T>(const nav_msgs::OccupancyGrid&, pcl::PointCloud<T>&, dynamic_robot_localization::pointcloud_conversions::OccupancyGridValuesPtr, int, bool, bool, int);
 PCL_INSTANTIATE(DRLPointcloudConversionsFromROSMsg, DRL_POINT_TYPES)
 
 #define PCL_INSTANTIATE_DRLPointcloudConversionsFlipPointCloudNormalsUsingOccpancyGrid(T) template size_t dynamic_robot_localization::pointcloud_conversions::flipPointCloudNormalsUsingOccpancyGrid<T>(const nav_msgs::OccupancyGrid&, pcl::PointCloud<T>&, int, float, bool);
 PCL_INSTANTIATE(DRLPointcloudConversionsFlipPointCloudNormalsUsingOccpancyGrid, DRL_POINT_TYPES)
 
+#define PCL_INSTANTIATE_DRLPointcloudConversionsFlipPointCloudNormalsUsingOccpancyGridNearestFreeCells(T) template size_t dynamic_robot_localization::pointcloud_conversions::flipPointCloudNormalsUsingOccpancyGridNearestFreeCells<T>(const nav_msgs::OccupancyGrid&, const std::vector<int>&, pcl::PointCloud<T>&, float, int);
+PCL_INSTANTIATE(DRLPointcloudConversionsFlipPointCloudNormalsUsingOccpancyGridNearestFreeCells, DRL_POINT_TYPES)
+
+#define PCL_INSTANTIATE_DRLPointcloudConversionsComputePointCloudSignature(T) template std::uint64_t dynamic_robot_localization::pointcloud_conversions::computePointCloudSignature<T>(const pcl::PointCloud<T>&);
+PCL_INSTANTIATE(DRLPointcloudConversionsComputePointCloudSignature, DRL_POINT_TYPES)
+
+#define PCL_INSTANTIATE_DRLPointcloudConversionsFromDescriptorsCacheFile(T) template bool dynamic_robot_localization::pointcloud_conversions::fromDescriptorsCacheFile<T>(pcl::PointCloud<T>&, const std::string&, const dynamic_robot_localization::pointcloud_conversions::DescriptorsCacheSignature&);
+PCL_INSTANTIATE(DRLPointcloudConversionsFromDescriptorsCacheFile, DRL_DESCRIPTOR_TYPES)
+
+#define PCL_INSTANTIATE_DRLPointcloudConversionsToDescriptorsCacheFile(T) template bool dynamic_robot_localization::pointcloud_conversions::toDescriptorsCacheFile<T>(const std::string&, const pcl::PointCloud<T>&, const dynamic_robot_localization::pointcloud_conversions::DescriptorsCacheSignature&);
+PCL_INSTANTIATE(DRLPointcloudConversionsToDescriptorsCacheFile, DRL_DESCRIPTOR_TYPES)
+
 #define PCL_INSTANTIATE_DRLPointcloudConversionsFromFile(T) template bool dynamic_robot_localization::pointcloud_conversions::fromFile< pcl::PointCloud<T> >(pcl::PointCloud<T>&, const std::string&, const std::string&);
 PCL_INSTANTIATE(DRLPointcloudConversionsFromFile, DRL_POINT_TYPES)
 PCL_INSTANTIATE(DRLPointcloudConversionsFromFile, DRL_DESCRIPTOR_TYPES)
 
 #define PCL_INSTANTIATE_DRLPointcloudConversionsToFile(T) template bool dynamic_robot_localization::pointcloud_conversions::toFile< pcl::PointCloud<T> >(const std::string&, const pcl::PointCloud<T>&, bool, const std::string&);
 PCL_INSTANTIATE(DRLPointcloudConversionsToFile, DRL_POINT_TYPES)
+PCL_INSTANTIATE(DRLPointcloudConversionsToFile, DRL_DESCRIPTOR_TYPES)
 #endif
 
 
 namespace dynamic_robot_localization {
 namespace pointcloud_conversions {
 
+const char BINARY_POINTCLOUD_FILE_MAGIC[8] = { 'D', 'R', 'L', 'C', 'L', 'O', 'U', 'D' };
+const std::string BINARY_POINTCLOUD_FILE_EXTENSION = "drlc";
+const char DESCRIPTORS_CACHE_FILE_MAGIC[8] = { 'D', 'R', 'L', 'D', 'E', 'S', 'C', 'R' };
+const std::string DESCRIPTORS_CACHE_FILE_EXTENSION = "drld";
+
 
 template<>
 bool fromFile(pcl::PCLPointCloud2& pointcloud, const std::string& filename, const std::string& folder) {
@@ -58,6 +76,96 @@ bool fromFile(pcl::PCLPointCloud2& pointcloud, const std::string& filename, cons
 }
 
 
+std::uint64_t computeHash(const void* data, size_t number_of_bytes, std::uint64_t hash) {
+	const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+	for (size_t i = 0; i < number_of_bytes; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+
+void computeOccupancyGridNearestFreeCells(const nav_msgs::OccupancyGrid& occupancy_grid, std::vector<int>& nearest_free_cells, int number_of_threads) {
+	int map_width = (int)occupancy_grid.info.width;
+	int map_height = (int)occupancy_grid.info.height;
+	size_t number_of_cells = (size_t)map_width * map_height;
+	nearest_free_cells.clear();
+	if (number_of_cells == 0 || occupancy_grid.data.size() != number_of_cells) { return; }
+	nearest_free_cells.resize(number_of_cells, -1);
+	if (number_of_threads <= 0) {
+#ifdef _OPENMP
+		number_of_threads = omp_get_max_threads();
+#else
+		number_of_threads = 1;
+#endif
+	}
+
+	// first pass -> nearest free cell in the same column
+	std::vector<int> columns_nearest_free_y(number_of_cells, -1);
+	#pragma omp parallel for schedule(static) num_threads(number_of_threads)
+	for (int x = 0; x < map_width; ++x) {
+		int last_free_y = -1;
+		for (int y = 0; y < map_height; ++y) {
+			if (occupancy_grid.data[(size_t)y * map_width + x] == 0) { last_free_y = y; }
+			columns_nearest_free_y[(size_t)y * map_width + x] = last_free_y;
+		}
+
+		last_free_y = -1;
+		for (int y = map_height - 1; y >= 0; --y) {
+			size_t cell = (size_t)y * map_width + x;
+			if (occupancy_grid.data[cell] == 0) { last_free_y = y; }
+			if (last_free_y >= 0 && (columns_nearest_free_y[cell] < 0 || (last_free_y - y) < (y - columns_nearest_free_y[cell]))) {
+				columns_nearest_free_y[cell] = last_free_y;
+			}
+		}
+	}
+
+	// second pass -> lower envelope of the parabolas centered in each column of the row (Felzenszwalb and Huttenlocher distance transform)
+	#pragma omp parallel num_threads(number_of_threads)
+	{
+		std::vector<double> squared_distances_in_column(map_width);
+		std::vector<int> envelope_parabolas(map_width);
+		std::vector<double> envelope_boundaries(map_width + 1);
+
+		#pragma omp for schedule(static)
+		for (int y = 0; y < map_height; ++y) {
+			int number_of_parabolas = 0;
+			for (int x = 0; x < map_width; ++x) {
+				int nearest_free_y = columns_nearest_free_y[(size_t)y * map_width + x];
+				if (nearest_free_y < 0) { squared_distances_in_column[x] = -1.0; continue; }
+				squared_distances_in_column[x] = (double)(y - nearest_free_y) * (double)(y - nearest_free_y);
+
+				double parabola_intersection = -std::numeric_limits<double>::max();
+				while (number_of_parabolas > 0) {
+					int previous_x = envelope_parabolas[number_of_parabolas - 1];
+					parabola_intersection = ((squared_distances_in_column[x] + (double)x * x) - (squared_distances_in_column[previous_x] + (double)previous_x * previous_x)) / (2.0 * (x - previous_x));
+					if (parabola_intersection <= envelope_boundaries[number_of_parabolas - 1]) {
+						--number_of_parabolas;
+					} else {
+						break;
+					}
+				}
+
+				envelope_parabolas[number_of_parabolas] = x;
+				envelope_boundaries[number_of_parabolas] = (number_of_parabolas == 0) ? -std::numeric_limits<double>::max() : parabola_intersection;
+				++number_of_parabolas;
+			}
+
+			if (number_of_parabolas == 0) { continue; }
+			envelope_boundaries[number_of_parabolas] = std::numeric_limits<double>::max();
+
+			int parabola = 0;
+			for (int x = 0; x < map_width; ++x) {
+				while (envelope_boundaries[parabola + 1] < x) { ++parabola; }
+				int nearest_x = envelope_parabolas[parabola];
+				nearest_free_cells[(size_t)y * map_width + x] = columns_nearest_free_y[(size_t)y * map_width + nearest_x] * map_width + nearest_x;
+			}
+		}
+	}
+}
+
+
 }
 }
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </template instantiations>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -16,7 +16,7 @@
 #include <pcl/impl/instantiate.hpp>
 #include <pcl/point_types.h>
 
-#define PCL_INSTANTIATE_DRLPointCloudUtilsConcatenatePointClouds(T) template void dynamic_robot_localization::pointcloud_utils::concatenatePointClouds<T>(const std::vector< typename pcl::PointCloud<T>::Ptr >&, typename pcl::PointCloud<T>::Ptr&);
+#define PCL_INSTANTIATE_DRLPointCloudUtilsConcatenatePointClouds(T) template void dynamic_robot_localization::pointcloud_utils::concatenatePointClouds<T>(const std::vector< typename pcl::PointCloud<T>::Ptr >&, typename pcl::PointCloud<T>::Ptr&, std::vector<size_t>*, int);
 PCL_INSTANTIATE(DRLPointCloudUtilsConcatenatePointClouds, DRL_POINT_TYPES)
 
 #define PCL_INSTANTIATE_DRLPointCloudUtilsColorizePointCloudWithCurvature(T) template void dynamic_robot_localization::pointcloud_utils::colorizePointCloudWithCurvature<T>(pcl::PointCloud<T>&);
@@ -37,6 +37,19 @@ PCL_INSTANTIATE(DRLPointCloudUtilsDistanceSquaredToOrigin, DRL_POINT_TYPES)
 namespace dynamic_robot_localization {
 namespace pointcloud_utils {
 
+void extractPointCloudClustersIndices(const std::vector<pcl::PointIndices>& cluster_indices, const std::vector<size_t>& selected_clusters, pcl::Indices& indices_out) {
+	size_t number_of_indices = 0;
+	for (size_t cluster_index = 0; cluster_index < selected_clusters.size(); ++cluster_index) {
+		number_of_indices += cluster_indices[selected_clusters[cluster_index]].indices.size();
+	}
+
+	indices_out.reserve(indices_out.size() + number_of_indices);
+	for (size_t cluster_index = 0; cluster_index < selected_clusters.size(); ++cluster_index) {
+		const pcl::Indices& indices = cluster_indices[selected_clusters[cluster_index]].indices;
+		indices_out.insert(indices_out.end(), indices.begin(), indices.end());
+	}
+}
+
 std::string getFileExtension(const std::string& filename) {
 	std::string extension;
 	if (!filename.empty()) {
@@ -32,24 +32,31 @@ int main(int argc, char** argv) {
 	std::string localization_point_type;
 	private_node_handle->param("localization_point_type", localization_point_type, std::string("PointXYZRGBNormal"));
 
-	// Note: Given that PointXYZRGBNormal is the most common used point cloud type, the other 2 were disabled to speedup compilation
-	// For enabling them, update DRL_POINT_TYPES in common/common.h and uncomment the lines below
-	//if (localization_point_type == "PointXYZRGBNormal") {
-		ROS_INFO("Localization system using PointXYZRGBNormal point type");
-		dynamic_robot_localization::Localization<pcl::PointXYZRGBNormal> localization;
+	// Note: Given that PointXYZRGBNormal is the most common used point cloud type, the other 2 are only compiled with the cmake option DRL_COMPILE_ALL_POINT_TYPES
+#ifdef DRL_COMPILE_ALL_POINT_TYPES
+	if (localization_point_type == "PointNormal") {
+		ROS_INFO("Localization system using PointNormal point type");
+		dynamic_robot_localization::Localization<pcl::PointNormal> localization;
 		localization.setupConfigurationFromParameterServer(node_handle, private_node_handle);
 		localization.startLocalization();
-	/*} else if (localization_point_type == "PointXYZINormal") {
+		return 0;
+	} else if (localization_point_type == "PointXYZINormal") {
 		ROS_INFO("Localization system using PointXYZINormal point type");
 		dynamic_robot_localization::Localization<pcl::PointXYZINormal> localization;
 		localization.setupConfigurationFromParameterServer(node_handle, private_node_handle);
 		localization.startLocalization();
-	} else {
-		ROS_INFO("Localization system using PointNormal point type");
-		dynamic_robot_localization::Localization<pcl::PointNormal> localization;
-		localization.setupConfigurationFromParameterServer(node_handle, private_node_handle);
-		localization.startLocalization();
-	}*/
+		return 0;
+	}
+#else
+	if (localization_point_type != "PointXYZRGBNormal") {
+		ROS_WARN_STREAM("Localization point type " << localization_point_type << " requires compiling with the cmake option DRL_COMPILE_ALL_POINT_TYPES (using PointXYZRGBNormal)");
+	}
+#endif
+
+	ROS_INFO("Localization system using PointXYZRGBNormal point type");
+	dynamic_robot_localization::Localization<pcl::PointXYZRGBNormal> localization;
+	localization.setupConfigurationFromParameterServer(node_handle, private_node_handle);
+	localization.startLocalization();
 
 	return 0;
 }
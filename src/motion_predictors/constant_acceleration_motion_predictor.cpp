@@ -0,0 +1,156 @@
+/**\file constant_acceleration_motion_predictor.cpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/motion_predictors/constant_acceleration_motion_predictor.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+ConstantAccelerationMotionPredictor::ConstantAccelerationMotionPredictor() :
+		filter_initialized_(false),
+		position_measurement_standard_deviation_(0.02),
+		orientation_measurement_standard_deviation_(0.02),
+		position_jerk_spectral_density_(1.0),
+		orientation_jerk_spectral_density_(1.0),
+		initial_velocity_standard_deviation_(1.0),
+		initial_acceleration_standard_deviation_(1.0) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <ConstantAccelerationMotionPredictor-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+void ConstantAccelerationMotionPredictor::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	MotionPredictor::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	private_node_handle->param(configuration_namespace + "position_measurement_standard_deviation", position_measurement_standard_deviation_, 0.02);
+	private_node_handle->param(configuration_namespace + "orientation_measurement_standard_deviation", orientation_measurement_standard_deviation_, 0.02);
+	private_node_handle->param(configuration_namespace + "position_jerk_spectral_density", position_jerk_spectral_density_, 1.0);
+	private_node_handle->param(configuration_namespace + "orientation_jerk_spectral_density", orientation_jerk_spectral_density_, 1.0);
+	private_node_handle->param(configuration_namespace + "initial_velocity_standard_deviation", initial_velocity_standard_deviation_, 1.0);
+	private_node_handle->param(configuration_namespace + "initial_acceleration_standard_deviation", initial_acceleration_standard_deviation_, 1.0);
+}
+
+
+void ConstantAccelerationMotionPredictor::reset() {
+	MotionPredictor::reset();
+	filter_initialized_ = false;
+}
+
+
+void ConstantAccelerationMotionPredictor::addPose(const tf2::Transform& pose, const ros::Time& time) {
+	if (filter_initialized_ && time <= filter_time_) {
+		MotionPredictor::addPose(pose, time);
+		return;
+	}
+
+	double pose_components[6];
+	convertTransformToPoseComponents(pose, pose_components);
+
+	if (!filter_initialized_) {
+		for (size_t i = 0; i < 6; ++i) {
+			double measurement_standard_deviation = (i < 3 ? position_measurement_standard_deviation_ : orientation_measurement_standard_deviation_);
+			components_states_[i] << pose_components[i], 0.0, 0.0;
+			components_covariances_[i].setZero();
+			components_covariances_[i].diagonal() << measurement_standard_deviation * measurement_standard_deviation, initial_velocity_standard_deviation_ * initial_velocity_standard_deviation_, initial_acceleration_standard_deviation_ * initial_acceleration_standard_deviation_;
+		}
+		filter_initialized_ = true;
+	} else {
+		double time_step = (time - filter_time_).toSec();
+		for (size_t i = 0; i < 6; ++i) {
+			bool angular_component = (i >= 3);
+			double measurement_standard_deviation = (angular_component ? orientation_measurement_standard_deviation_ : position_measurement_standard_deviation_);
+			posePrediction(time_step, (angular_component ? orientation_jerk_spectral_density_ : position_jerk_spectral_density_), components_states_[i], components_covariances_[i]);
+			double measurement_innovation = pose_components[i] - components_states_[i](0);
+			if (angular_component) {
+				measurement_innovation = angles::normalize_angle(measurement_innovation);
+			}
+			poseUpdate(measurement_innovation, measurement_standard_deviation * measurement_standard_deviation, components_states_[i], components_covariances_[i]);
+			if (angular_component) {
+				components_states_[i](0) = angles::normalize_angle(components_states_[i](0));
+			}
+		}
+	}
+
+	filter_time_ = time;
+	MotionPredictor::addPose(pose, time);
+}
+
+
+bool ConstantAccelerationMotionPredictor::computePosePrediction(const ros::Time& time, tf2::Transform& predicted_pose_out, PoseCovariance& predicted_pose_covariance_out) {
+	if (!filter_initialized_ || poses_history_.size() < 2) { return false; }
+
+	double time_step = std::max((time - filter_time_).toSec(), 0.0);
+	double predicted_pose_components[6];
+	predicted_pose_covariance_out.setZero();
+	for (size_t i = 0; i < 6; ++i) {
+		ComponentState state = components_states_[i];
+		ComponentCovariance covariance = components_covariances_[i];
+		posePrediction(time_step, (i < 3 ? position_jerk_spectral_density_ : orientation_jerk_spectral_density_), state, covariance);
+		predicted_pose_components[i] = state(0);
+		predicted_pose_covariance_out(i, i) = covariance(0, 0);
+	}
+
+	tf2::Quaternion predicted_orientation;
+	predicted_orientation.setRPY(predicted_pose_components[3], predicted_pose_components[4], predicted_pose_components[5]);
+	predicted_pose_out.setOrigin(tf2::Vector3(predicted_pose_components[0], predicted_pose_components[1], predicted_pose_components[2]));
+	predicted_pose_out.setRotation(predicted_orientation.normalize());
+	return true;
+}
+
+
+void ConstantAccelerationMotionPredictor::posePrediction(double time_step, double jerk_spectral_density, ComponentState& state_in_out, ComponentCovariance& covariance_in_out) {
+	if (time_step <= 0.0) { return; }
+
+	double time_step_2 = time_step * time_step;
+	double time_step_3 = time_step_2 * time_step;
+	double time_step_4 = time_step_3 * time_step;
+	double time_step_5 = time_step_4 * time_step;
+
+	ComponentCovariance state_transition;
+	state_transition << 1.0, time_step, 0.5 * time_step_2,
+	                    0.0, 1.0,       time_step,
+	                    0.0, 0.0,       1.0;
+
+	// white noise jerk model
+	ComponentCovariance process_noise;
+	process_noise << time_step_5 / 20.0, time_step_4 / 8.0, time_step_3 / 6.0,
+	                 time_step_4 / 8.0,  time_step_3 / 3.0, time_step_2 / 2.0,
+	                 time_step_3 / 6.0,  time_step_2 / 2.0, time_step;
+	process_noise *= jerk_spectral_density;
+
+	state_in_out = state_transition * state_in_out;
+	covariance_in_out = state_transition * covariance_in_out * state_transition.transpose() + process_noise;
+}
+
+
+void ConstantAccelerationMotionPredictor::poseUpdate(double measurement_innovation, double measurement_variance, ComponentState& state_in_out, ComponentCovariance& covariance_in_out) {
+	double innovation_variance = covariance_in_out(0, 0) + measurement_variance;
+	if (innovation_variance <= 0.0) { return; }
+
+	ComponentState kalman_gain = covariance_in_out.col(0) / innovation_variance;
+	state_in_out += kalman_gain * measurement_innovation;
+	covariance_in_out -= kalman_gain * covariance_in_out.row(0);
+	covariance_in_out = 0.5 * (covariance_in_out + covariance_in_out.transpose()); // keep the covariance symmetric
+}
+
+
+void ConstantAccelerationMotionPredictor::convertTransformToPoseComponents(const tf2::Transform& transform, double pose_components_out[6]) {
+	pose_components_out[0] = transform.getOrigin().getX();
+	pose_components_out[1] = transform.getOrigin().getY();
+	pose_components_out[2] = transform.getOrigin().getZ();
+	tf2::Matrix3x3(transform.getRotation().normalize()).getRPY(pose_components_out[3], pose_components_out[4], pose_components_out[5]);
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </ConstantAccelerationMotionPredictor-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,92 @@
+/**\file constant_velocity_motion_predictor.cpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/motion_predictors/constant_velocity_motion_predictor.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+ConstantVelocityMotionPredictor::ConstantVelocityMotionPredictor() :
+		number_of_poses_for_velocity_estimation_(2),
+		minimum_time_between_poses_for_velocity_estimation_(0.001),
+		position_standard_deviation_per_second_(0.1),
+		orientation_standard_deviation_per_second_(0.1),
+		position_standard_deviation_per_meter_(0.1),
+		orientation_standard_deviation_per_radian_(0.1) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <ConstantVelocityMotionPredictor-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+void ConstantVelocityMotionPredictor::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	MotionPredictor::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+	private_node_handle->param(configuration_namespace + "number_of_poses_for_velocity_estimation", number_of_poses_for_velocity_estimation_, 2);
+	number_of_poses_for_velocity_estimation_ = std::max(number_of_poses_for_velocity_estimation_, 2);
+	maximum_number_of_poses_in_history_ = std::max(maximum_number_of_poses_in_history_, (size_t)number_of_poses_for_velocity_estimation_);
+	private_node_handle->param(configuration_namespace + "minimum_time_between_poses_for_velocity_estimation", minimum_time_between_poses_for_velocity_estimation_, 0.001);
+	private_node_handle->param(configuration_namespace + "position_standard_deviation_per_second", position_standard_deviation_per_second_, 0.1);
+	private_node_handle->param(configuration_namespace + "orientation_standard_deviation_per_second", orientation_standard_deviation_per_second_, 0.1);
+	private_node_handle->param(configuration_namespace + "position_standard_deviation_per_meter", position_standard_deviation_per_meter_, 0.1);
+	private_node_handle->param(configuration_namespace + "orientation_standard_deviation_per_radian", orientation_standard_deviation_per_radian_, 0.1);
+}
+
+
+bool ConstantVelocityMotionPredictor::computePosePrediction(const ros::Time& time, tf2::Transform& predicted_pose_out, PoseCovariance& predicted_pose_covariance_out) {
+	tf2::Transform motion;
+	double linear_speed, angular_speed;
+	if (!computeConstantVelocityMotion(time, motion, linear_speed, angular_speed)) { return false; }
+
+	predicted_pose_out = poses_history_.back().second * motion;
+
+	double prediction_time = (time - poses_history_.back().first).toSec();
+	double position_standard_deviation = position_standard_deviation_per_second_ * prediction_time + position_standard_deviation_per_meter_ * linear_speed * prediction_time;
+	double orientation_standard_deviation = orientation_standard_deviation_per_second_ * prediction_time + orientation_standard_deviation_per_radian_ * angular_speed * prediction_time;
+	predicted_pose_covariance_out.setZero();
+	predicted_pose_covariance_out.diagonal() << position_standard_deviation * position_standard_deviation, position_standard_deviation * position_standard_deviation, position_standard_deviation * position_standard_deviation,
+			orientation_standard_deviation * orientation_standard_deviation, orientation_standard_deviation * orientation_standard_deviation, orientation_standard_deviation * orientation_standard_deviation;
+	return true;
+}
+
+
+bool ConstantVelocityMotionPredictor::computeConstantVelocityMotion(const ros::Time& time, tf2::Transform& motion_out, double& linear_speed_out, double& angular_speed_out) {
+	motion_out.setIdentity();
+	linear_speed_out = 0.0;
+	angular_speed_out = 0.0;
+	if (poses_history_.size() < 2) { return false; }
+
+	const PoseStamped& last_pose = poses_history_.back();
+	const PoseStamped& velocity_reference_pose = poses_history_[poses_history_.size() - std::min(poses_history_.size(), (size_t)number_of_poses_for_velocity_estimation_)];
+	double velocity_estimation_time = (last_pose.first - velocity_reference_pose.first).toSec();
+	if (velocity_estimation_time < minimum_time_between_poses_for_velocity_estimation_) { return false; }
+
+	tf2::Transform displacement = velocity_reference_pose.second.inverseTimes(last_pose.second);
+	tf2::Quaternion displacement_rotation = displacement.getRotation().normalize();
+	if (displacement_rotation.getW() < 0.0) { displacement_rotation = -displacement_rotation; } // shortest rotation
+	double displacement_angle = displacement_rotation.getAngle();
+
+	double prediction_scale = (time - last_pose.first).toSec() / velocity_estimation_time;
+	linear_speed_out = displacement.getOrigin().length() / velocity_estimation_time;
+	angular_speed_out = displacement_angle / velocity_estimation_time;
+
+	motion_out.setOrigin(displacement.getOrigin() * prediction_scale);
+	if (displacement_angle > 1e-9) {
+		motion_out.setRotation(tf2::Quaternion(displacement_rotation.getAxis(), displacement_angle * prediction_scale));
+	}
+
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </ConstantVelocityMotionPredictor-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,128 @@
+/**\file imu_motion_predictor.cpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/motion_predictors/imu_motion_predictor.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+ImuMotionPredictor::ImuMotionPredictor() :
+		imu_to_base_link_rotation_(tf2::Quaternion::getIdentity()),
+		imu_buffer_duration_(2.0),
+		imu_maximum_time_gap_(0.1),
+		angular_velocity_standard_deviation_(0.02) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <ImuMotionPredictor-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+void ImuMotionPredictor::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	ConstantVelocityMotionPredictor::setupConfigurationFromParameterServer(node_handle, private_node_handle, configuration_namespace);
+
+	double imu_to_base_link_roll, imu_to_base_link_pitch, imu_to_base_link_yaw;
+	private_node_handle->param(configuration_namespace + "imu_to_base_link_roll", imu_to_base_link_roll, 0.0);
+	private_node_handle->param(configuration_namespace + "imu_to_base_link_pitch", imu_to_base_link_pitch, 0.0);
+	private_node_handle->param(configuration_namespace + "imu_to_base_link_yaw", imu_to_base_link_yaw, 0.0);
+	imu_to_base_link_rotation_.setRPY(imu_to_base_link_roll, imu_to_base_link_pitch, imu_to_base_link_yaw);
+	private_node_handle->param(configuration_namespace + "imu_buffer_duration", imu_buffer_duration_, 2.0);
+	private_node_handle->param(configuration_namespace + "imu_maximum_time_gap", imu_maximum_time_gap_, 0.1);
+	private_node_handle->param(configuration_namespace + "angular_velocity_standard_deviation", angular_velocity_standard_deviation_, 0.02);
+
+	std::string imu_topic;
+	private_node_handle->param(configuration_namespace + "imu_topic", imu_topic, std::string("imu/data"));
+	{
+		std::lock_guard<std::mutex> lock(angular_velocities_mutex_);
+		angular_velocities_.clear();
+	}
+	imu_subscriber_.shutdown();
+	if (!imu_topic.empty()) {
+		imu_subscriber_ = node_handle->subscribe(imu_topic, 100, &ImuMotionPredictor::processImuMsg, this);
+	}
+}
+
+
+void ImuMotionPredictor::processImuMsg(const sensor_msgs::ImuConstPtr& imu_msg) {
+	tf2::Vector3 angular_velocity = tf2::quatRotate(imu_to_base_link_rotation_, tf2::Vector3(imu_msg->angular_velocity.x, imu_msg->angular_velocity.y, imu_msg->angular_velocity.z));
+
+	std::lock_guard<std::mutex> lock(angular_velocities_mutex_);
+	if (!angular_velocities_.empty() && imu_msg->header.stamp <= angular_velocities_.back().first) { return; }
+	angular_velocities_.push_back(AngularVelocityStamped(imu_msg->header.stamp, angular_velocity));
+	while (!angular_velocities_.empty() && (imu_msg->header.stamp - angular_velocities_.front().first).toSec() > imu_buffer_duration_) {
+		angular_velocities_.pop_front();
+	}
+}
+
+
+bool ImuMotionPredictor::computePosePrediction(const ros::Time& time, tf2::Transform& predicted_pose_out, PoseCovariance& predicted_pose_covariance_out) {
+	tf2::Transform motion;
+	double linear_speed, angular_speed;
+	bool constant_velocity_motion_available = computeConstantVelocityMotion(time, motion, linear_speed, angular_speed);
+
+	tf2::Quaternion imu_rotation;
+	bool imu_rotation_available = integrateAngularVelocity(poses_history_.back().first, time, imu_rotation);
+	if (!imu_rotation_available && !constant_velocity_motion_available) { return false; }
+
+	double prediction_time = (time - poses_history_.back().first).toSec();
+	double orientation_standard_deviation;
+	if (imu_rotation_available) {
+		motion.setRotation(imu_rotation);
+		orientation_standard_deviation = angular_velocity_standard_deviation_ * prediction_time;
+	} else {
+		ROS_DEBUG("Using the constant velocity model for the orientation prediction because the IMU measurements do not cover the prediction interval");
+		orientation_standard_deviation = orientation_standard_deviation_per_second_ * prediction_time + orientation_standard_deviation_per_radian_ * angular_speed * prediction_time;
+	}
+
+	predicted_pose_out = poses_history_.back().second * motion;
+
+	double position_standard_deviation = position_standard_deviation_per_second_ * prediction_time + position_standard_deviation_per_meter_ * linear_speed * prediction_time;
+	predicted_pose_covariance_out.setZero();
+	predicted_pose_covariance_out.diagonal() << position_standard_deviation * position_standard_deviation, position_standard_deviation * position_standard_deviation, position_standard_deviation * position_standard_deviation,
+			orientation_standard_deviation * orientation_standard_deviation, orientation_standard_deviation * orientation_standard_deviation, orientation_standard_deviation * orientation_standard_deviation;
+	return true;
+}
+
+
+bool ImuMotionPredictor::integrateAngularVelocity(const ros::Time& start_time, const ros::Time& end_time, tf2::Quaternion& rotation_out) {
+	rotation_out = tf2::Quaternion::getIdentity();
+
+	std::lock_guard<std::mutex> lock(angular_velocities_mutex_);
+	if (angular_velocities_.empty() ||
+			(angular_velocities_.front().first - start_time).toSec() > imu_maximum_time_gap_ ||
+			(end_time - angular_velocities_.back().first).toSec() > imu_maximum_time_gap_) {
+		return false;
+	}
+
+	for (size_t i = 0; i < angular_velocities_.size(); ++i) {
+		ros::Time sample_start_time = std::max(angular_velocities_[i].first, start_time);
+		ros::Time sample_end_time = (i + 1 < angular_velocities_.size() ? std::min(angular_velocities_[i + 1].first, end_time) : end_time);
+		if (i == 0 && angular_velocities_[i].first > start_time) { sample_start_time = start_time; }
+		double sample_duration = (sample_end_time - sample_start_time).toSec();
+		if (sample_duration <= 0.0) { continue; }
+
+		if ((sample_duration > imu_maximum_time_gap_) && (i + 1 < angular_velocities_.size())) { return false; }
+
+		const tf2::Vector3& angular_velocity = angular_velocities_[i].second;
+		double angular_speed = angular_velocity.length();
+		if (angular_speed > 1e-9) {
+			rotation_out *= tf2::Quaternion(angular_velocity / angular_speed, angular_speed * sample_duration);
+		}
+	}
+
+	rotation_out.normalize();
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </ImuMotionPredictor-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
@@ -0,0 +1,83 @@
+/**\file motion_predictor.cpp
+ * \brief Description...
+ *
+ * @version 1.0
+ * @author Carlos Miguel Correia da Costa
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+#include <dynamic_robot_localization/motion_predictors/motion_predictor.h>
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+namespace dynamic_robot_localization {
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <imports>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </imports>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// =============================================================================  <public-section>  ============================================================================
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <constructors-destructor>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+MotionPredictor::MotionPredictor() :
+		maximum_number_of_poses_in_history_(10),
+		maximum_prediction_time_(1.0),
+		maximum_position_standard_deviation_(-1.0),
+		maximum_orientation_standard_deviation_(-1.0) {}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </constructors-destructor>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <MotionPredictor-functions>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+void MotionPredictor::setupConfigurationFromParameterServer(ros::NodeHandlePtr& node_handle, ros::NodeHandlePtr& private_node_handle, std::string configuration_namespace) {
+	int maximum_number_of_poses_in_history;
+	private_node_handle->param(configuration_namespace + "maximum_number_of_poses_in_history", maximum_number_of_poses_in_history, 10);
+	maximum_number_of_poses_in_history_ = (size_t)std::max(maximum_number_of_poses_in_history, 2);
+	private_node_handle->param(configuration_namespace + "maximum_prediction_time", maximum_prediction_time_, 1.0);
+	private_node_handle->param(configuration_namespace + "maximum_position_standard_deviation", maximum_position_standard_deviation_, -1.0);
+	private_node_handle->param(configuration_namespace + "maximum_orientation_standard_deviation", maximum_orientation_standard_deviation_, -1.0);
+	reset();
+}
+
+
+void MotionPredictor::reset() {
+	poses_history_.clear();
+}
+
+
+void MotionPredictor::addPose(const tf2::Transform& pose, const ros::Time& time) {
+	if (!poses_history_.empty() && time <= poses_history_.back().first) {
+		if (time < poses_history_.back().first) { return; }
+		poses_history_.pop_back();
+	}
+
+	poses_history_.push_back(PoseStamped(time, pose));
+	while (poses_history_.size() > maximum_number_of_poses_in_history_) {
+		poses_history_.pop_front();
+	}
+}
+
+
+bool MotionPredictor::predictPose(const ros::Time& time, tf2::Transform& predicted_pose_out, PoseCovariance& predicted_pose_covariance_out) {
+	if (poses_history_.empty()) { return false; }
+
+	double prediction_time = (time - poses_history_.back().first).toSec();
+	if (prediction_time < 0.0 || (maximum_prediction_time_ > 0.0 && prediction_time > maximum_prediction_time_)) {
+		ROS_DEBUG_STREAM("Skipping motion prediction because the time offset to the last pose is " << prediction_time << " seconds (maximum_prediction_time: " << maximum_prediction_time_ << ")");
+		return false;
+	}
+
+	if (!computePosePrediction(time, predicted_pose_out, predicted_pose_covariance_out)) { return false; }
+
+	double position_standard_deviation = std::sqrt(predicted_pose_covariance_out.block<3, 3>(0, 0).trace());
+	double orientation_standard_deviation = std::sqrt(predicted_pose_covariance_out.block<3, 3>(3, 3).trace());
+	if ((maximum_position_standard_deviation_ > 0.0 && position_standard_deviation > maximum_position_standard_deviation_) ||
+			(maximum_orientation_standard_deviation_ > 0.0 && orientation_standard_deviation > maximum_orientation_standard_deviation_)) {
+		ROS_DEBUG_STREAM("Discarded motion prediction with position standard deviation " << position_standard_deviation << " and orientation standard deviation " << orientation_standard_deviation);
+		return false;
+	}
+
+	return true;
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </MotionPredictor-functions>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+// =============================================================================  </public-section>  ===========================================================================
+
+// =============================================================================   <protected-section>   =======================================================================
+// =============================================================================   </protected-section>  =======================================================================
+
+} /* namespace dynamic_robot_localization */
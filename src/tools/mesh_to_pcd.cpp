@@ -12,29 +12,233 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   <includes>   <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 // std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 // PCL includes
 #include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/PolygonMesh.h>
+#include <pcl/conversions.h>
 #include <pcl/io/pcd_io.h>
+#include <pcl/io/vtk_lib_io.h>
 #include <pcl/console/print.h>
 #include <pcl/console/parse.h>
 #include <pcl/console/time.h>
 
 // external libs includes
 #include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 
 // project includes
 #include <dynamic_robot_localization/common/pointcloud_conversions.h>
 #include <dynamic_robot_localization/common/performance_timer.h>
+#include <dynamic_robot_localization/common/voxel_coordinates.h>
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>   </includes>  <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
 void showUsage(char* program_name) {
 	pcl::console::print_info("Usage: %s [path/]input.[pcd|obj|ply|stl|vtk] [path/]output.pcd [-binary 0|1] [-compressed 0|1] [-type PointNormal|PointXYZRGBNormal|auto]\n", program_name);
+	pcl::console::print_info("       [-sampling_density points_per_square_meter] [-voxel_size meters] [-threads number] [-batch_size number_of_points] [-seed number]\n");
+	pcl::console::print_info("       If sampling_density > 0, the mesh surface is sampled uniformly (area weighted) and each point gets the normal of its triangle\n");
+	pcl::console::print_info("       If voxel_size > 0, only the first sampled point of each voxel is kept\n");
+	pcl::console::print_info("       With -binary 1 -compressed 0, the sampled points are written to the output file as each batch is processed\n");
+}
+
+
+struct MeshSamplingParameters {
+	double sampling_density;
+	double voxel_size;
+	int number_of_threads;
+	size_t batch_size;
+	std::uint64_t seed;
+};
+
+
+/// splitmix64 -> deterministic random numbers independent of the thread that samples each triangle
+inline std::uint64_t computeRandomNumber(std::uint64_t seed) {
+	std::uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+inline double computeRandomNumberInUnitInterval(std::uint64_t seed) {
+	return (computeRandomNumber(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+bool loadMeshTriangles(char* input, pcl::PointCloud<pcl::PointXYZ>& vertices, std::vector<Eigen::Vector3i>& triangles) {
+	pcl::PolygonMesh mesh;
+	if (pcl::io::loadPolygonFile(std::string(input), mesh) == 0) { return false; }
+	pcl::fromPCLPointCloud2(mesh.cloud, vertices);
+
+	triangles.clear();
+	triangles.reserve(mesh.polygons.size());
+	for (size_t i = 0; i < mesh.polygons.size(); ++i) {
+		const std::vector<pcl::index_t>& polygon_vertices = mesh.polygons[i].vertices;
+		for (size_t j = 2; j < polygon_vertices.size(); ++j) { // triangle fan for polygons with more than 3 vertices
+			triangles.push_back(Eigen::Vector3i(polygon_vertices[0], polygon_vertices[j - 1], polygon_vertices[j]));
+		}
+	}
+
+	return !triangles.empty();
 }
 
 
+void computeTrianglesNumberOfSamples(const pcl::PointCloud<pcl::PointXYZ>& vertices, const std::vector<Eigen::Vector3i>& triangles, const MeshSamplingParameters& parameters, std::vector<std::uint32_t>& triangles_number_of_samples) {
+	triangles_number_of_samples.resize(triangles.size());
+
+	#pragma omp parallel for schedule(static) num_threads(parameters.number_of_threads)
+	for (int i = 0; i < (int)triangles.size(); ++i) {
+		const Eigen::Vector3f a = vertices[triangles[i](0)].getVector3fMap();
+		const Eigen::Vector3f b = vertices[triangles[i](1)].getVector3fMap();
+		const Eigen::Vector3f c = vertices[triangles[i](2)].getVector3fMap();
+		double expected_number_of_samples = 0.5 * (b - a).cross(c - a).cast<double>().norm() * parameters.sampling_density;
+		if (!std::isfinite(expected_number_of_samples)) { expected_number_of_samples = 0.0; }
+		double number_of_samples = std::floor(expected_number_of_samples);
+		if (computeRandomNumberInUnitInterval(parameters.seed ^ computeRandomNumber((std::uint64_t)i)) < (expected_number_of_samples - number_of_samples)) {
+			number_of_samples += 1.0;
+		}
+		triangles_number_of_samples[i] = (std::uint32_t)number_of_samples;
+	}
+}
+
+
+void sampleTriangles(const pcl::PointCloud<pcl::PointXYZ>& vertices, const std::vector<Eigen::Vector3i>& triangles, const std::vector<std::uint32_t>& triangles_number_of_samples,
+		size_t first_triangle, size_t end_triangle, const MeshSamplingParameters& parameters, std::vector<size_t>& triangles_offsets, pcl::PointCloud<pcl::PointNormal>& pointcloud) {
+	triangles_offsets.resize(end_triangle - first_triangle + 1);
+	triangles_offsets[0] = 0;
+	for (size_t i = first_triangle; i < end_triangle; ++i) {
+		triangles_offsets[i - first_triangle + 1] = triangles_offsets[i - first_triangle] + triangles_number_of_samples[i];
+	}
+
+	pointcloud.resize(triangles_offsets.back());
+
+	#pragma omp parallel for schedule(dynamic, 1024) num_threads(parameters.number_of_threads)
+	for (int i = (int)first_triangle; i < (int)end_triangle; ++i) {
+		std::uint32_t number_of_samples = triangles_number_of_samples[i];
+		if (number_of_samples == 0) { continue; }
+
+		const Eigen::Vector3f a = vertices[triangles[i](0)].getVector3fMap();
+		const Eigen::Vector3f b = vertices[triangles[i](1)].getVector3fMap();
+		const Eigen::Vector3f c = vertices[triangles[i](2)].getVector3fMap();
+		Eigen::Vector3f normal = (b - a).cross(c - a);
+		normal.normalize();
+
+		size_t point_index = triangles_offsets[i - first_triangle];
+		std::uint64_t triangle_seed = computeRandomNumber(parameters.seed ^ computeRandomNumber((std::uint64_t)i + 0x5851F42D4C957F2Dull));
+		for (std::uint32_t j = 0; j < number_of_samples; ++j, ++point_index) {
+			float r1_sqrt = (float)std::sqrt(computeRandomNumberInUnitInterval(triangle_seed + 2 * j));
+			float r2 = (float)computeRandomNumberInUnitInterval(triangle_seed + 2 * j + 1);
+			pcl::PointNormal& point = pointcloud[point_index];
+			point.getVector3fMap() = (1.0f - r1_sqrt) * a + (r1_sqrt * (1.0f - r2)) * b + (r1_sqrt * r2) * c;
+			point.getNormalVector3fMap() = normal;
+			point.curvature = 0.0f;
+		}
+	}
+}
+
+
+class VoxelDeduplicator {
+	public:
+		VoxelDeduplicator(double voxel_size) : inverse_voxel_size_(voxel_size > 0.0 ? 1.0 / voxel_size : 0.0) {}
+
+		/// Removes the points that fall in voxels that already have a point (either from the same cloud or from previous calls)
+		void filter(pcl::PointCloud<pcl::PointNormal>& pointcloud) {
+			if (inverse_voxel_size_ <= 0.0) { return; }
+			size_t number_of_kept_points = 0;
+			for (size_t i = 0; i < pointcloud.size(); ++i) {
+				const pcl::PointNormal& point = pointcloud[i];
+				if (occupied_voxels_.insert(computeVoxelCoordinates(point)).second) {
+					pointcloud[number_of_kept_points++] = point;
+				}
+			}
+			pointcloud.resize(number_of_kept_points);
+		}
+
+	protected:
+		using VoxelCoordinates = dynamic_robot_localization::VoxelCoordinates;
+		using VoxelCoordinatesHash = dynamic_robot_localization::VoxelCoordinatesHash;
+
+		VoxelCoordinates computeVoxelCoordinates(const pcl::PointNormal& point) const {
+			VoxelCoordinates voxel_coordinates;
+			voxel_coordinates.x = (std::int64_t)std::floor(point.x * inverse_voxel_size_);
+			voxel_coordinates.y = (std::int64_t)std::floor(point.y * inverse_voxel_size_);
+			voxel_coordinates.z = (std::int64_t)std::floor(point.z * inverse_voxel_size_);
+			return voxel_coordinates;
+		}
+
+		double inverse_voxel_size_;
+		std::unordered_set<VoxelCoordinates, VoxelCoordinatesHash> occupied_voxels_;
+};
+
+
+/// Binary PCD writer that appends points as they are generated and fills in the number of points in the header when closed
+class StreamingPCDWriter {
+	public:
+		StreamingPCDWriter() : number_of_points_(0) {}
+
+		bool open(const std::string& filename) {
+			file_.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file_.is_open()) { return false; }
+			writeHeader();
+			return file_.good();
+		}
+
+		bool append(const pcl::PointCloud<pcl::PointNormal>& pointcloud) {
+			for (size_t i = 0; i < pointcloud.size(); ++i) {
+				const pcl::PointNormal& point = pointcloud[i];
+				const float point_data[7] = { point.x, point.y, point.z, point.normal_x, point.normal_y, point.normal_z, point.curvature };
+				file_.write(reinterpret_cast<const char*>(point_data), sizeof(point_data));
+			}
+			number_of_points_ += pointcloud.size();
+			return file_.good();
+		}
+
+		bool close() {
+			file_.seekp(0);
+			writeHeader();
+			bool status = file_.good();
+			file_.close();
+			return status;
+		}
+
+		size_t getNumberOfPoints() const { return number_of_points_; }
+
+	protected:
+		void writeHeader() {
+			// the number of points is zero padded for the header to have the same size when it is rewritten
+			char number_of_points[32];
+			std::snprintf(number_of_points, sizeof(number_of_points), "%020lu", (unsigned long)number_of_points_);
+			file_ << "# .PCD v0.7 - Point Cloud Data file format\n"
+					<< "VERSION 0.7\n"
+					<< "FIELDS x y z normal_x normal_y normal_z curvature\n"
+					<< "SIZE 4 4 4 4 4 4 4\n"
+					<< "TYPE F F F F F F F\n"
+					<< "COUNT 1 1 1 1 1 1 1\n"
+					<< "WIDTH " << number_of_points << "\n"
+					<< "HEIGHT 1\n"
+					<< "VIEWPOINT 0 0 0 1 0 0 0\n"
+					<< "POINTS " << number_of_points << "\n"
+					<< "DATA binary\n";
+		}
+
+		std::ofstream file_;
+		size_t number_of_points_;
+};
+
+
 template<typename PointT>
 bool savePointCloud(char* output, bool binary_output_format, bool binary_compressed_output_format, PointT& pointcloud) {
 	if (binary_compressed_output_format) {
@@ -78,6 +282,86 @@ int convertMesh(char* input, char* output, bool binary_output_format, bool binar
 }
 
 
+int sampleMesh(char* input, char* output, bool binary_output_format, bool binary_compressed_output_format, const MeshSamplingParameters& parameters) {
+	pcl::console::print_highlight("==> Loading mesh %s...\n", input);
+	dynamic_robot_localization::PerformanceTimer performance_timer;
+	performance_timer.start();
+
+	pcl::PointCloud<pcl::PointXYZ> vertices;
+	std::vector<Eigen::Vector3i> triangles;
+	if (!loadMeshTriangles(input, vertices, triangles)) {
+		pcl::console::print_error(" !> Failed to load mesh with triangles from file %s\n\n", input);
+		return (-1);
+	}
+	pcl::console::print_highlight(" +> Loaded %lu vertices and %lu triangles in %s\n\n", (unsigned long)vertices.size(), (unsigned long)triangles.size(), performance_timer.getElapsedTimeFormated().c_str());
+
+	pcl::console::print_highlight("==> Sampling mesh with %f points per square meter using %d threads...\n", parameters.sampling_density, parameters.number_of_threads);
+	performance_timer.restart();
+	std::vector<std::uint32_t> triangles_number_of_samples;
+	computeTrianglesNumberOfSamples(vertices, triangles, parameters, triangles_number_of_samples);
+
+	bool stream_output = binary_output_format && !binary_compressed_output_format;
+	StreamingPCDWriter streaming_pcd_writer;
+	if (stream_output && !streaming_pcd_writer.open(std::string(output))) {
+		pcl::console::print_error(" !> Failed to open file %s\n\n", output);
+		return (-1);
+	}
+
+	VoxelDeduplicator voxel_deduplicator(parameters.voxel_size);
+	pcl::PointCloud<pcl::PointNormal> pointcloud;
+	pcl::PointCloud<pcl::PointNormal> batch_pointcloud;
+	std::vector<size_t> triangles_offsets;
+	size_t number_of_sampled_points = 0;
+	size_t first_triangle = 0;
+	while (first_triangle < triangles.size()) {
+		size_t end_triangle = first_triangle;
+		size_t number_of_points_in_batch = 0;
+		while (end_triangle < triangles.size() && (number_of_points_in_batch < parameters.batch_size || end_triangle == first_triangle)) {
+			number_of_points_in_batch += triangles_number_of_samples[end_triangle++];
+		}
+
+		sampleTriangles(vertices, triangles, triangles_number_of_samples, first_triangle, end_triangle, parameters, triangles_offsets, batch_pointcloud);
+		number_of_sampled_points += batch_pointcloud.size();
+		voxel_deduplicator.filter(batch_pointcloud);
+
+		if (stream_output) {
+			if (!streaming_pcd_writer.append(batch_pointcloud)) {
+				pcl::console::print_error(" !> Failed to write to file %s\n\n", output);
+				return (-1);
+			}
+		} else {
+			pointcloud.insert(pointcloud.end(), batch_pointcloud.begin(), batch_pointcloud.end());
+		}
+
+		first_triangle = end_triangle;
+	}
+
+	if (stream_output) {
+		size_t number_of_saved_points = streaming_pcd_writer.getNumberOfPoints();
+		if (!streaming_pcd_writer.close()) {
+			pcl::console::print_error(" !> Failed to save to file %s\n\n", output);
+			return (-1);
+		}
+		pcl::console::print_highlight(" +> Sampled %lu points and saved %lu points in %s taking %s\n\n", (unsigned long)number_of_sampled_points, (unsigned long)number_of_saved_points, output, performance_timer.getElapsedTimeFormated().c_str());
+		return 0;
+	}
+
+	pcl::console::print_highlight(" +> Sampled %lu points and kept %lu points in %s\n", (unsigned long)number_of_sampled_points, (unsigned long)pointcloud.size(), performance_timer.getElapsedTimeFormated().c_str());
+	std::string save_type = (binary_output_format ? "binary" : "ascii");
+	if (binary_compressed_output_format) { save_type += " compressed"; }
+	pcl::console::print_highlight("==> Saving pointcloud to %s in %s format...\n", output, save_type.c_str());
+	performance_timer.restart();
+	if (savePointCloud(output, binary_output_format, binary_compressed_output_format, pointcloud)) {
+		pcl::console::print_highlight(" +> Saved %lu points in %s taking %s\n\n", (unsigned long)pointcloud.size(), output, performance_timer.getElapsedTimeFormated().c_str());
+	} else {
+		pcl::console::print_error(" !> Failed to save to file %s\n\n", output);
+		return (-1);
+	}
+
+	return 0;
+}
+
+
 // ###################################################################################   <main>   ##############################################################################
 int main(int argc, char** argv) {
 	pcl::console::print_info("###################################################################################\n");
@@ -97,6 +381,31 @@ int main(int argc, char** argv) {
 
 	std::string type("PointNormal");
 	pcl::console::parse_argument(argc, argv, "-type", type);
+
+	MeshSamplingParameters mesh_sampling_parameters;
+	mesh_sampling_parameters.sampling_density = 0.0;
+	pcl::console::parse_argument(argc, argv, "-sampling_density", mesh_sampling_parameters.sampling_density);
+	mesh_sampling_parameters.voxel_size = 0.0;
+	pcl::console::parse_argument(argc, argv, "-voxel_size", mesh_sampling_parameters.voxel_size);
+#ifdef _OPENMP
+	mesh_sampling_parameters.number_of_threads = omp_get_max_threads();
+#else
+	mesh_sampling_parameters.number_of_threads = 1;
+#endif
+	pcl::console::parse_argument(argc, argv, "-threads", mesh_sampling_parameters.number_of_threads);
+	if (mesh_sampling_parameters.number_of_threads < 1) { mesh_sampling_parameters.number_of_threads = 1; }
+	int batch_size = 10000000;
+	pcl::console::parse_argument(argc, argv, "-batch_size", batch_size);
+	mesh_sampling_parameters.batch_size = (size_t)std::max(batch_size, 1);
+	int seed = 0;
+	pcl::console::parse_argument(argc, argv, "-seed", seed);
+	mesh_sampling_parameters.seed = (std::uint64_t)seed;
+
+	if (mesh_sampling_parameters.sampling_density > 0.0) {
+		if (sampleMesh(argv[1], argv[2], binary_output_format, binary_compressed_output_format, mesh_sampling_parameters) != 0) { showUsage(argv[0]); return (-1); }
+		return 0;
+	}
+
 	/*if (type == "PointNormal") {
 		pcl::PointCloud<pcl::PointNormal> pointcloud;
 		if (convertMesh(argv[1], argv[2], binary_output_format, binary_compressed_output_format, pointcloud) != 0) { showUsage(argv[0]); return (-1); }